@@ -6,12 +6,52 @@
 
 using namespace duckdb;
 
-unique_ptr<ResponseWrapper> HTTPFileSystem::Request(FileHandle &handle, string url, string method, HeaderMap header_map,
-                                                    idx_t file_offset, char *buffer_out, idx_t buffer_len) {
-	auto headers = make_unique<httplib::Headers>();
-	for (auto &entry : header_map) {
-		headers->insert(entry);
+HTTPConnectionPool::HTTPConnectionPool() {
+}
+
+HTTPConnectionPool::~HTTPConnectionPool() {
+}
+
+unique_ptr<httplib::Client> HTTPConnectionPool::Acquire(const string &proto_host_port) {
+	{
+		lock_guard<mutex> guard(lock);
+		auto entry = idle_connections.find(proto_host_port);
+		if (entry != idle_connections.end() && !entry->second.empty()) {
+			auto client = move(entry->second.back());
+			entry->second.pop_back();
+			return client;
+		}
 	}
+	auto client = make_unique<httplib::Client>(proto_host_port.c_str());
+	client->set_follow_location(true);
+	client->set_keep_alive(true);
+	client->enable_server_certificate_verification(false);
+	return client;
+}
+
+void HTTPConnectionPool::Release(const string &proto_host_port, unique_ptr<httplib::Client> client) {
+	lock_guard<mutex> guard(lock);
+	auto &connections = idle_connections[proto_host_port];
+	if (connections.size() < MAXIMUM_IDLE_CONNECTIONS) {
+		connections.push_back(move(client));
+	}
+}
+
+HTTPFileSystem::HTTPFileSystem() : idle_request_threads(0), request_threads_done(false) {
+}
+
+HTTPFileSystem::~HTTPFileSystem() {
+	{
+		lock_guard<mutex> guard(request_lock);
+		request_threads_done = true;
+	}
+	request_cv.notify_all();
+	for (auto &request_thread : request_threads) {
+		request_thread->join();
+	}
+}
+
+static void ParseUrl(const string &url, string &proto_host_port, string &path) {
 	if (url.rfind("http://", 0) != 0 && url.rfind("https://", 0) != 0) {
 		throw std::runtime_error("URL needs to start with http:// or https://");
 	}
@@ -19,22 +59,31 @@ unique_ptr<ResponseWrapper> HTTPFileSystem::Request(FileHandle &handle, string u
 	if (slash_pos == std::string::npos) {
 		throw std::runtime_error("URL needs to contain a '/' after the host");
 	}
-	auto proto_host_port = url.substr(0, slash_pos);
+	proto_host_port = url.substr(0, slash_pos);
 
-	auto path = url.substr(slash_pos);
+	path = url.substr(slash_pos);
 	if (path.empty()) {
 		throw std::runtime_error("URL needs to contain a path");
 	}
+}
 
-	httplib::Client cli(proto_host_port.c_str());
-	cli.set_follow_location(true);
-	cli.enable_server_certificate_verification(false);
+unique_ptr<ResponseWrapper> HTTPFileSystem::Request(FileHandle &handle, string url, string method, HeaderMap header_map,
+                                                    idx_t file_offset, char *buffer_out, idx_t buffer_len) {
+	auto headers = make_unique<httplib::Headers>();
+	for (auto &entry : header_map) {
+		headers->insert(entry);
+	}
+	string proto_host_port, path;
+	ParseUrl(url, proto_host_port, path);
 
+	// the connection is only returned to the pool if the request succeeds: after an error it might be broken
+	auto cli = connection_pool.Acquire(proto_host_port);
 	if (method == "HEAD") {
-		auto res = cli.Head(path.c_str(), *headers);
+		auto res = cli->Head(path.c_str(), *headers);
 		if (res.error() != httplib::Error::Success) {
 			throw std::runtime_error("HTTP HEAD error on '" + url + "' " + std::to_string(res.error()));
 		}
+		connection_pool.Release(proto_host_port, move(cli));
 		return make_unique<ResponseWrapper>(res.value());
 	}
 	std::string range_expr =
@@ -45,7 +94,7 @@ unique_ptr<ResponseWrapper> HTTPFileSystem::Request(FileHandle &handle, string u
 	headers->insert(std::pair<std::string, std::string>("Range", range_expr));
 
 	idx_t out_offset = 0;
-	auto res = cli.Get(
+	auto res = cli->Get(
 	    path.c_str(), *headers,
 	    [&](const httplib::Response &response) {
 		    if (response.status >= 400) {
@@ -68,6 +117,35 @@ unique_ptr<ResponseWrapper> HTTPFileSystem::Request(FileHandle &handle, string u
 	if (res.error() != httplib::Error::Success) {
 		throw std::runtime_error("HTTP GET error on '" + url + "' " + std::to_string(res.error()));
 	}
+	connection_pool.Release(proto_host_port, move(cli));
+	return make_unique<ResponseWrapper>(res.value());
+}
+
+unique_ptr<ResponseWrapper> HTTPFileSystem::RequestWithBody(FileHandle &handle, string url, string method,
+                                                            HeaderMap header_map, const char *buffer_in,
+                                                            idx_t buffer_len) {
+	httplib::Headers headers;
+	for (auto &entry : header_map) {
+		headers.insert(entry);
+	}
+	string proto_host_port, path;
+	ParseUrl(url, proto_host_port, path);
+
+	auto cli = connection_pool.Acquire(proto_host_port);
+	httplib::Result res(nullptr, httplib::Error::Unknown);
+	if (method == "PUT") {
+		res = cli->Put(path.c_str(), headers, buffer_in, buffer_len, "application/octet-stream");
+	} else if (method == "POST") {
+		res = cli->Post(path.c_str(), headers, buffer_in, buffer_len, "application/octet-stream");
+	} else if (method == "DELETE") {
+		res = cli->Delete(path.c_str(), headers);
+	} else {
+		throw std::runtime_error("Unsupported HTTP method " + method);
+	}
+	if (res.error() != httplib::Error::Success) {
+		throw std::runtime_error("HTTP " + method + " error on '" + url + "' " + std::to_string(res.error()));
+	}
+	connection_pool.Release(proto_host_port, move(cli));
 	return make_unique<ResponseWrapper>(res.value());
 }
 
@@ -118,6 +196,12 @@ void HTTPFileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes, id
 			hfh.file_offset += buffer_read_len;
 		}
 
+		if (to_read >= hfh.BUFFER_LEN) {
+			// large reads bypass the buffer: their parts are requested concurrently
+			ReadRange(hfh, (char *)buffer + buffer_offset, to_read, hfh.file_offset);
+			hfh.file_offset += to_read;
+			break;
+		}
 		if (to_read > 0 && hfh.buffer_available == 0) {
 			auto new_buffer_available = MinValue<idx_t>(hfh.BUFFER_LEN, hfh.length - hfh.file_offset);
 			Request(hfh, hfh.path, "GET", {}, hfh.file_offset, (char *)hfh.buffer.get(), new_buffer_available);
@@ -129,6 +213,143 @@ void HTTPFileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes, id
 	}
 }
 
+namespace duckdb {
+
+//! A ranged GET request that is sent in the background. Whichever thread claims it first sends it: a request thread,
+//! or the thread that waits for it (so a waiting thread never has to wait for the request threads to be available).
+struct HTTPRequestJob {
+	HTTPRequestJob(HTTPFileSystem &fs, FileHandle &handle, char *buffer, idx_t nr_bytes, idx_t location)
+	    : fs(fs), handle(handle), buffer(buffer), nr_bytes(nr_bytes), location(location), claimed(false),
+	      finished(false) {
+	}
+
+	HTTPFileSystem &fs;
+	FileHandle &handle;
+	char *buffer;
+	idx_t nr_bytes;
+	idx_t location;
+
+	mutex lock;
+	std::condition_variable cv;
+	bool claimed;
+	bool finished;
+	string error;
+
+	//! Claims the request, returns false if another thread claimed it before
+	bool Claim() {
+		lock_guard<mutex> guard(lock);
+		if (claimed) {
+			return false;
+		}
+		claimed = true;
+		return true;
+	}
+	//! Sends the request after it was claimed
+	void Run() {
+		string run_error;
+		try {
+			fs.Request(handle, handle.path, "GET", {}, location, buffer, nr_bytes);
+		} catch (std::exception &ex) {
+			run_error = ex.what();
+		}
+		lock_guard<mutex> guard(lock);
+		error = run_error;
+		finished = true;
+		cv.notify_all();
+	}
+	//! Waits until a request that was claimed by another thread is finished
+	void WaitForFinish() {
+		unique_lock<mutex> guard(lock);
+		cv.wait(guard, [&]() { return finished; });
+	}
+};
+
+class HTTPAsyncRead : public AsyncRead {
+public:
+	explicit HTTPAsyncRead(shared_ptr<HTTPRequestJob> job) : job(move(job)) {
+	}
+	~HTTPAsyncRead() override {
+		// a request that nobody claimed yet is cancelled; the buffer must not be written after we return
+		if (!job->Claim()) {
+			job->WaitForFinish();
+		}
+	}
+
+	void Wait() override {
+		if (job->Claim()) {
+			job->Run();
+		} else {
+			job->WaitForFinish();
+		}
+		if (!job->error.empty()) {
+			throw std::runtime_error(job->error);
+		}
+	}
+
+private:
+	shared_ptr<HTTPRequestJob> job;
+};
+
+} // namespace duckdb
+
+unique_ptr<AsyncRead> HTTPFileSystem::ReadAsync(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
+	auto &hfh = (HTTPFileHandle &)handle;
+	if (location + nr_bytes > hfh.length) {
+		throw std::runtime_error("out of file");
+	}
+	auto job = make_shared<HTTPRequestJob>(*this, handle, (char *)buffer, nr_bytes, location);
+	ScheduleRequest(job);
+	return make_unique<HTTPAsyncRead>(move(job));
+}
+
+void HTTPFileSystem::ScheduleRequest(shared_ptr<HTTPRequestJob> job) {
+	{
+		lock_guard<mutex> guard(request_lock);
+		request_queue.push_back(move(job));
+		if (idle_request_threads == 0 && request_threads.size() < MAXIMUM_CONCURRENT_REQUESTS) {
+			request_threads.push_back(make_unique<thread>(&HTTPFileSystem::RunRequests, this));
+		}
+	}
+	request_cv.notify_one();
+}
+
+void HTTPFileSystem::RunRequests() {
+	while (true) {
+		shared_ptr<HTTPRequestJob> job;
+		{
+			unique_lock<mutex> guard(request_lock);
+			idle_request_threads++;
+			request_cv.wait(guard, [&]() { return !request_queue.empty() || request_threads_done; });
+			idle_request_threads--;
+			if (request_queue.empty()) {
+				return;
+			}
+			job = move(request_queue.front());
+			request_queue.pop_front();
+		}
+		// requests that were sent (or cancelled) by the waiting thread are skipped
+		if (job->Claim()) {
+			job->Run();
+		}
+	}
+}
+
+void HTTPFileSystem::ReadRange(FileHandle &handle, char *buffer_out, idx_t nr_bytes, idx_t location) {
+	auto part_count = (nr_bytes + CONCURRENT_REQUEST_SIZE - 1) / CONCURRENT_REQUEST_SIZE;
+	// the request threads send the other parts while we send the first one; each request uses its own pooled
+	// connection
+	vector<unique_ptr<AsyncRead>> parts;
+	for (idx_t part_idx = 1; part_idx < part_count; part_idx++) {
+		auto part_offset = part_idx * CONCURRENT_REQUEST_SIZE;
+		auto part_size = MinValue<idx_t>(CONCURRENT_REQUEST_SIZE, nr_bytes - part_offset);
+		parts.push_back(ReadAsync(handle, buffer_out + part_offset, part_size, location + part_offset));
+	}
+	Request(handle, handle.path, "GET", {}, location, buffer_out, MinValue<idx_t>(CONCURRENT_REQUEST_SIZE, nr_bytes));
+	for (auto &part : parts) {
+		part->Wait();
+	}
+}
+
 int64_t HTTPFileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes) {
 	auto &hfh = (HTTPFileHandle &)handle;
 	idx_t max_read = hfh.length - hfh.file_offset;
@@ -202,6 +423,7 @@ void HTTPFileHandle::IntializeMetadata() {
 ResponseWrapper::ResponseWrapper(httplib::Response &res) {
 	code = res.status;
 	error = res.body;
+	body = res.body;
 	for (auto &h : res.headers) {
 		headers[h.first] = h.second;
 	}
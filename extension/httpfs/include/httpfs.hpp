@@ -1,15 +1,23 @@
 #pragma once
 
 #include "duckdb/common/file_system.hpp"
+#include "duckdb/common/mutex.hpp"
 #include "duckdb/common/pair.hpp"
+#include "duckdb/common/thread.hpp"
 #include "duckdb/common/unordered_map.hpp"
 
+#include <condition_variable>
+#include <deque>
+
 namespace httplib {
 struct Response;
+class Client;
 }
 
 namespace duckdb {
 
+struct HTTPRequestJob;
+
 using HeaderMap = unordered_map<string, string>;
 
 struct ResponseWrapper { /* avoid including httplib in header */
@@ -17,9 +25,30 @@ public:
 	ResponseWrapper(httplib::Response &res);
 	int code;
 	string error;
+	string body;
 	HeaderMap headers;
 };
 
+//! Keeps the idle (keep-alive) connections to every host, so subsequent requests do not have to set up a new
+//! connection and TLS session. A connection is used by a single request at a time.
+class HTTPConnectionPool {
+public:
+	HTTPConnectionPool();
+	~HTTPConnectionPool();
+
+	//! Takes an idle connection to the host out of the pool, or opens a new one
+	unique_ptr<httplib::Client> Acquire(const string &proto_host_port);
+	//! Returns a connection after a successful request, so it can be reused
+	void Release(const string &proto_host_port, unique_ptr<httplib::Client> client);
+
+	//! The maximum amount of idle connections that are kept per host
+	constexpr static idx_t MAXIMUM_IDLE_CONNECTIONS = 16;
+
+private:
+	mutex lock;
+	unordered_map<string, vector<unique_ptr<httplib::Client>>> idle_connections;
+};
+
 class HTTPFileHandle : public FileHandle {
 public:
 	HTTPFileHandle(FileSystem &fs, std::string path);
@@ -46,6 +75,9 @@ public:
 
 class HTTPFileSystem : public FileSystem {
 public:
+	HTTPFileSystem();
+	~HTTPFileSystem() override;
+
 	std::unique_ptr<FileHandle> OpenFile(const string &path, uint8_t flags, FileLockType lock = FileLockType::NO_LOCK,
 	                                     FileCompressionType compression = FileCompressionType::UNCOMPRESSED) override;
 
@@ -59,7 +91,20 @@ public:
 	                                            HeaderMap header_map = {}, idx_t file_offset = 0,
 	                                            char *buffer_out = nullptr, idx_t buffer_len = 0);
 
+	//! Sends a request with a body (PUT or POST), or a DELETE request
+	virtual unique_ptr<ResponseWrapper> RequestWithBody(FileHandle &handle, string url, string method,
+	                                                    HeaderMap header_map, const char *buffer_in = nullptr,
+	                                                    idx_t buffer_len = 0);
+
 	int64_t Read(FileHandle &handle, void *buffer, int64_t nr_bytes) override;
+	//! The read is requested by one of the request threads, or by the waiting thread if no request thread got to it
+	unique_ptr<AsyncRead> ReadAsync(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) override;
+
+	//! Reads larger than the buffer of a handle are split into parts of this size that are requested concurrently
+	constexpr static idx_t CONCURRENT_REQUEST_SIZE = 1000000;
+	//! The maximum amount of request threads, which send the requests of the parts of large reads and of asynchronous
+	//! reads. They are shared by all reads of the file system.
+	constexpr static idx_t MAXIMUM_CONCURRENT_REQUESTS = 8;
 
 	// unsupported operations
 	void Write(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) override;
@@ -70,6 +115,9 @@ public:
 	int64_t GetFileSize(FileHandle &handle) override;
 
 	time_t GetLastModifiedTime(FileHandle &handle) override;
+	FileType GetFileType(FileHandle &handle) override {
+		return FileType::FILE_TYPE_REGULAR;
+	}
 
 	bool FileExists(const string &filename) override;
 
@@ -81,6 +129,27 @@ public:
 	bool OnDiskFile(FileHandle &handle) override {
 		return false;
 	}
+
+private:
+	//! Reads a range of the file directly into the output buffer, using concurrent requests for its parts
+	void ReadRange(FileHandle &handle, char *buffer_out, idx_t nr_bytes, idx_t location);
+	//! Hands a request to the request threads, starting a new thread if none is waiting for work
+	void ScheduleRequest(shared_ptr<HTTPRequestJob> job);
+	//! Sends queued requests until the file system is destroyed
+	void RunRequests();
+
+	HTTPConnectionPool connection_pool;
+
+	//! Lock protecting the request queue and the request threads
+	mutex request_lock;
+	std::condition_variable request_cv;
+	//! The requests that are waiting for a request thread
+	std::deque<shared_ptr<HTTPRequestJob>> request_queue;
+	vector<unique_ptr<thread>> request_threads;
+	//! The amount of request threads that are waiting for a request
+	idx_t idle_request_threads;
+	//! Whether or not the request threads should stop
+	bool request_threads_done;
 };
 
 } // namespace duckdb
@@ -1,14 +1,74 @@
 #pragma once
 
 #include "httpfs.hpp"
+#include "duckdb/common/thread.hpp"
 #include "duckdb/main/database.hpp"
 
+#include <condition_variable>
+#include <deque>
+#include <map>
+
 namespace duckdb {
 
+//! A part of a multipart upload: the buffer is filled by the writer and then uploaded by an upload thread
+struct S3WriteBuffer {
+	explicit S3WriteBuffer(idx_t capacity) : data(unique_ptr<data_t[]>(new data_t[capacity])), size(0), part_no(0) {
+	}
+	unique_ptr<data_t[]> data;
+	idx_t size;
+	//! The (1-based) part number of the part that is stored in the buffer
+	idx_t part_no;
+};
+
+//! A file on S3 that is written with a multipart upload: the parts are uploaded by the upload threads of the file
+//! system while the writer keeps producing. The amount of buffered parts is bounded: the writer waits for an upload
+//! to finish if all are in use.
+class S3WriteHandle : public FileHandle {
+public:
+	S3WriteHandle(FileSystem &fs, string path, idx_t part_size, idx_t max_uploads);
+	~S3WriteHandle() override;
+
+protected:
+	void Close() override {
+	}
+
+public:
+	//! The size of every part (except for the last one)
+	idx_t part_size;
+	//! The maximum amount of parts that are uploaded at the same time
+	idx_t max_uploads;
+	//! The total amount of bytes written to the file
+	idx_t total_written;
+	//! The upload id of the multipart upload, empty if it has not been started (yet)
+	string upload_id;
+	//! Whether or not the upload has been completed
+	bool finalized;
+
+	//! The part that is being filled by the writer
+	unique_ptr<S3WriteBuffer> current_part;
+	//! The part number of the next part
+	idx_t next_part_no;
+
+	mutex lock;
+	std::condition_variable cv;
+	//! The amount of parts that are queued for or being uploaded by an upload thread
+	idx_t pending_uploads;
+	//! The buffers that are not in use; together with the buffers in use there are at most max_uploads + 1
+	vector<unique_ptr<S3WriteBuffer>> free_buffers;
+	idx_t allocated_buffers;
+	//! The ETags of the uploaded parts, by part number
+	std::map<idx_t, string> etags;
+	//! The error of a failed upload
+	string upload_error;
+};
+
 class S3FileSystem : public HTTPFileSystem {
 public:
-	S3FileSystem(DatabaseInstance &instance_p) : database_instance(instance_p) {
+	S3FileSystem(DatabaseInstance &instance_p)
+	    : database_instance(instance_p), idle_upload_threads(0), upload_threads_done(false) {
 	}
+	~S3FileSystem() override;
+
 	std::unique_ptr<FileHandle> OpenFile(const string &path, uint8_t flags, FileLockType lock = FileLockType::NO_LOCK,
 	                                     FileCompressionType compression = FileCompressionType::UNCOMPRESSED) override;
 
@@ -17,16 +77,72 @@ public:
 	                                    idx_t buffer_len = 0) override;
 	static void Verify();
 
+	void Write(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) override;
+	int64_t Write(FileHandle &handle, void *buffer, int64_t nr_bytes) override;
+	//! Completes the multipart upload of a file that is written
+	void FileSync(FileHandle &handle) override;
+	int64_t GetFileSize(FileHandle &handle) override;
+
 	bool CanHandleFile(const string &fpath) override;
 	bool OnDiskFile(FileHandle &handle) override {
 		return false;
 	}
 
+	//! The default size of the parts of a multipart upload (setting s3_uploader_part_size)
+	constexpr static idx_t DEFAULT_PART_SIZE = 5 * 1024 * 1024;
+	//! The default amount of parts of a single file that are uploaded at the same time (setting
+	//! s3_uploader_max_uploads)
+	constexpr static idx_t DEFAULT_MAX_UPLOADS = 4;
+	//! The default amount of upload threads, shared by all files that are written (setting s3_uploader_thread_limit)
+	constexpr static idx_t DEFAULT_UPLOAD_THREADS = 8;
+	//! S3 rejects parts smaller than 5MB, except for the last part of an upload
+	constexpr static idx_t MINIMUM_PART_SIZE = 5 * 1024 * 1024;
+	//! The maximum amount of parts of a multipart upload
+	constexpr static idx_t MAXIMUM_PART_COUNT = 10000;
+
+	//! Aborts the multipart upload of a file that is not completed
+	void AbortUpload(S3WriteHandle &handle);
+	//! Removes the parts of the handle that are still queued from the upload queue
+	void CancelUploads(S3WriteHandle &handle);
+	//! Waits until all parts of the handle that were handed to the upload threads are uploaded (or have failed)
+	void WaitForUploads(S3WriteHandle &handle);
+
 public:
 	DatabaseInstance &database_instance;
 
 private:
-	HeaderMap CreateAuthHeaders(string host, string path, string method);
+	//! Translates an s3:// url into the host and path of the configured endpoint, and returns the http(s) url
+	string TranslateUrl(const string &url, string &host, string &path);
+	HeaderMap CreateAuthHeaders(const string &host, const string &path, const string &query, const string &method,
+	                            const string &payload_hash);
+	//! Sends a (signed) request for the S3 url, with the given query string and body
+	unique_ptr<ResponseWrapper> S3Request(FileHandle &handle, const string &url, const string &query,
+	                                      const string &method, const char *buffer_in, idx_t buffer_len);
+	//! Returns the setting of the database with the given name, or the default value if it is not set
+	Value GetSetting(const string &name, Value default_value);
+
+	//! Takes a buffer from the pool of the handle, waiting for an upload to finish if all buffers are in use
+	unique_ptr<S3WriteBuffer> GetBuffer(S3WriteHandle &handle);
+	//! Hands a filled part to the upload threads
+	void FlushPart(S3WriteHandle &handle);
+	//! Uploads queued parts (of any file) until the file system is destroyed
+	void UploadParts();
+	//! Uploads a single part of the handle
+	void UploadPart(S3WriteHandle &handle, unique_ptr<S3WriteBuffer> part);
+	//! Aborts the multipart upload after an upload failed, and throws the error
+	void FailUpload(S3WriteHandle &handle, const string &error);
+
+	//! Lock protecting the upload queue and the upload threads
+	mutex upload_lock;
+	std::condition_variable upload_cv;
+	//! The filled parts that are waiting for an upload thread, together with the handle they belong to
+	std::deque<pair<S3WriteHandle *, unique_ptr<S3WriteBuffer>>> upload_queue;
+	//! The upload threads, which are shared by all files that are written
+	vector<unique_ptr<thread>> upload_threads;
+	//! The amount of upload threads that are waiting for a part
+	idx_t idle_upload_threads;
+	//! Whether or not the upload threads should stop (once the queue is empty)
+	bool upload_threads_done;
 };
 
 } // namespace duckdb
@@ -333,15 +333,62 @@ idx_t ColumnReader::Read(uint64_t num_values, parquet_filter_t &filter, uint8_t
 	return num_values;
 }
 
+idx_t ColumnReader::SkipPages(idx_t num_values) {
+	D_ASSERT(page_rows_available == 0);
+	auto &trans = (ThriftFileTransport &)*protocol->getTransport();
+	trans.SetLocation(chunk_read_offset);
+
+	idx_t skipped = 0;
+	while (page_rows_available == 0 && group_rows_available > 0) {
+		auto page_offset = trans.GetLocation();
+		PageHeader page_hdr;
+		page_hdr.read(protocol);
+
+		idx_t page_rows = 0;
+		if (page_hdr.type == PageType::DATA_PAGE && page_hdr.__isset.data_page_header) {
+			page_rows = page_hdr.data_page_header.num_values;
+		} else if (page_hdr.type == PageType::DATA_PAGE_V2 && page_hdr.__isset.data_page_header_v2) {
+			page_rows = page_hdr.data_page_header_v2.num_values;
+		}
+		if (page_rows > 0 && page_rows <= num_values - skipped) {
+			// all rows of this page are skipped: we don't even have to read the page
+			trans.SetLocation(trans.GetLocation() + page_hdr.compressed_page_size);
+			skipped += page_rows;
+			group_rows_available -= page_rows;
+			continue;
+		}
+		// dictionary pages and pages that are only partially skipped are read as usual
+		trans.SetLocation(page_offset);
+		PrepareRead(none_filter);
+	}
+	chunk_read_offset = trans.GetLocation();
+	return skipped;
+}
+
 void ColumnReader::Skip(idx_t num_values) {
 	dummy_define.zero();
 	dummy_repeat.zero();
 
-	// TODO this can be optimized, for example we dont actually have to bitunpack offsets
-	auto values_read =
-	    Read(num_values, none_filter, (uint8_t *)dummy_define.ptr, (uint8_t *)dummy_repeat.ptr, dummy_result);
-	if (values_read != num_values) {
-		throw std::runtime_error("Row count mismatch when skipping rows");
+	while (num_values > 0) {
+		if (page_rows_available == 0 && !HasRepeats()) {
+			// without repeats the value count of a page is its row count, so entire pages can be skipped
+			num_values -= SkipPages(num_values);
+			if (num_values == 0) {
+				break;
+			}
+		}
+		// TODO this can be optimized, for example we dont actually have to bitunpack offsets
+		auto skip_now = MinValue<idx_t>(num_values, STANDARD_VECTOR_SIZE);
+		if (page_rows_available > 0 && !HasRepeats()) {
+			// stop at the end of the page, so the next pages can be skipped entirely
+			skip_now = MinValue<idx_t>(skip_now, page_rows_available);
+		}
+		auto values_read =
+		    Read(skip_now, none_filter, (uint8_t *)dummy_define.ptr, (uint8_t *)dummy_repeat.ptr, dummy_result);
+		if (values_read != skip_now) {
+			throw std::runtime_error("Row count mismatch when skipping rows");
+		}
+		num_values -= skip_now;
 	}
 }
 
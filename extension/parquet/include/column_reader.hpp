@@ -68,9 +68,16 @@ public:
 	}
 	virtual ~ColumnReader();
 
+	//! Registers the byte range of the column chunk of the current group that will be read
+	virtual void RegisterPrefetch(ThriftFileTransport &transport) {
+		D_ASSERT(chunk);
+		transport.RegisterPrefetch(chunk_read_offset, chunk->meta_data.total_compressed_size);
+	}
+
 	virtual idx_t Read(uint64_t num_values, parquet_filter_t &filter, uint8_t *define_out, uint8_t *repeat_out,
 	                   Vector &result_out);
 
+	//! Skips the next rows, pages that only contain skipped rows are not read at all
 	virtual void Skip(idx_t num_values);
 
 	const LogicalType &Type() {
@@ -81,6 +88,10 @@ public:
 		return schema;
 	}
 
+	idx_t FileIdx() {
+		return file_idx;
+	}
+
 	virtual idx_t GroupRowsAvailable() {
 		return group_rows_available;
 	}
@@ -137,6 +148,8 @@ private:
 	void PrepareRead(parquet_filter_t &filter);
 	void PreparePage(idx_t compressed_page_size, idx_t uncompressed_page_size);
 	void PrepareDataPage(PageHeader &page_hdr);
+	//! Skips the pages that only contain rows that are skipped, stops at the first page that has to be read
+	idx_t SkipPages(idx_t num_values);
 
 	const duckdb_parquet::format::ColumnChunk *chunk;
 
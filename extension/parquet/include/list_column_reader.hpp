@@ -29,6 +29,10 @@ public:
 		child_column_reader->IntializeRead(columns, protocol_p);
 	}
 
+	void RegisterPrefetch(ThriftFileTransport &transport) override {
+		child_column_reader->RegisterPrefetch(transport);
+	}
+
 	idx_t GroupRowsAvailable() override {
 		return child_column_reader->GroupRowsAvailable();
 	}
@@ -12,6 +12,7 @@
 #ifndef DUCKDB_AMALGAMATION
 #include "duckdb/common/common.hpp"
 #include "duckdb/common/exception.hpp"
+#include "duckdb/common/limits.hpp"
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/common/types/data_chunk.hpp"
 #endif
@@ -49,6 +50,13 @@ struct ParquetReaderScanState {
 	bool finished;
 	TableFilterSet *filters;
 	SelectionVector sel;
+	//! Only the rows [row_start, row_end) of the groups are read, so a single group can be scanned by multiple threads
+	idx_t row_start;
+	idx_t row_end;
+	//! The (sorted, disjoint) row ranges of the current group that are skipped
+	vector<pair<idx_t, idx_t>> pruned_rows;
+	//! The index of the first pruned row range that has not been passed yet
+	idx_t pruned_rows_idx;
 
 	ResizeableBuffer define_buf;
 	ResizeableBuffer repeat_buf;
@@ -77,11 +85,17 @@ public:
 
 public:
 	void InitializeScan(ParquetReaderScanState &state, vector<column_t> column_ids, vector<idx_t> groups_to_read,
-	                    TableFilterSet *table_filters);
+	                    TableFilterSet *table_filters, idx_t row_start = 0,
+	                    idx_t row_end = NumericLimits<idx_t>::Maximum());
 	void Scan(ParquetReaderScanState &state, DataChunk &output);
 
 	idx_t NumRows();
 	idx_t NumRowGroups();
+	//! Whether or not rows of the given columns can be skipped, i.e. whether a group can be split in row ranges
+	bool CanSkipRows(const vector<column_t> &column_ids);
+	//! Returns the (sorted) rows of the group at which all of the given columns start a new page, according to their
+	//! offset index. The list is empty if any of the columns has no offset index, or only a single page.
+	vector<idx_t> GetPageBoundaries(idx_t group_idx, const vector<column_t> &column_ids);
 
 	const duckdb_parquet::format::FileMetaData *GetFileMetadata();
 
@@ -94,6 +108,11 @@ private:
 
 	const duckdb_parquet::format::RowGroup &GetGroup(ParquetReaderScanState &state);
 	void PrepareRowGroupBuffer(ParquetReaderScanState &state, idx_t out_col_idx);
+	//! The end of the rows that are read from the current group
+	idx_t GroupRowEnd(ParquetReaderScanState &state);
+	//! Finds the rows of the current group that are skipped: the rows before the start of the scanned row range, and
+	//! the pages that cannot match the filters according to the column index of the filter columns
+	void PrunePages(ParquetReaderScanState &state);
 
 	template <typename... Args>
 	std::runtime_error FormatException(const string fmt_str, Args... params) {
@@ -15,5 +15,8 @@ struct LogicalType;
 
 unique_ptr<BaseStatistics> ParquetTransformColumnStatistics(const SchemaElement &s_ele, const LogicalType &type,
                                                             const ColumnChunk &column_chunk);
+//! Transforms the statistics of a column chunk or (from the column index) of a single page
+unique_ptr<BaseStatistics> ParquetTransformStatistics(const SchemaElement &s_ele, const LogicalType &type,
+                                                      const duckdb_parquet::format::Statistics &parquet_stats);
 
 } // namespace duckdb
@@ -14,6 +14,7 @@
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/mutex.hpp"
 #include "duckdb/common/serializer/buffered_file_writer.hpp"
+#include "duckdb/common/serializer/buffered_serializer.hpp"
 #include "duckdb/common/types/chunk_collection.hpp"
 #endif
 
@@ -23,13 +24,27 @@
 namespace duckdb {
 class FileSystem;
 
+//! A row group that has been serialized and compressed in memory, but has not been written to the file yet
+struct PreparedRowGroup {
+	//! The meta data of the row group, the offsets are relative to the start of the data
+	duckdb_parquet::format::RowGroup row_group;
+	//! The pages of all columns of the row group
+	BufferedSerializer data;
+	//! The page statistics and page locations of every column
+	vector<duckdb_parquet::format::ColumnIndex> column_indexes;
+	vector<duckdb_parquet::format::OffsetIndex> offset_indexes;
+};
+
 class ParquetWriter {
 public:
 	ParquetWriter(FileSystem &fs, string file_name, vector<LogicalType> types, vector<string> names,
 	              duckdb_parquet::format::CompressionCodec::type codec);
 
 public:
-	void Flush(ChunkCollection &buffer);
+	//! Serializes and compresses the buffered rows into a row group. Can be called concurrently from multiple threads.
+	void PrepareRowGroup(ChunkCollection &buffer, PreparedRowGroup &result);
+	//! Appends a prepared row group to the file
+	void FlushRowGroup(PreparedRowGroup &row_group);
 	void Finalize();
 
 private:
@@ -41,6 +56,9 @@ private:
 	unique_ptr<BufferedFileWriter> writer;
 	shared_ptr<duckdb_apache::thrift::protocol::TProtocol> protocol;
 	duckdb_parquet::format::FileMetaData file_meta_data;
+	//! The page index of the written row groups, written to the file in Finalize
+	vector<vector<duckdb_parquet::format::ColumnIndex>> column_indexes;
+	vector<vector<duckdb_parquet::format::OffsetIndex>> offset_indexes;
 	std::mutex lock;
 };
 
@@ -33,6 +33,12 @@ public:
 		}
 	}
 
+	void RegisterPrefetch(ThriftFileTransport &transport) override {
+		for (auto &child : child_readers) {
+			child->RegisterPrefetch(transport);
+		}
+	}
+
 	idx_t Read(uint64_t num_values, parquet_filter_t &filter, uint8_t *define_out, uint8_t *repeat_out,
 	           Vector &result) override {
 		auto &type = Type();
@@ -8,19 +8,94 @@
 #include "duckdb/common/file_system.hpp"
 #endif
 
+#include <algorithm>
+
 namespace duckdb {
 
+//! A range of the file that is read ahead of time
+struct ReadHead {
+	ReadHead(idx_t location, idx_t size) : location(location), size(size) {
+	}
+	idx_t location;
+	idx_t size;
+	unique_ptr<data_t[]> data;
+	//! The read of the range, until it has been waited on; destroyed before the data it reads into
+	unique_ptr<AsyncRead> read;
+
+	//! Waits for the range to be read, the first time its data is accessed
+	void WaitForData() {
+		if (read) {
+			read->Wait();
+			read.reset();
+		}
+	}
+
+	idx_t GetEnd() const {
+		return location + size;
+	}
+	bool operator<(const ReadHead &other) const {
+		return location < other.location;
+	}
+};
+
 class ThriftFileTransport : public duckdb_apache::thrift::transport::TVirtualTransport<ThriftFileTransport> {
 public:
+	//! Prefetched ranges that are less than this amount of bytes apart are read with a single request
+	static constexpr idx_t PREFETCH_MERGE_DISTANCE = 1 << 20;
+
 	ThriftFileTransport(FileHandle &handle_p) : handle(handle_p), location(0) {
 	}
 
 	uint32_t read(uint8_t *buf, uint32_t len) {
+		for (auto &read_head : read_heads) {
+			if (location >= read_head.location && location + len <= read_head.GetEnd()) {
+				read_head.WaitForData();
+				memcpy(buf, read_head.data.get() + (location - read_head.location), len);
+				location += len;
+				return len;
+			}
+		}
 		handle.Read(buf, len, location);
 		location += len;
 		return len;
 	}
 
+	//! Registers a range of the file that will be read soon
+	void RegisterPrefetch(idx_t pos, idx_t len) {
+		read_heads.emplace_back(pos, len);
+	}
+
+	//! Issues the reads of all registered ranges ahead of time, a read is waited on when its range is first accessed.
+	//! Ranges that are close together are merged, so a file system for which every request is expensive (e.g. a remote
+	//! file system) needs few (and large) requests.
+	void FinalizeRegistration() {
+		if (read_heads.empty()) {
+			return;
+		}
+		std::sort(read_heads.begin(), read_heads.end());
+		idx_t result_idx = 0;
+		for (idx_t head_idx = 1; head_idx < read_heads.size(); head_idx++) {
+			auto &current = read_heads[result_idx];
+			auto &next = read_heads[head_idx];
+			if (next.location <= current.GetEnd() + PREFETCH_MERGE_DISTANCE) {
+				current.size = MaxValue<idx_t>(current.GetEnd(), next.GetEnd()) - current.location;
+			} else {
+				read_heads[++result_idx] = move(next);
+			}
+		}
+		read_heads.erase(read_heads.begin() + result_idx + 1, read_heads.end());
+		for (auto &read_head : read_heads) {
+			read_head.data = unique_ptr<data_t[]>(new data_t[read_head.size]);
+			read_head.read =
+			    handle.file_system.ReadAsync(handle, read_head.data.get(), read_head.size, read_head.location);
+		}
+	}
+
+	//! Drops the ranges that were read ahead of time
+	void ClearPrefetch() {
+		read_heads.clear();
+	}
+
 	void SetLocation(idx_t location_p) {
 		location = location_p;
 	}
@@ -35,6 +110,8 @@ public:
 private:
 	duckdb::FileHandle &handle;
 	duckdb::idx_t location;
+	//! The ranges that have been read ahead of time
+	vector<ReadHead> read_heads;
 };
 
 } // namespace duckdb
@@ -2,6 +2,7 @@
 #include <vector>
 #include <fstream>
 #include <iostream>
+#include <algorithm>
 
 #include "parquet-extension.hpp"
 #include "parquet_reader.hpp"
@@ -16,6 +17,7 @@
 #include "duckdb/function/table_function.hpp"
 #include "duckdb/common/file_system.hpp"
 #include "duckdb/parallel/parallel_state.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 #include "duckdb/parser/parsed_data/create_copy_function_info.hpp"
 #include "duckdb/parser/parsed_data/create_table_function_info.hpp"
 
@@ -47,32 +49,55 @@ struct ParquetReadOperatorData : public FunctionOperatorData {
 	idx_t file_index;
 	vector<column_t> column_ids;
 	TableFilterSet *table_filters;
+	//! The batch index of the row group that is currently scanned (parallel scans only)
+	idx_t batch_index;
 };
 
+//! Row groups are not split into parts smaller than this amount of rows
+static constexpr idx_t MINIMUM_MORSEL_ROW_COUNT = 16 * STANDARD_VECTOR_SIZE;
+//! The amount of parts every thread gets (on average) when the files are split by size
+static constexpr idx_t MORSELS_PER_THREAD = 4;
+
 struct ParquetReadParallelState : public ParallelState {
 	mutex lock;
 	shared_ptr<ParquetReader> current_reader;
 	idx_t file_index;
+	//! The index of the next row group of the current file
 	idx_t row_group_index;
+	//! The row group that is currently handed out in parts
+	idx_t current_group;
+	//! The next part of the current row group that is handed out
+	idx_t morsel_index;
+	//! The first row of every part of the current row group, followed by the row count of the group. Parts start at
+	//! page boundaries, so no thread decodes rows of a page that another thread reads.
+	vector<idx_t> morsel_bounds;
+	//! The (compressed) size in bytes a part should have, so all threads get about the same amount of data
+	idx_t morsel_size;
+	//! The batch index of the next part that is handed out
+	idx_t batch_index;
 };
 
 class ParquetScanFunction {
 public:
 	static TableFunctionSet GetFunctionSet() {
 		TableFunctionSet set("parquet_scan");
-		set.AddFunction(TableFunction({LogicalType::VARCHAR}, ParquetScanImplementation, ParquetScanBind,
-		                              ParquetScanInit, /* statistics */ ParquetScanStats, /* cleanup */ nullptr,
-		                              /* dependency */ nullptr, ParquetCardinality,
-		                              /* pushdown_complex_filter */ nullptr, /* to_string */ nullptr,
-		                              ParquetScanMaxThreads, ParquetInitParallelState, ParquetScanFuncParallel,
-		                              ParquetScanParallelInit, ParquetParallelStateNext, true, true, ParquetProgress));
-		set.AddFunction(TableFunction({LogicalType::LIST(LogicalType::VARCHAR)}, ParquetScanImplementation,
-		                              ParquetScanBindList, ParquetScanInit, /* statistics */ ParquetScanStats,
-		                              /* cleanup */ nullptr,
-		                              /* dependency */ nullptr, ParquetCardinality,
-		                              /* pushdown_complex_filter */ nullptr, /* to_string */ nullptr,
-		                              ParquetScanMaxThreads, ParquetInitParallelState, ParquetScanFuncParallel,
-		                              ParquetScanParallelInit, ParquetParallelStateNext, true, true, ParquetProgress));
+		TableFunction scan({LogicalType::VARCHAR}, ParquetScanImplementation, ParquetScanBind, ParquetScanInit,
+		                   /* statistics */ ParquetScanStats, /* cleanup */ nullptr,
+		                   /* dependency */ nullptr, ParquetCardinality,
+		                   /* pushdown_complex_filter */ nullptr, /* to_string */ nullptr, ParquetScanMaxThreads,
+		                   ParquetInitParallelState, ParquetScanFuncParallel, ParquetScanParallelInit,
+		                   ParquetParallelStateNext, true, true, ParquetProgress);
+		scan.get_batch_index = ParquetScanGetBatchIndex;
+		set.AddFunction(scan);
+		TableFunction scan_list({LogicalType::LIST(LogicalType::VARCHAR)}, ParquetScanImplementation,
+		                        ParquetScanBindList, ParquetScanInit, /* statistics */ ParquetScanStats,
+		                        /* cleanup */ nullptr,
+		                        /* dependency */ nullptr, ParquetCardinality,
+		                        /* pushdown_complex_filter */ nullptr, /* to_string */ nullptr, ParquetScanMaxThreads,
+		                        ParquetInitParallelState, ParquetScanFuncParallel, ParquetScanParallelInit,
+		                        ParquetParallelStateNext, true, true, ParquetProgress);
+		scan_list.get_batch_index = ParquetScanGetBatchIndex;
+		set.AddFunction(scan_list);
 		return set;
 	}
 
@@ -213,6 +238,7 @@ public:
 
 		result->is_parallel = false;
 		result->file_index = 0;
+		result->batch_index = 0;
 		result->table_filters = filters->table_filters;
 		// single-threaded: one thread has to read all groups
 		vector<idx_t> group_ids;
@@ -289,7 +315,9 @@ public:
 
 	static idx_t ParquetScanMaxThreads(ClientContext &context, const FunctionData *bind_data) {
 		auto &data = (ParquetReadBindData &)*bind_data;
-		return data.initial_reader->NumRowGroups() * data.files.size();
+		// row groups can be split into multiple parts
+		auto max_parts = data.initial_reader->NumRows() / MINIMUM_MORSEL_ROW_COUNT;
+		return MaxValue<idx_t>(data.initial_reader->NumRowGroups(), max_parts) * data.files.size();
 	}
 
 	static unique_ptr<ParallelState> ParquetInitParallelState(ClientContext &context, const FunctionData *bind_data_p) {
@@ -297,10 +325,97 @@ public:
 		auto result = make_unique<ParquetReadParallelState>();
 		result->current_reader = bind_data.initial_reader;
 		result->row_group_index = 0;
+		result->current_group = 0;
+		result->morsel_index = 0;
 		result->file_index = 0;
+		result->batch_index = 0;
+
+		// the files are split into parts by size rather than by row group, so every thread gets about the same
+		// amount of data, also if there are only a few (large) row groups or files
+		auto threads = TaskScheduler::GetScheduler(context).NumberOfThreads();
+		result->morsel_size = NumericLimits<idx_t>::Maximum();
+		if (threads > 1 && bind_data.files.size() < threads * MORSELS_PER_THREAD) {
+			auto &fs = FileSystem::GetFileSystem(context);
+			idx_t total_size = 0;
+			bool remote_files = false;
+			for (auto &file : bind_data.files) {
+				auto handle = fs.OpenFile(file, FileFlags::FILE_FLAGS_READ);
+				if (!handle->OnDiskFile()) {
+					// the groups of remote files are read all at once: their parts would be requested repeatedly
+					remote_files = true;
+					break;
+				}
+				total_size += fs.GetFileSize(*handle);
+			}
+			if (!remote_files) {
+				result->morsel_size = MaxValue<idx_t>(total_size / (threads * MORSELS_PER_THREAD), 1);
+			}
+		}
 		return move(result);
 	}
 
+	//! Moves the parallel state to the next row group, and decides in how many parts it is split
+	static bool ParquetNextRowGroup(ClientContext &context, const ParquetReadBindData &bind_data,
+	                                ParquetReadParallelState &parallel_state, const vector<column_t> &column_ids) {
+		while (parallel_state.row_group_index >= parallel_state.current_reader->NumRowGroups()) {
+			// no groups remain in the current parquet file: check if there are more files to read
+			if (parallel_state.file_index + 1 >= bind_data.files.size()) {
+				return false;
+			}
+			// read the next file
+			string file = bind_data.files[++parallel_state.file_index];
+			parallel_state.current_reader =
+			    make_shared<ParquetReader>(context, file, parallel_state.current_reader->return_types);
+			parallel_state.row_group_index = 0;
+		}
+		parallel_state.current_group = parallel_state.row_group_index++;
+		auto &reader = *parallel_state.current_reader;
+		auto &group = reader.GetFileMetadata()->row_groups[parallel_state.current_group];
+		idx_t group_rows = group.num_rows;
+		parallel_state.morsel_index = 0;
+		parallel_state.morsel_bounds = {0, group_rows};
+		if (!reader.CanSkipRows(column_ids)) {
+			// nested columns cannot skip rows: the group is read by a single thread
+			return true;
+		}
+		idx_t group_size = 0;
+		for (auto &column : group.columns) {
+			group_size += column.meta_data.total_compressed_size;
+		}
+		auto morsel_count = MinValue<idx_t>(group_size / parallel_state.morsel_size + 1,
+		                                    group_rows / MINIMUM_MORSEL_ROW_COUNT);
+		if (morsel_count <= 1) {
+			return true;
+		}
+		// a part that starts in the middle of a page would have to decode the rows of the page that precede it: the
+		// group is only split at the page boundaries that all scanned columns have in common
+		auto page_boundaries = reader.GetPageBoundaries(parallel_state.current_group, column_ids);
+		if (page_boundaries.empty()) {
+			return true;
+		}
+		// pick the boundaries that are closest to an even split of the rows
+		parallel_state.morsel_bounds.pop_back();
+		for (idx_t morsel_idx = 1; morsel_idx < morsel_count; morsel_idx++) {
+			auto target = group_rows * morsel_idx / morsel_count;
+			auto entry = std::lower_bound(page_boundaries.begin(), page_boundaries.end(), target);
+			if (entry == page_boundaries.end() ||
+			    (entry != page_boundaries.begin() && target - *(entry - 1) < *entry - target)) {
+				entry--;
+			}
+			if (*entry > parallel_state.morsel_bounds.back()) {
+				parallel_state.morsel_bounds.push_back(*entry);
+			}
+		}
+		parallel_state.morsel_bounds.push_back(group_rows);
+		return true;
+	}
+
+	static idx_t ParquetScanGetBatchIndex(ClientContext &context, const FunctionData *bind_data_p,
+	                                      FunctionOperatorData *operator_state, ParallelState *parallel_state_p) {
+		auto &data = (ParquetReadOperatorData &)*operator_state;
+		return data.batch_index;
+	}
+
 	static bool ParquetParallelStateNext(ClientContext &context, const FunctionData *bind_data_p,
 	                                     FunctionOperatorData *state_p, ParallelState *parallel_state_p) {
 		auto &bind_data = (ParquetReadBindData &)*bind_data_p;
@@ -308,35 +423,23 @@ public:
 		auto &scan_data = (ParquetReadOperatorData &)*state_p;
 
 		lock_guard<mutex> parallel_lock(parallel_state.lock);
-		if (parallel_state.row_group_index < parallel_state.current_reader->NumRowGroups()) {
-			// groups remain in the current parquet file: read the next group
-			scan_data.reader = parallel_state.current_reader;
-			vector<idx_t> group_indexes {parallel_state.row_group_index};
-			scan_data.reader->InitializeScan(scan_data.scan_state, scan_data.column_ids, group_indexes,
-			                                 scan_data.table_filters);
-			parallel_state.row_group_index++;
-			return true;
-		} else {
-			// no groups remain in the current parquet file: check if there are more files to read
-			while (parallel_state.file_index + 1 < bind_data.files.size()) {
-				// read the next file
-				string file = bind_data.files[++parallel_state.file_index];
-				parallel_state.current_reader =
-				    make_shared<ParquetReader>(context, file, parallel_state.current_reader->return_types);
-				if (parallel_state.current_reader->NumRowGroups() == 0) {
-					// empty parquet file, move to next file
-					continue;
-				}
-				// set up the scan state to read the first group
-				scan_data.reader = parallel_state.current_reader;
-				vector<idx_t> group_indexes {0};
-				scan_data.reader->InitializeScan(scan_data.scan_state, scan_data.column_ids, group_indexes,
-				                                 scan_data.table_filters);
-				parallel_state.row_group_index = 1;
-				return true;
+		if (parallel_state.morsel_index + 1 >= parallel_state.morsel_bounds.size()) {
+			// the current group has been handed out entirely: move to the next group
+			if (!ParquetNextRowGroup(context, bind_data, parallel_state, scan_data.column_ids)) {
+				return false;
 			}
 		}
-		return false;
+		// hand out the next part of the current group
+		auto row_start = parallel_state.morsel_bounds[parallel_state.morsel_index];
+		auto row_end = parallel_state.morsel_bounds[parallel_state.morsel_index + 1];
+		parallel_state.morsel_index++;
+
+		scan_data.reader = parallel_state.current_reader;
+		vector<idx_t> group_indexes {parallel_state.current_group};
+		scan_data.reader->InitializeScan(scan_data.scan_state, scan_data.column_ids, group_indexes,
+		                                 scan_data.table_filters, row_start, row_end);
+		scan_data.batch_index = parallel_state.batch_index++;
+		return true;
 	}
 };
 
@@ -351,12 +454,8 @@ struct ParquetWriteGlobalState : public GlobalFunctionData {
 	unique_ptr<ParquetWriter> writer;
 };
 
-struct ParquetWriteLocalState : public LocalFunctionData {
-	ParquetWriteLocalState() {
-		buffer = make_unique<ChunkCollection>();
-	}
-
-	unique_ptr<ChunkCollection> buffer;
+struct ParquetWritePreparedBatch : public PreparedBatchData {
+	PreparedRowGroup prepared;
 };
 
 unique_ptr<FunctionData> ParquetWriteBind(ClientContext &context, CopyInfo &info, vector<string> &names,
@@ -402,27 +501,21 @@ unique_ptr<GlobalFunctionData> ParquetWriteInitializeGlobal(ClientContext &conte
 	return move(global_state);
 }
 
-void ParquetWriteSink(ClientContext &context, FunctionData &bind_data, GlobalFunctionData &gstate,
-                      LocalFunctionData &lstate, DataChunk &input) {
+unique_ptr<PreparedBatchData> ParquetWritePrepareBatch(ClientContext &context, FunctionData &bind_data,
+                                                       GlobalFunctionData &gstate, ChunkCollection &collection) {
 	auto &global_state = (ParquetWriteGlobalState &)gstate;
-	auto &local_state = (ParquetWriteLocalState &)lstate;
-
-	// append data to the local (buffered) chunk collection
-	local_state.buffer->Append(input);
-	if (local_state.buffer->Count() > 100000) {
-		// if the chunk collection exceeds a certain size we flush it to the parquet file
-		global_state.writer->Flush(*local_state.buffer);
-		// and reset the buffer
-		local_state.buffer = make_unique<ChunkCollection>();
-	}
+	// serialize and compress the row group in the current thread
+	auto batch = make_unique<ParquetWritePreparedBatch>();
+	global_state.writer->PrepareRowGroup(collection, batch->prepared);
+	return move(batch);
 }
 
-void ParquetWriteCombine(ClientContext &context, FunctionData &bind_data, GlobalFunctionData &gstate,
-                         LocalFunctionData &lstate) {
+void ParquetWriteFlushBatch(ClientContext &context, FunctionData &bind_data, GlobalFunctionData &gstate,
+                            PreparedBatchData &batch) {
 	auto &global_state = (ParquetWriteGlobalState &)gstate;
-	auto &local_state = (ParquetWriteLocalState &)lstate;
-	// flush any data left in the local state to the file
-	global_state.writer->Flush(*local_state.buffer);
+	auto &parquet_batch = (ParquetWritePreparedBatch &)batch;
+	// append the prepared row group to the file
+	global_state.writer->FlushRowGroup(parquet_batch.prepared);
 }
 
 void ParquetWriteFinalize(ClientContext &context, FunctionData &bind_data, GlobalFunctionData &gstate) {
@@ -431,10 +524,6 @@ void ParquetWriteFinalize(ClientContext &context, FunctionData &bind_data, Globa
 	global_state.writer->Finalize();
 }
 
-unique_ptr<LocalFunctionData> ParquetWriteInitializeLocal(ClientContext &context, FunctionData &bind_data) {
-	return make_unique<ParquetWriteLocalState>();
-}
-
 unique_ptr<TableFunctionRef> ParquetScanReplacement(const string &table_name, void *data) {
 	if (!StringUtil::EndsWith(table_name, ".parquet")) {
 		return nullptr;
@@ -462,10 +551,9 @@ void ParquetExtension::Load(DuckDB &db) {
 	CopyFunction function("parquet");
 	function.copy_to_bind = ParquetWriteBind;
 	function.copy_to_initialize_global = ParquetWriteInitializeGlobal;
-	function.copy_to_initialize_local = ParquetWriteInitializeLocal;
-	function.copy_to_sink = ParquetWriteSink;
-	function.copy_to_combine = ParquetWriteCombine;
 	function.copy_to_finalize = ParquetWriteFinalize;
+	function.copy_to_prepare_batch = ParquetWritePrepareBatch;
+	function.copy_to_flush_batch = ParquetWriteFlushBatch;
 	function.copy_from_bind = ParquetScanFunction::ParquetReadBind;
 	function.copy_from_function = scan_fun.functions[0];
 
@@ -29,11 +29,13 @@
 #include "duckdb/storage/object_cache.hpp"
 #endif
 
+#include <algorithm>
 #include <sstream>
 #include <cassert>
 #include <chrono>
 #include <cstring>
 #include <iostream>
+#include <iterator>
 
 namespace duckdb {
 
@@ -368,6 +370,155 @@ void ParquetReader::PrepareRowGroupBuffer(ParquetReaderScanState &state, idx_t o
 	state.root_reader->IntializeRead(group.columns, *state.thrift_file_proto);
 }
 
+//! Whether or not a page that only contains NULL values can be skipped for the filter
+static bool FilterRejectsNull(TableFilter &filter) {
+	switch (filter.filter_type) {
+	case TableFilterType::CONSTANT_COMPARISON:
+	case TableFilterType::IS_NOT_NULL:
+	case TableFilterType::JOIN_KEY:
+		return true;
+	default:
+		return false;
+	}
+}
+
+idx_t ParquetReader::GroupRowEnd(ParquetReaderScanState &state) {
+	return MinValue<idx_t>(GetGroup(state).num_rows, state.row_end);
+}
+
+bool ParquetReader::CanSkipRows(const vector<column_t> &column_ids) {
+	// rows can only be skipped if every column is flat (i.e. pages contain rows rather than values)
+	for (auto &file_col_idx : column_ids) {
+		if (file_col_idx == COLUMN_IDENTIFIER_ROW_ID) {
+			continue;
+		}
+		auto type_id = return_types[file_col_idx].id();
+		if (type_id == LogicalTypeId::LIST || type_id == LogicalTypeId::STRUCT || type_id == LogicalTypeId::MAP) {
+			return false;
+		}
+	}
+	return true;
+}
+
+vector<idx_t> ParquetReader::GetPageBoundaries(idx_t group_idx, const vector<column_t> &column_ids) {
+	auto &group = GetFileMetadata()->row_groups[group_idx];
+	auto root_reader = CreateReader(*this, GetFileMetadata());
+	auto handle = file_handle->file_system.OpenFile(file_handle->path, FileFlags::FILE_FLAGS_READ);
+	auto proto = CreateThriftProtocol(*handle);
+	auto &trans = (ThriftFileTransport &)*proto->getTransport();
+
+	vector<idx_t> result;
+	bool first_column = true;
+	for (auto &file_col_idx : column_ids) {
+		if (file_col_idx == COLUMN_IDENTIFIER_ROW_ID) {
+			continue;
+		}
+		auto column_reader = ((StructColumnReader *)root_reader.get())->GetChildReader(file_col_idx);
+		auto &chunk = group.columns[column_reader->FileIdx()];
+		if (!chunk.__isset.offset_index_offset) {
+			return vector<idx_t>();
+		}
+		duckdb_parquet::format::OffsetIndex offset_index;
+		trans.SetLocation(chunk.offset_index_offset);
+		offset_index.read(proto.get());
+
+		vector<idx_t> boundaries;
+		for (auto &page : offset_index.page_locations) {
+			if (page.first_row_index > 0 && page.first_row_index < group.num_rows) {
+				boundaries.push_back(page.first_row_index);
+			}
+		}
+		if (first_column) {
+			result = move(boundaries);
+			first_column = false;
+		} else {
+			// only the boundaries that all columns have in common can be used
+			vector<idx_t> common;
+			std::set_intersection(result.begin(), result.end(), boundaries.begin(), boundaries.end(),
+			                      std::back_inserter(common));
+			result = move(common);
+		}
+		if (result.empty()) {
+			break;
+		}
+	}
+	return result;
+}
+
+void ParquetReader::PrunePages(ParquetReaderScanState &state) {
+	state.pruned_rows.clear();
+	state.pruned_rows_idx = 0;
+	if (state.row_start > 0) {
+		// the rows before the scanned range are read by another scan
+		D_ASSERT(CanSkipRows(state.column_ids));
+		state.pruned_rows.emplace_back(0, state.row_start);
+	}
+	if (!state.filters || !CanSkipRows(state.column_ids)) {
+		return;
+	}
+	auto &group = GetGroup(state);
+	auto root_reader = ((StructColumnReader *)state.root_reader.get());
+
+	auto &trans = (ThriftFileTransport &)*state.thrift_file_proto->getTransport();
+	for (auto &filter_entry : state.filters->filters) {
+		auto column_reader = root_reader->GetChildReader(state.column_ids[filter_entry.first]);
+		auto &chunk = group.columns[column_reader->FileIdx()];
+		if (!chunk.__isset.column_index_offset || !chunk.__isset.offset_index_offset) {
+			// the writer of the file did not write a page index
+			continue;
+		}
+		duckdb_parquet::format::ColumnIndex column_index;
+		trans.SetLocation(chunk.column_index_offset);
+		column_index.read(state.thrift_file_proto.get());
+		duckdb_parquet::format::OffsetIndex offset_index;
+		trans.SetLocation(chunk.offset_index_offset);
+		offset_index.read(state.thrift_file_proto.get());
+
+		auto &pages = offset_index.page_locations;
+		if (column_index.null_pages.size() != pages.size() || column_index.min_values.size() != pages.size() ||
+		    column_index.max_values.size() != pages.size()) {
+			throw FormatException("Page index of column \"%s\" is inconsistent", column_reader->Schema().name);
+		}
+		auto &filter = *filter_entry.second;
+		for (idx_t page_idx = 0; page_idx < pages.size(); page_idx++) {
+			bool prune_page;
+			if (column_index.null_pages[page_idx]) {
+				prune_page = FilterRejectsNull(filter);
+			} else {
+				duckdb_parquet::format::Statistics page_stats;
+				page_stats.__set_min_value(column_index.min_values[page_idx]);
+				page_stats.__set_max_value(column_index.max_values[page_idx]);
+				if (column_index.__isset.null_counts && page_idx < column_index.null_counts.size()) {
+					page_stats.__set_null_count(column_index.null_counts[page_idx]);
+				}
+				auto stats = ParquetTransformStatistics(column_reader->Schema(), column_reader->Type(), page_stats);
+				prune_page = stats && filter.CheckStatistics(*stats) == FilterPropagateResult::FILTER_ALWAYS_FALSE;
+			}
+			if (!prune_page) {
+				continue;
+			}
+			idx_t page_start = pages[page_idx].first_row_index;
+			idx_t page_end = page_idx + 1 < pages.size() ? pages[page_idx + 1].first_row_index : group.num_rows;
+			state.pruned_rows.emplace_back(page_start, page_end);
+		}
+	}
+	if (state.pruned_rows.empty()) {
+		return;
+	}
+	// the filters are conjunctive: rows that are ruled out by any filter are skipped, so we merge the ranges
+	std::sort(state.pruned_rows.begin(), state.pruned_rows.end());
+	idx_t result_idx = 0;
+	for (idx_t range_idx = 1; range_idx < state.pruned_rows.size(); range_idx++) {
+		auto &current = state.pruned_rows[result_idx];
+		if (state.pruned_rows[range_idx].first <= current.second) {
+			current.second = MaxValue<idx_t>(current.second, state.pruned_rows[range_idx].second);
+		} else {
+			state.pruned_rows[++result_idx] = state.pruned_rows[range_idx];
+		}
+	}
+	state.pruned_rows.resize(result_idx + 1);
+}
+
 idx_t ParquetReader::NumRows() {
 	return GetFileMetadata()->num_rows;
 }
@@ -377,7 +528,8 @@ idx_t ParquetReader::NumRowGroups() {
 }
 
 void ParquetReader::InitializeScan(ParquetReaderScanState &state, vector<column_t> column_ids,
-                                   vector<idx_t> groups_to_read, TableFilterSet *filters) {
+                                   vector<idx_t> groups_to_read, TableFilterSet *filters, idx_t row_start,
+                                   idx_t row_end) {
 	state.current_group = -1;
 	state.finished = false;
 	state.column_ids = move(column_ids);
@@ -385,6 +537,10 @@ void ParquetReader::InitializeScan(ParquetReaderScanState &state, vector<column_
 	state.group_idx_list = move(groups_to_read);
 	state.filters = filters;
 	state.sel.Initialize(STANDARD_VECTOR_SIZE);
+	state.pruned_rows_idx = 0;
+	state.row_start = row_start;
+	state.row_end = row_end;
+	D_ASSERT(row_start == 0 || state.group_idx_list.size() == 1);
 	state.file_handle = file_handle->file_system.OpenFile(file_handle->path, FileFlags::FILE_FLAGS_READ);
 	state.thrift_file_proto = CreateThriftProtocol(*state.file_handle);
 	state.root_reader = CreateReader(*this, GetFileMetadata());
@@ -549,7 +705,7 @@ bool ParquetReader::ScanInternal(ParquetReaderScanState &state, DataChunk &resul
 	}
 
 	// see if we have to switch to the next row group in the parquet file
-	if (state.current_group < 0 || (int64_t)state.group_offset >= GetGroup(state).num_rows) {
+	if (state.current_group < 0 || state.group_offset >= GroupRowEnd(state)) {
 		state.current_group++;
 		state.group_offset = 0;
 
@@ -566,10 +722,48 @@ bool ParquetReader::ScanInternal(ParquetReaderScanState &state, DataChunk &resul
 
 			PrepareRowGroupBuffer(state, out_col_idx);
 		}
+		auto &trans = (ThriftFileTransport &)*state.thrift_file_proto->getTransport();
+		trans.ClearPrefetch();
+		if (state.group_offset < GroupRowEnd(state)) {
+			PrunePages(state);
+			if (!state.file_handle->OnDiskFile() && state.pruned_rows.empty()) {
+				// every request to a remote file is expensive: read the column chunks of the group all at once
+				auto root_reader = ((StructColumnReader *)state.root_reader.get());
+				for (auto &file_col_idx : state.column_ids) {
+					if (file_col_idx != COLUMN_IDENTIFIER_ROW_ID) {
+						root_reader->GetChildReader(file_col_idx)->RegisterPrefetch(trans);
+					}
+				}
+				trans.FinalizeRegistration();
+			}
+		}
+		return true;
+	}
+
+	// skip the rows that the page index ruled out without reading them
+	while (state.pruned_rows_idx < state.pruned_rows.size() &&
+	       state.pruned_rows[state.pruned_rows_idx].second <= state.group_offset) {
+		state.pruned_rows_idx++;
+	}
+	if (state.pruned_rows_idx < state.pruned_rows.size() &&
+	    state.pruned_rows[state.pruned_rows_idx].first <= state.group_offset) {
+		auto skip_end = MinValue<idx_t>(state.pruned_rows[state.pruned_rows_idx].second, GroupRowEnd(state));
+		if (skip_end < GroupRowEnd(state)) {
+			// the rest of the group is read later on: skip the rows in all columns
+			auto root_reader = ((StructColumnReader *)state.root_reader.get());
+			for (auto &file_col_idx : state.column_ids) {
+				if (file_col_idx == COLUMN_IDENTIFIER_ROW_ID) {
+					continue;
+				}
+				root_reader->GetChildReader(file_col_idx)->Skip(skip_end - state.group_offset);
+			}
+		}
+		state.group_offset = skip_end;
+		result.SetCardinality(0);
 		return true;
 	}
 
-	auto this_output_chunk_rows = MinValue<idx_t>(STANDARD_VECTOR_SIZE, GetGroup(state).num_rows - state.group_offset);
+	auto this_output_chunk_rows = MinValue<idx_t>(STANDARD_VECTOR_SIZE, GroupRowEnd(state) - state.group_offset);
 	result.SetCardinality(this_output_chunk_rows);
 
 	if (this_output_chunk_rows == 0) {
@@ -25,14 +25,15 @@ static unique_ptr<BaseStatistics> TemplatedGetNumericStats(const LogicalType &ty
 	} else if (parquet_stats.__isset.min_value) {
 		stats->min = FUNC((const_data_ptr_t)parquet_stats.min_value.data());
 	} else {
-		stats->min.is_null = true;
+		// the range of the values is unknown (e.g. for types without a defined sort order): we cannot prune anything
+		return nullptr;
 	}
 	if (parquet_stats.__isset.max) {
 		stats->max = FUNC((const_data_ptr_t)parquet_stats.max.data());
 	} else if (parquet_stats.__isset.max_value) {
 		stats->max = FUNC((const_data_ptr_t)parquet_stats.max_value.data());
 	} else {
-		stats->max.is_null = true;
+		return nullptr;
 	}
 	// GCC 4.x insists on a move() here
 	return move(stats);
@@ -81,7 +82,11 @@ unique_ptr<BaseStatistics> ParquetTransformColumnStatistics(const SchemaElement
 		// no stats present for row group
 		return nullptr;
 	}
-	auto &parquet_stats = column_chunk.meta_data.statistics;
+	return ParquetTransformStatistics(s_ele, type, column_chunk.meta_data.statistics);
+}
+
+unique_ptr<BaseStatistics> ParquetTransformStatistics(const SchemaElement &s_ele, const LogicalType &type,
+                                                      const duckdb_parquet::format::Statistics &parquet_stats) {
 	unique_ptr<BaseStatistics> row_group_stats;
 
 	switch (type.id()) {
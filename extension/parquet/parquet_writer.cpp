@@ -10,6 +10,8 @@
 #include "duckdb/main/connection.hpp"
 #include "duckdb/common/file_system.hpp"
 #include "duckdb/common/string_util.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/operator/comparison_operators.hpp"
 #include "duckdb/common/types/date.hpp"
 #include "duckdb/common/types/time.hpp"
 #include "duckdb/common/types/timestamp.hpp"
@@ -29,6 +31,7 @@ using namespace duckdb_apache::thrift::protocol;  // NOLINT
 using namespace duckdb_apache::thrift::transport; // NOLINT
 using namespace duckdb_miniz;                     // NOLINT
 
+using duckdb_parquet::format::BoundaryOrder;
 using duckdb_parquet::format::CompressionCodec;
 using duckdb_parquet::format::ConvertedType;
 using duckdb_parquet::format::Encoding;
@@ -109,29 +112,553 @@ static void VarintEncode(uint32_t val, Serializer &ser) {
 	} while (val != 0);
 }
 
-static uint8_t GetVarintSize(uint32_t val) {
-	uint8_t res = 0;
-	do {
-		uint8_t byte = val & 127;
-		val >>= 7;
-		if (val != 0) {
-			byte |= 128;
+static uint8_t ComputeBitWidth(idx_t val) {
+	uint8_t ret = 0;
+	while (val > 0) {
+		val >>= 1;
+		ret++;
+	}
+	return ret;
+}
+
+//===--------------------------------------------------------------------===//
+// RLE/Bit-Packing Hybrid
+//===--------------------------------------------------------------------===//
+//! Runs of equal values that are shorter than this are bit-packed instead of run-length encoded
+static constexpr idx_t MINIMUM_RLE_RUN_LENGTH = 16;
+
+static void WriteRleRun(uint32_t value, idx_t count, uint8_t bit_width, Serializer &ser) {
+	// the header of a repeated run is the run length shifted left by 1, the value follows in as few bytes as possible
+	VarintEncode(count << 1, ser);
+	idx_t byte_width = (bit_width + 7) / 8;
+	for (idx_t i = 0; i < byte_width; i++) {
+		ser.Write<uint8_t>((value >> (i * 8)) & 0xFF);
+	}
+}
+
+static void WriteBitPackedRun(const uint32_t *values, idx_t count, uint8_t bit_width, Serializer &ser) {
+	// bit-packed runs consist of groups of 8 values: the header is the group count shifted left 1 with the low bit set
+	auto group_count = (count + 7) / 8;
+	VarintEncode((group_count << 1) | 1, ser);
+	// the values are packed starting from the least significant bit, the last group is padded with zeros
+	uint64_t buffer = 0;
+	uint8_t buffer_bits = 0;
+	for (idx_t i = 0; i < group_count * 8; i++) {
+		uint64_t value = i < count ? values[i] : 0;
+		buffer |= value << buffer_bits;
+		buffer_bits += bit_width;
+		while (buffer_bits >= 8) {
+			ser.Write<uint8_t>(buffer & 0xFF);
+			buffer >>= 8;
+			buffer_bits -= 8;
 		}
-		res++;
-	} while (val != 0);
-	return res;
+	}
+	D_ASSERT(buffer_bits == 0);
+}
+
+//! Writes the values using the RLE/bit-packing hybrid encoding: long runs of equal values are run-length encoded,
+//! everything in between is bit-packed
+static void RleBpEncode(const uint32_t *values, idx_t count, uint8_t bit_width, Serializer &ser) {
+	idx_t literal_start = 0;
+	idx_t idx = 0;
+	while (idx < count) {
+		idx_t run_end = idx + 1;
+		while (run_end < count && values[run_end] == values[idx]) {
+			run_end++;
+		}
+		if (run_end - idx >= MINIMUM_RLE_RUN_LENGTH) {
+			// only the last bit-packed run can be padded: complete the pending values with the start of the run
+			auto literal_end = literal_start + (idx - literal_start + 7) / 8 * 8;
+			if (literal_end > literal_start) {
+				WriteBitPackedRun(values + literal_start, literal_end - literal_start, bit_width, ser);
+			}
+			WriteRleRun(values[idx], run_end - literal_end, bit_width, ser);
+			literal_start = run_end;
+		}
+		idx = run_end;
+	}
+	if (literal_start < count) {
+		WriteBitPackedRun(values + literal_start, count - literal_start, bit_width, ser);
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Column Chunk Encoders
+//===--------------------------------------------------------------------===//
+//! Dictionaries that grow larger than this (in bytes) are abandoned in favor of PLAIN encoding
+static constexpr idx_t MAXIMUM_DICTIONARY_SIZE = 1048576;
+//! Column chunks are split into pages of (at most) this amount of rows
+static constexpr idx_t MAXIMUM_PAGE_ROW_COUNT = 20480;
+
+//! Encodes the non-null values of a column chunk, both as PLAIN values and (as long as it is small enough) as indexes
+//! into a dictionary, and keeps track of the min/max statistics of the chunk and of each of its pages
+class ColumnChunkEncoder {
+public:
+	virtual ~ColumnChunkEncoder() {
+	}
+
+	//! The PLAIN encoded values
+	BufferedSerializer plain;
+	//! The PLAIN encoded dictionary entries
+	BufferedSerializer dictionary;
+	//! The dictionary index of every value
+	vector<uint32_t> dictionary_indexes;
+	//! The amount of entries in the dictionary
+	idx_t dictionary_count = 0;
+	//! Whether or not the values can still be dictionary encoded
+	bool use_dictionary = true;
+
+	//! The end of every page in the PLAIN values and in the dictionary indexes
+	vector<idx_t> page_plain_ends;
+	vector<idx_t> page_index_ends;
+	//! The PLAIN encoded min/max value of every page (empty for pages that only contain NULL values)
+	vector<string> page_min_values;
+	vector<string> page_max_values;
+
+public:
+	virtual void Append(Vector &input, idx_t count) = 0;
+	virtual void WriteStatistics(duckdb_parquet::format::Statistics &stats) = 0;
+
+	//! Closes the current page: values that are appended after this belong to the next page
+	void FinishPage() {
+		string min_value, max_value;
+		FinishPageInternal(min_value, max_value);
+		page_min_values.push_back(move(min_value));
+		page_max_values.push_back(move(max_value));
+		page_plain_ends.push_back(plain.blob.size);
+		page_index_ends.push_back(dictionary_indexes.size());
+	}
+
+	//! Whether or not writing the dictionary and its indexes is smaller than writing the PLAIN values
+	bool DictionaryIsSmaller() {
+		if (!use_dictionary || dictionary_count == 0) {
+			return false;
+		}
+		auto index_size = dictionary_indexes.size() * ComputeBitWidth(dictionary_count - 1) / 8;
+		return dictionary.blob.size + index_size < plain.blob.size;
+	}
+
+protected:
+	//! Writes the min/max of the current page (if it has any) and resets the page statistics
+	virtual void FinishPageInternal(string &min_value, string &max_value) = 0;
+
+	void AbandonDictionary() {
+		use_dictionary = false;
+		dictionary_count = 0;
+		dictionary.Reset();
+		vector<uint32_t>().swap(dictionary_indexes);
+	}
+};
+
+//! HAS_STATISTICS is false for the types that are written as INT96: the sort order of INT96 is undefined, so readers
+//! ignore (or misinterpret) its min/max statistics
+struct ParquetCastOperator {
+	static constexpr bool HAS_STATISTICS = true;
+
+	template <class SRC, class TGT>
+	static TGT Operation(SRC input) {
+		return TGT(input);
+	}
+};
+
+struct ParquetDateOperator {
+	static constexpr bool HAS_STATISTICS = false;
+
+	template <class SRC, class TGT>
+	static TGT Operation(SRC input) {
+		auto ts = Timestamp::FromDatetime(input, dtime_t(0));
+		return TimestampToImpalaTimestamp(ts);
+	}
+};
+
+struct ParquetTimestampOperator {
+	static constexpr bool HAS_STATISTICS = false;
+
+	template <class SRC, class TGT>
+	static TGT Operation(SRC input) {
+		return TimestampToImpalaTimestamp(input);
+	}
+};
+
+//! Values are put in the dictionary by their bit pattern, so e.g. -0.0 and 0.0 get their own entry
+template <idx_t SIZE>
+struct DictionaryKey {};
+template <>
+struct DictionaryKey<1> {
+	typedef uint8_t type;
+};
+template <>
+struct DictionaryKey<2> {
+	typedef uint16_t type;
+};
+template <>
+struct DictionaryKey<4> {
+	typedef uint32_t type;
+};
+template <>
+struct DictionaryKey<8> {
+	typedef uint64_t type;
+};
+
+template <class SRC, class TGT, class OP = ParquetCastOperator>
+class NumericChunkEncoder : public ColumnChunkEncoder {
+	typedef typename DictionaryKey<sizeof(SRC)>::type dictionary_key_t;
+
+public:
+	void Append(Vector &input, idx_t count) override {
+		auto ptr = FlatVector::GetData<SRC>(input);
+		auto &mask = FlatVector::Validity(input);
+		for (idx_t r = 0; r < count; r++) {
+			if (!mask.RowIsValid(r)) {
+				continue;
+			}
+			auto target = OP::template Operation<SRC, TGT>(ptr[r]);
+			plain.Write<TGT>(target);
+			if (OP::HAS_STATISTICS && Value::IsValid<SRC>(ptr[r])) {
+				// NaN values are not included in the statistics
+				if (!page_has_stats || ptr[r] < page_min) {
+					page_min = ptr[r];
+				}
+				if (!page_has_stats || ptr[r] > page_max) {
+					page_max = ptr[r];
+				}
+				page_has_stats = true;
+			}
+			if (!use_dictionary) {
+				continue;
+			}
+			dictionary_key_t key;
+			memcpy(&key, &ptr[r], sizeof(SRC));
+			auto entry = dictionary_map.find(key);
+			if (entry == dictionary_map.end()) {
+				dictionary.Write<TGT>(target);
+				if (dictionary.blob.size > MAXIMUM_DICTIONARY_SIZE) {
+					AbandonDictionary();
+					dictionary_map.clear();
+					continue;
+				}
+				entry = dictionary_map.insert(make_pair(key, dictionary_count++)).first;
+			}
+			dictionary_indexes.push_back(entry->second);
+		}
+	}
+
+	void WriteStatistics(duckdb_parquet::format::Statistics &stats) override {
+		if (!has_stats) {
+			return;
+		}
+		stats.min_value = SerializeValue(min);
+		stats.max_value = SerializeValue(max);
+		stats.__isset.min_value = true;
+		stats.__isset.max_value = true;
+	}
+
+protected:
+	void FinishPageInternal(string &min_value, string &max_value) override {
+		if (!page_has_stats) {
+			return;
+		}
+		min_value = SerializeValue(page_min);
+		max_value = SerializeValue(page_max);
+		if (!has_stats || page_min < min) {
+			min = page_min;
+		}
+		if (!has_stats || page_max > max) {
+			max = page_max;
+		}
+		has_stats = true;
+		page_has_stats = false;
+	}
+
+private:
+	static string SerializeValue(SRC value) {
+		auto target = OP::template Operation<SRC, TGT>(value);
+		return string((const char *)&target, sizeof(TGT));
+	}
+
+private:
+	unordered_map<dictionary_key_t, uint32_t> dictionary_map;
+	bool has_stats = false;
+	SRC min;
+	SRC max;
+	bool page_has_stats = false;
+	SRC page_min;
+	SRC page_max;
+};
+
+class DecimalChunkEncoder : public NumericChunkEncoder<double, double> {
+public:
+	void Append(Vector &input, idx_t count) override {
+		// FIXME: fixed length byte array...
+		Vector double_vec(LogicalType::DOUBLE);
+		VectorOperations::Cast(input, double_vec, count);
+		NumericChunkEncoder<double, double>::Append(double_vec, count);
+	}
+};
+
+class BooleanChunkEncoder : public ColumnChunkEncoder {
+public:
+	BooleanChunkEncoder() {
+		// dictionaries are not defined for booleans
+		use_dictionary = false;
+	}
+
+	void Append(Vector &input, idx_t count) override {
+		auto *ptr = FlatVector::GetData<bool>(input);
+		auto &mask = FlatVector::Validity(input);
+		for (idx_t r = 0; r < count; r++) {
+			if (!mask.RowIsValid(r)) {
+				continue;
+			}
+			// booleans are bit-packed, starting from the least significant bit
+			byte |= (ptr[r] & 1) << byte_pos;
+			byte_pos++;
+			if (byte_pos == 8) {
+				plain.Write<uint8_t>(byte);
+				byte = 0;
+				byte_pos = 0;
+			}
+			page_has_true = page_has_true || ptr[r];
+			page_has_false = page_has_false || !ptr[r];
+		}
+	}
+
+	void WriteStatistics(duckdb_parquet::format::Statistics &stats) override {
+		if (!has_true && !has_false) {
+			return;
+		}
+		stats.min_value = string(1, has_false ? '\0' : '\1');
+		stats.max_value = string(1, has_true ? '\1' : '\0');
+		stats.__isset.min_value = true;
+		stats.__isset.max_value = true;
+	}
+
+protected:
+	void FinishPageInternal(string &min_value, string &max_value) override {
+		// every page starts at a byte boundary: flush the last byte
+		if (byte_pos > 0) {
+			plain.Write<uint8_t>(byte);
+			byte = 0;
+			byte_pos = 0;
+		}
+		if (!page_has_true && !page_has_false) {
+			return;
+		}
+		min_value = string(1, page_has_false ? '\0' : '\1');
+		max_value = string(1, page_has_true ? '\1' : '\0');
+		has_true = has_true || page_has_true;
+		has_false = has_false || page_has_false;
+		page_has_true = false;
+		page_has_false = false;
+	}
+
+private:
+	uint8_t byte = 0;
+	uint8_t byte_pos = 0;
+	bool has_true = false;
+	bool has_false = false;
+	bool page_has_true = false;
+	bool page_has_false = false;
+};
+
+//! String statistics are truncated to this amount of bytes, so long strings do not bloat the metadata
+static constexpr idx_t MAXIMUM_STRING_STATISTICS_SIZE = 64;
+
+//! Returns the longest prefix of the (UTF-8) string of at most MAXIMUM_STRING_STATISTICS_SIZE bytes, which is a lower
+//! bound of the string. The prefix ends at a character boundary.
+static string TruncateStringMin(const string &value) {
+	if (value.size() <= MAXIMUM_STRING_STATISTICS_SIZE) {
+		return value;
+	}
+	idx_t size = MAXIMUM_STRING_STATISTICS_SIZE;
+	while (size > 0 && ((uint8_t)value[size] & 0xC0) == 0x80) {
+		// the prefix would end in the middle of a character
+		size--;
+	}
+	return value.substr(0, size);
+}
+
+//! Returns an upper bound of the (UTF-8) string of at most MAXIMUM_STRING_STATISTICS_SIZE bytes: the last character
+//! of the prefix whose final byte can be incremented without producing invalid UTF-8 is incremented, and the rest of
+//! the prefix is dropped. If there is no such character, the string is returned as-is.
+static string TruncateStringMax(const string &value) {
+	if (value.size() <= MAXIMUM_STRING_STATISTICS_SIZE) {
+		return value;
+	}
+	auto prefix = TruncateStringMin(value);
+	for (idx_t i = prefix.size(); i > 0; i--) {
+		auto byte = (uint8_t)prefix[i - 1];
+		if (i < prefix.size() && ((uint8_t)prefix[i] & 0xC0) == 0x80) {
+			// not the final byte of a character
+			continue;
+		}
+		if (byte < 0x7F || (byte >= 0x80 && byte < 0xBF)) {
+			// an ASCII character or the final (continuation) byte of a multi-byte character
+			prefix.resize(i);
+			prefix[i - 1] = (char)(byte + 1);
+			return prefix;
+		}
+	}
+	return value;
 }
 
-template <class SRC, class TGT>
-static void TemplatedWritePlain(Vector &col, idx_t length, ValidityMask &mask, Serializer &ser) {
-	auto *ptr = FlatVector::GetData<SRC>(col);
-	for (idx_t r = 0; r < length; r++) {
-		if (mask.RowIsValid(r)) {
-			ser.Write<TGT>((TGT)ptr[r]);
+class StringChunkEncoder : public ColumnChunkEncoder {
+public:
+	void Append(Vector &input, idx_t count) override {
+		auto *ptr = FlatVector::GetData<string_t>(input);
+		auto &mask = FlatVector::Validity(input);
+		for (idx_t r = 0; r < count; r++) {
+			if (!mask.RowIsValid(r)) {
+				continue;
+			}
+			auto &str = ptr[r];
+			plain.Write<uint32_t>(str.GetSize());
+			plain.WriteData((const_data_ptr_t)str.GetDataUnsafe(), str.GetSize());
+			if (!page_has_stats || LessThan::Operation<string_t>(str, string_t(page_min))) {
+				page_min = str.GetString();
+			}
+			if (!page_has_stats || GreaterThan::Operation<string_t>(str, string_t(page_max))) {
+				page_max = str.GetString();
+			}
+			page_has_stats = true;
+			if (!use_dictionary) {
+				continue;
+			}
+			auto key = str.GetString();
+			auto entry = dictionary_map.find(key);
+			if (entry == dictionary_map.end()) {
+				dictionary.Write<uint32_t>(str.GetSize());
+				dictionary.WriteData((const_data_ptr_t)str.GetDataUnsafe(), str.GetSize());
+				if (dictionary.blob.size > MAXIMUM_DICTIONARY_SIZE) {
+					AbandonDictionary();
+					dictionary_map.clear();
+					continue;
+				}
+				entry = dictionary_map.insert(make_pair(move(key), dictionary_count++)).first;
+			}
+			dictionary_indexes.push_back(entry->second);
+		}
+	}
+
+	void WriteStatistics(duckdb_parquet::format::Statistics &stats) override {
+		if (!has_stats) {
+			return;
+		}
+		// strings are compared byte-wise (unsigned), which is the sort order of the parquet BYTE_ARRAY type
+		stats.min_value = TruncateStringMin(min);
+		stats.max_value = TruncateStringMax(max);
+		stats.__isset.min_value = true;
+		stats.__isset.max_value = true;
+	}
+
+protected:
+	void FinishPageInternal(string &min_value, string &max_value) override {
+		if (!page_has_stats) {
+			return;
 		}
+		min_value = TruncateStringMin(page_min);
+		max_value = TruncateStringMax(page_max);
+		if (!has_stats || page_min < min) {
+			min = move(page_min);
+		}
+		if (!has_stats || page_max > max) {
+			max = move(page_max);
+		}
+		has_stats = true;
+		page_has_stats = false;
+	}
+
+private:
+	unordered_map<string, uint32_t> dictionary_map;
+	bool has_stats = false;
+	string min;
+	string max;
+	bool page_has_stats = false;
+	string page_min;
+	string page_max;
+};
+
+static unique_ptr<ColumnChunkEncoder> CreateChunkEncoder(const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::BOOLEAN:
+		return make_unique<BooleanChunkEncoder>();
+	case LogicalTypeId::TINYINT:
+		return make_unique<NumericChunkEncoder<int8_t, int32_t>>();
+	case LogicalTypeId::SMALLINT:
+		return make_unique<NumericChunkEncoder<int16_t, int32_t>>();
+	case LogicalTypeId::INTEGER:
+		return make_unique<NumericChunkEncoder<int32_t, int32_t>>();
+	case LogicalTypeId::BIGINT:
+		return make_unique<NumericChunkEncoder<int64_t, int64_t>>();
+	case LogicalTypeId::FLOAT:
+		return make_unique<NumericChunkEncoder<float, float>>();
+	case LogicalTypeId::DECIMAL:
+		return make_unique<DecimalChunkEncoder>();
+	case LogicalTypeId::DOUBLE:
+		return make_unique<NumericChunkEncoder<double, double>>();
+	case LogicalTypeId::DATE:
+		return make_unique<NumericChunkEncoder<date_t, Int96, ParquetDateOperator>>();
+	case LogicalTypeId::TIMESTAMP:
+		return make_unique<NumericChunkEncoder<timestamp_t, Int96, ParquetTimestampOperator>>();
+	case LogicalTypeId::BLOB:
+	case LogicalTypeId::VARCHAR:
+		return make_unique<StringChunkEncoder>();
+	default:
+		throw NotImplementedException(type.ToString());
 	}
 }
 
+//! Compresses the page and writes it (preceded by its header) to the target
+static void WritePage(PageHeader &hdr, BufferedSerializer &temp_writer, CompressionCodec::type codec,
+                      TProtocol &protocol, Serializer &target) {
+	// now that we have finished writing the data we know the uncompressed size
+	hdr.uncompressed_page_size = temp_writer.blob.size;
+
+	// compress the data based
+	size_t compressed_size;
+	data_ptr_t compressed_data;
+	unique_ptr<data_t[]> compressed_buf;
+	switch (codec) {
+	case CompressionCodec::UNCOMPRESSED:
+		compressed_size = temp_writer.blob.size;
+		compressed_data = temp_writer.blob.data.get();
+		break;
+	case CompressionCodec::SNAPPY: {
+		compressed_size = snappy::MaxCompressedLength(temp_writer.blob.size);
+		compressed_buf = unique_ptr<data_t[]>(new data_t[compressed_size]);
+		snappy::RawCompress((const char *)temp_writer.blob.data.get(), temp_writer.blob.size,
+		                    (char *)compressed_buf.get(), &compressed_size);
+		compressed_data = compressed_buf.get();
+		break;
+	}
+	case CompressionCodec::GZIP: {
+		MiniZStream s;
+		compressed_size = s.MaxCompressedLength(temp_writer.blob.size);
+		compressed_buf = unique_ptr<data_t[]>(new data_t[compressed_size]);
+		s.Compress((const char *)temp_writer.blob.data.get(), temp_writer.blob.size, (char *)compressed_buf.get(),
+		           &compressed_size);
+		compressed_data = compressed_buf.get();
+		break;
+	}
+	case CompressionCodec::ZSTD: {
+		compressed_size = duckdb_zstd::ZSTD_compressBound(temp_writer.blob.size);
+		compressed_buf = unique_ptr<data_t[]>(new data_t[compressed_size]);
+		compressed_size = duckdb_zstd::ZSTD_compress((void *)compressed_buf.get(), compressed_size,
+		                                             (const void *)temp_writer.blob.data.get(),
+		                                             temp_writer.blob.size, ZSTD_CLEVEL_DEFAULT);
+		compressed_data = compressed_buf.get();
+		break;
+	}
+	default:
+		throw InternalException("Unsupported codec for Parquet Writer");
+	}
+
+	hdr.compressed_page_size = compressed_size;
+	// now finally write the page
+	hdr.write(&protocol);
+	target.WriteData(compressed_data, compressed_size);
+}
+
 ParquetWriter::ParquetWriter(FileSystem &fs, string file_name_p, vector<LogicalType> types_p, vector<string> names_p,
                              CompressionCodec::type codec)
     : file_name(move(file_name_p)), sql_types(move(types_p)), column_names(move(names_p)), codec(codec) {
@@ -161,225 +688,231 @@ ParquetWriter::ParquetWriter(FileSystem &fs, string file_name_p, vector<LogicalT
 		schema_element.name = column_names[i];
 		schema_element.__isset.converted_type = DuckDBTypeToConvertedType(sql_types[i], schema_element.converted_type);
 	}
+	// readers only use the min/max statistics of a column if its sort order is given: all statistics that we write
+	// follow the sort order of their type
+	file_meta_data.column_orders.resize(sql_types.size());
+	for (auto &column_order : file_meta_data.column_orders) {
+		column_order.__set_TYPE_ORDER(duckdb_parquet::format::TypeDefinedOrder());
+	}
+	file_meta_data.__isset.column_orders = true;
 }
 
-void ParquetWriter::Flush(ChunkCollection &buffer) {
-	if (buffer.Count() == 0) {
-		return;
-	}
-	lock_guard<mutex> glock(lock);
+void ParquetWriter::PrepareRowGroup(ChunkCollection &buffer, PreparedRowGroup &result) {
+	// the pages are written into the buffer of the row group, the offsets are fixed once it is appended to the file
+	auto &data = result.data;
+	TCompactProtocolFactoryT<MyTransport> tproto_factory;
+	auto data_protocol = tproto_factory.getProtocol(make_shared<MyTransport>(data));
 
 	// set up a new row group for this chunk collection
-	ParquetRowGroup row_group;
+	auto &row_group = result.row_group;
 	row_group.num_rows = 0;
-	row_group.file_offset = writer->GetTotalWritten();
+	row_group.file_offset = 0;
 	row_group.__isset.file_offset = true;
 	row_group.columns.resize(buffer.ColumnCount());
+	result.column_indexes.resize(buffer.ColumnCount());
+	result.offset_indexes.resize(buffer.ColumnCount());
 
 	// iterate over each of the columns of the chunk collection and write them
 	for (idx_t i = 0; i < buffer.ColumnCount(); i++) {
-		// we start off by writing everything into a temporary buffer
+		// we start off by encoding everything into temporary buffers
 		// this is necessary to (1) know the total written size, and (2) to compress it afterwards
-		BufferedSerializer temp_writer;
-
-		// set up some metadata
-		PageHeader hdr;
-		hdr.compressed_page_size = 0;
-		hdr.uncompressed_page_size = 0;
-		hdr.type = PageType::DATA_PAGE;
-		hdr.__isset.data_page_header = true;
-
-		hdr.data_page_header.num_values = buffer.Count();
-		hdr.data_page_header.encoding = Encoding::PLAIN;
-		hdr.data_page_header.definition_level_encoding = Encoding::RLE;
-		hdr.data_page_header.repetition_level_encoding = Encoding::BIT_PACKED;
-
-		// record the current offset of the writer into the file
-		// this is the starting position of the current page
-		auto start_offset = writer->GetTotalWritten();
-
-		// write the definition levels (i.e. the inverse of the nullmask)
-		// we always bit pack everything
-
-		// first figure out how many bytes we need (1 byte per 8 rows, rounded up)
-		auto define_byte_count = (buffer.Count() + 7) / 8;
-		// we need to set up the count as a varint, plus an added marker for the RLE scheme
-		// for this marker we shift the count left 1 and set low bit to 1 to indicate bit packed literals
-		uint32_t define_header = (define_byte_count << 1) | 1;
-		uint32_t define_size = GetVarintSize(define_header) + define_byte_count;
-
-		// we write the actual definitions into the temp_writer for now
-		temp_writer.Write<uint32_t>(define_size);
-		VarintEncode(define_header, temp_writer);
-
+		auto encoder = CreateChunkEncoder(sql_types[i]);
+
+		// the definition levels are the inverse of the nullmask
+		vector<uint32_t> define_levels;
+		define_levels.reserve(buffer.Count());
+		// the rows are split into pages, so readers can skip the pages that do not match their filters
+		vector<idx_t> page_row_ends;
+		vector<int64_t> page_null_counts;
+		idx_t null_count = 0;
+		idx_t page_null_count = 0;
 		for (auto &chunk : buffer.Chunks()) {
-			auto &validity = FlatVector::Validity(chunk->data[i]);
-			auto validity_data = validity.GetData();
-			auto chunk_define_byte_count = (chunk->size() + 7) / 8;
-			if (!validity_data) {
-				ValidityMask nop_mask(chunk->size());
-				temp_writer.WriteData((const_data_ptr_t)nop_mask.GetData(), chunk_define_byte_count);
-			} else {
-				// write the bits of the nullmask
-				temp_writer.WriteData((const_data_ptr_t)validity_data, chunk_define_byte_count);
-			}
-		}
-
-		// now write the actual payload: we write this as PLAIN values (for now? possibly for ever?)
-		for (auto &chunk : buffer.Chunks()) {
-			auto &input = *chunk;
-			auto &input_column = input.data[i];
+			auto &input_column = chunk->data[i];
 			auto &mask = FlatVector::Validity(input_column);
-
-			// write actual payload data
-			switch (sql_types[i].id()) {
-			case LogicalTypeId::BOOLEAN: {
-				auto *ptr = FlatVector::GetData<bool>(input_column);
-				uint8_t byte = 0;
-				uint8_t byte_pos = 0;
-				for (idx_t r = 0; r < input.size(); r++) {
-					if (mask.RowIsValid(r)) { // only encode if non-null
-						byte |= (ptr[r] & 1) << byte_pos;
-						byte_pos++;
-
-						temp_writer.Write<uint8_t>(byte);
-						if (byte_pos == 8) {
-							temp_writer.Write<uint8_t>(byte);
-							byte = 0;
-							byte_pos = 0;
-						}
-					}
-				}
-				// flush last byte if req
-				if (byte_pos > 0) {
-					temp_writer.Write<uint8_t>(byte);
-				}
-				break;
-			}
-			case LogicalTypeId::TINYINT:
-				TemplatedWritePlain<int8_t, int32_t>(input_column, input.size(), mask, temp_writer);
-				break;
-			case LogicalTypeId::SMALLINT:
-				TemplatedWritePlain<int16_t, int32_t>(input_column, input.size(), mask, temp_writer);
-				break;
-			case LogicalTypeId::INTEGER:
-				TemplatedWritePlain<int32_t, int32_t>(input_column, input.size(), mask, temp_writer);
-				break;
-			case LogicalTypeId::BIGINT:
-				TemplatedWritePlain<int64_t, int64_t>(input_column, input.size(), mask, temp_writer);
-				break;
-			case LogicalTypeId::FLOAT:
-				TemplatedWritePlain<float, float>(input_column, input.size(), mask, temp_writer);
-				break;
-			case LogicalTypeId::DECIMAL: {
-				// FIXME: fixed length byte array...
-				Vector double_vec(LogicalType::DOUBLE);
-				VectorOperations::Cast(input_column, double_vec, input.size());
-				TemplatedWritePlain<double, double>(double_vec, input.size(), mask, temp_writer);
-				break;
-			}
-			case LogicalTypeId::DOUBLE:
-				TemplatedWritePlain<double, double>(input_column, input.size(), mask, temp_writer);
-				break;
-			case LogicalTypeId::DATE: {
-				auto *ptr = FlatVector::GetData<date_t>(input_column);
-				for (idx_t r = 0; r < input.size(); r++) {
-					if (mask.RowIsValid(r)) {
-						auto ts = Timestamp::FromDatetime(ptr[r], dtime_t(0));
-						temp_writer.Write<Int96>(TimestampToImpalaTimestamp(ts));
-					}
-				}
-				break;
-			}
-			case LogicalTypeId::TIMESTAMP: {
-				auto *ptr = FlatVector::GetData<timestamp_t>(input_column);
-				for (idx_t r = 0; r < input.size(); r++) {
-					if (mask.RowIsValid(r)) {
-						temp_writer.Write<Int96>(TimestampToImpalaTimestamp(ptr[r]));
-					}
-				}
-				break;
-			}
-			case LogicalTypeId::BLOB:
-			case LogicalTypeId::VARCHAR: {
-				auto *ptr = FlatVector::GetData<string_t>(input_column);
-				for (idx_t r = 0; r < input.size(); r++) {
-					if (mask.RowIsValid(r)) {
-						temp_writer.Write<uint32_t>(ptr[r].GetSize());
-						temp_writer.WriteData((const_data_ptr_t)ptr[r].GetDataUnsafe(), ptr[r].GetSize());
-					}
-				}
-				break;
+			for (idx_t r = 0; r < chunk->size(); r++) {
+				auto is_valid = mask.RowIsValid(r);
+				define_levels.push_back(is_valid ? 1 : 0);
+				page_null_count += !is_valid;
 			}
-			default:
-				throw NotImplementedException((sql_types[i].ToString()));
+			encoder->Append(input_column, chunk->size());
+
+			auto page_start = page_row_ends.empty() ? 0 : page_row_ends.back();
+			if (define_levels.size() - page_start >= MAXIMUM_PAGE_ROW_COUNT ||
+			    define_levels.size() == buffer.Count()) {
+				encoder->FinishPage();
+				page_row_ends.push_back(define_levels.size());
+				page_null_counts.push_back(page_null_count);
+				null_count += page_null_count;
+				page_null_count = 0;
 			}
 		}
+		D_ASSERT(!page_row_ends.empty() && page_row_ends.back() == buffer.Count());
 
-		// now that we have finished writing the data we know the uncompressed size
-		hdr.uncompressed_page_size = temp_writer.blob.size;
-
-		// compress the data based
-		size_t compressed_size;
-		data_ptr_t compressed_data;
-		unique_ptr<data_t[]> compressed_buf;
-		switch (codec) {
-		case CompressionCodec::UNCOMPRESSED:
-			compressed_size = temp_writer.blob.size;
-			compressed_data = temp_writer.blob.data.get();
-			break;
-		case CompressionCodec::SNAPPY: {
-			compressed_size = snappy::MaxCompressedLength(temp_writer.blob.size);
-			compressed_buf = unique_ptr<data_t[]>(new data_t[compressed_size]);
-			snappy::RawCompress((const char *)temp_writer.blob.data.get(), temp_writer.blob.size,
-			                    (char *)compressed_buf.get(), &compressed_size);
-			compressed_data = compressed_buf.get();
-			break;
-		}
-		case CompressionCodec::GZIP: {
-			MiniZStream s;
-			compressed_size = s.MaxCompressedLength(temp_writer.blob.size);
-			compressed_buf = unique_ptr<data_t[]>(new data_t[compressed_size]);
-			s.Compress((const char *)temp_writer.blob.data.get(), temp_writer.blob.size, (char *)compressed_buf.get(),
-			           &compressed_size);
-			compressed_data = compressed_buf.get();
-			break;
-		}
-		case CompressionCodec::ZSTD: {
-			compressed_size = duckdb_zstd::ZSTD_compressBound(temp_writer.blob.size);
-			compressed_buf = unique_ptr<data_t[]>(new data_t[compressed_size]);
-			compressed_size = duckdb_zstd::ZSTD_compress((void *)compressed_buf.get(), compressed_size,
-			                                             (const void *)temp_writer.blob.data.get(),
-			                                             temp_writer.blob.size, ZSTD_CLEVEL_DEFAULT);
-			compressed_data = compressed_buf.get();
-			break;
+		auto &column_chunk = row_group.columns[i];
+		column_chunk.__isset.meta_data = true;
+		column_chunk.meta_data.statistics.null_count = null_count;
+		column_chunk.meta_data.statistics.__isset.null_count = true;
+		encoder->WriteStatistics(column_chunk.meta_data.statistics);
+		column_chunk.meta_data.__isset.statistics = true;
+
+		// record the current offset into the row group
+		// this is the starting position of the column chunk
+		auto start_offset = data.blob.size;
+
+		// use the dictionary only if it actually makes the column chunk smaller
+		auto use_dictionary = encoder->DictionaryIsSmaller();
+		uint8_t bit_width = 0;
+		if (use_dictionary) {
+			// the dictionary page precedes the data pages
+			PageHeader dict_hdr;
+			dict_hdr.compressed_page_size = 0;
+			dict_hdr.uncompressed_page_size = 0;
+			dict_hdr.type = PageType::DICTIONARY_PAGE;
+			dict_hdr.__isset.dictionary_page_header = true;
+			dict_hdr.dictionary_page_header.num_values = encoder->dictionary_count;
+			dict_hdr.dictionary_page_header.encoding = Encoding::PLAIN;
+			WritePage(dict_hdr, encoder->dictionary, codec, *data_protocol, data);
+
+			column_chunk.meta_data.dictionary_page_offset = start_offset;
+			column_chunk.meta_data.__isset.dictionary_page_offset = true;
+			bit_width = MaxValue<uint8_t>(ComputeBitWidth(encoder->dictionary_count - 1), 1);
 		}
-		default:
-			throw InternalException("Unsupported codec for Parquet Writer");
+		column_chunk.meta_data.data_page_offset = data.blob.size;
+
+		// the column index holds the statistics of every page, the offset index its location
+		auto &column_index = result.column_indexes[i];
+		auto &offset_index = result.offset_indexes[i];
+		column_index.boundary_order = BoundaryOrder::UNORDERED;
+		column_index.null_counts = page_null_counts;
+		column_index.__isset.null_counts = true;
+
+		for (idx_t page_idx = 0; page_idx < page_row_ends.size(); page_idx++) {
+			auto row_start = page_idx == 0 ? 0 : page_row_ends[page_idx - 1];
+			auto row_count = page_row_ends[page_idx] - row_start;
+
+			// set up some metadata
+			PageHeader hdr;
+			hdr.compressed_page_size = 0;
+			hdr.uncompressed_page_size = 0;
+			hdr.type = PageType::DATA_PAGE;
+			hdr.__isset.data_page_header = true;
+
+			hdr.data_page_header.num_values = row_count;
+			hdr.data_page_header.encoding = use_dictionary ? Encoding::RLE_DICTIONARY : Encoding::PLAIN;
+			hdr.data_page_header.definition_level_encoding = Encoding::RLE;
+			hdr.data_page_header.repetition_level_encoding = Encoding::BIT_PACKED;
+
+			// write the definition levels, prefixed by their size
+			BufferedSerializer temp_writer;
+			BufferedSerializer define_writer;
+			RleBpEncode(define_levels.data() + row_start, row_count, 1, define_writer);
+			temp_writer.Write<uint32_t>(define_writer.blob.size);
+			temp_writer.WriteData(define_writer.blob.data.get(), define_writer.blob.size);
+
+			// now write the actual payload
+			if (use_dictionary) {
+				// the indexes are RLE/bit-packed, prefixed by their bit width
+				auto index_start = page_idx == 0 ? 0 : encoder->page_index_ends[page_idx - 1];
+				temp_writer.Write<uint8_t>(bit_width);
+				RleBpEncode(encoder->dictionary_indexes.data() + index_start,
+				            encoder->page_index_ends[page_idx] - index_start, bit_width, temp_writer);
+			} else {
+				auto plain_start = page_idx == 0 ? 0 : encoder->page_plain_ends[page_idx - 1];
+				temp_writer.WriteData(encoder->plain.blob.data.get() + plain_start,
+				                      encoder->page_plain_ends[page_idx] - plain_start);
+			}
+			auto page_offset = data.blob.size;
+			WritePage(hdr, temp_writer, codec, *data_protocol, data);
+
+			duckdb_parquet::format::PageLocation page_location;
+			page_location.offset = page_offset;
+			page_location.compressed_page_size = data.blob.size - page_offset;
+			page_location.first_row_index = row_start;
+			offset_index.page_locations.push_back(page_location);
+
+			column_index.null_pages.push_back((idx_t)page_null_counts[page_idx] == row_count);
+			column_index.min_values.push_back(encoder->page_min_values[page_idx]);
+			column_index.max_values.push_back(encoder->page_max_values[page_idx]);
 		}
 
-		hdr.compressed_page_size = compressed_size;
-		// now finally write the data to the actual file
-		hdr.write(protocol.get());
-		writer->WriteData(compressed_data, compressed_size);
+		for (idx_t page_idx = 0; page_idx < column_index.null_pages.size(); page_idx++) {
+			if (!column_index.null_pages[page_idx] && column_index.min_values[page_idx].empty() &&
+			    sql_types[i].id() != LogicalTypeId::VARCHAR && sql_types[i].id() != LogicalTypeId::BLOB) {
+				// a page that only contains NaN values, or a column without statistics (INT96) has no min/max: we
+				// cannot write a column index
+				column_index = duckdb_parquet::format::ColumnIndex();
+				break;
+			}
+		}
 
-		auto &column_chunk = row_group.columns[i];
-		column_chunk.__isset.meta_data = true;
-		column_chunk.meta_data.data_page_offset = start_offset;
-		column_chunk.meta_data.total_compressed_size = writer->GetTotalWritten() - start_offset;
+		column_chunk.meta_data.total_compressed_size = data.blob.size - start_offset;
 		column_chunk.meta_data.codec = codec;
+		column_chunk.meta_data.encodings.push_back(Encoding::PLAIN);
+		column_chunk.meta_data.encodings.push_back(Encoding::RLE);
+		if (use_dictionary) {
+			column_chunk.meta_data.encodings.push_back(Encoding::RLE_DICTIONARY);
+		}
 		column_chunk.meta_data.path_in_schema.push_back(file_meta_data.schema[i + 1].name);
 		column_chunk.meta_data.num_values = buffer.Count();
 		column_chunk.meta_data.type = file_meta_data.schema[i + 1].type;
 	}
 	row_group.num_rows += buffer.Count();
+}
+
+void ParquetWriter::FlushRowGroup(PreparedRowGroup &prepared) {
+	lock_guard<mutex> glock(lock);
+	auto &row_group = prepared.row_group;
+
+	// the row group is written at the current end of the file: move the offsets there
+	auto file_offset = writer->GetTotalWritten();
+	row_group.file_offset = file_offset;
+	for (auto &column_chunk : row_group.columns) {
+		column_chunk.meta_data.data_page_offset += file_offset;
+		if (column_chunk.meta_data.__isset.dictionary_page_offset) {
+			column_chunk.meta_data.dictionary_page_offset += file_offset;
+		}
+	}
+	for (auto &offset_index : prepared.offset_indexes) {
+		for (auto &page_location : offset_index.page_locations) {
+			page_location.offset += file_offset;
+		}
+	}
+	writer->WriteData(prepared.data.blob.data.get(), prepared.data.blob.size);
 
 	// append the row group to the file meta data
 	file_meta_data.row_groups.push_back(row_group);
-	file_meta_data.num_rows += buffer.Count();
+	file_meta_data.num_rows += row_group.num_rows;
+	column_indexes.push_back(move(prepared.column_indexes));
+	offset_indexes.push_back(move(prepared.offset_indexes));
 }
 
 void ParquetWriter::Finalize() {
+	// the page index is written after the row groups: first the column indexes, then the offset indexes
+	D_ASSERT(column_indexes.size() == file_meta_data.row_groups.size());
+	for (idx_t group_idx = 0; group_idx < file_meta_data.row_groups.size(); group_idx++) {
+		auto &columns = file_meta_data.row_groups[group_idx].columns;
+		for (idx_t col_idx = 0; col_idx < columns.size(); col_idx++) {
+			auto &column_index = column_indexes[group_idx][col_idx];
+			if (column_index.null_pages.empty()) {
+				// this column chunk has no column index
+				continue;
+			}
+			auto index_offset = writer->GetTotalWritten();
+			column_index.write(protocol.get());
+			columns[col_idx].__set_column_index_offset(index_offset);
+			columns[col_idx].__set_column_index_length(writer->GetTotalWritten() - index_offset);
+		}
+	}
+	for (idx_t group_idx = 0; group_idx < file_meta_data.row_groups.size(); group_idx++) {
+		auto &columns = file_meta_data.row_groups[group_idx].columns;
+		for (idx_t col_idx = 0; col_idx < columns.size(); col_idx++) {
+			auto index_offset = writer->GetTotalWritten();
+			offset_indexes[group_idx][col_idx].write(protocol.get());
+			columns[col_idx].__set_offset_index_offset(index_offset);
+			columns[col_idx].__set_offset_index_length(writer->GetTotalWritten() - index_offset);
+		}
+	}
+
 	auto start_offset = writer->GetTotalWritten();
 	file_meta_data.write(protocol.get());
 
@@ -62,10 +62,16 @@ TableCatalogEntry::TableCatalogEntry(Catalog *catalog, SchemaCatalogEntry *schem
 		name_map["rowid"] = COLUMN_IDENTIFIER_ROW_ID;
 	}
 	if (!storage) {
+		// the indexes that were persisted in the last checkpoint (if any)
+		vector<BlockPointer> index_pointers;
+		if (info->data) {
+			index_pointers = move(info->data->indexes);
+		}
 		// create the physical storage
 		storage = make_shared<DataTable>(catalog->db, schema->name, name, GetTypes(), move(info->data));
 
 		// create the unique indexes for the UNIQUE and PRIMARY KEY constraints
+		idx_t unique_index = 0;
 		for (idx_t i = 0; i < bound_constraints.size(); i++) {
 			auto &constraint = bound_constraints[i];
 			if (constraint->type == ConstraintType::UNIQUE) {
@@ -87,7 +93,14 @@ TableCatalogEntry::TableCatalogEntry(Catalog *catalog, SchemaCatalogEntry *schem
 				}
 				// create an adaptive radix tree around the expressions
 				auto art = make_unique<ART>(column_ids, move(unbound_expressions), true, unique.is_primary_key);
-				storage->AddIndex(move(art), bound_expressions);
+				if (unique_index < index_pointers.size()) {
+					// the index was persisted: load it instead of rebuilding it from the table
+					art->Deserialize(catalog->db, index_pointers[unique_index]);
+					storage->info->indexes.AddIndex(move(art));
+				} else {
+					storage->AddIndex(move(art), bound_expressions);
+				}
+				unique_index++;
 			}
 		}
 	}
@@ -0,0 +1,44 @@
+#include "duckdb/common/enums/compression_type.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/string_util.hpp"
+
+namespace duckdb {
+
+string CompressionTypeToString(CompressionType type) {
+	switch (type) {
+	case CompressionType::COMPRESSION_AUTO:
+		return "Auto";
+	case CompressionType::COMPRESSION_UNCOMPRESSED:
+		return "Uncompressed";
+	case CompressionType::COMPRESSION_CONSTANT:
+		return "Constant";
+	case CompressionType::COMPRESSION_RLE:
+		return "RLE";
+	case CompressionType::COMPRESSION_BITPACKING:
+		return "BitPacking";
+	case CompressionType::COMPRESSION_DICTIONARY:
+		return "Dictionary";
+	}
+	return "INVALID"; // LCOV_EXCL_LINE
+}
+
+CompressionType CompressionTypeFromString(const string &str) {
+	auto compression = StringUtil::Lower(str);
+	if (compression == "auto") {
+		return CompressionType::COMPRESSION_AUTO;
+	} else if (compression == "uncompressed" || compression == "none") {
+		return CompressionType::COMPRESSION_UNCOMPRESSED;
+	} else if (compression == "rle") {
+		return CompressionType::COMPRESSION_RLE;
+	} else if (compression == "bitpacking") {
+		return CompressionType::COMPRESSION_BITPACKING;
+	} else if (compression == "dictionary") {
+		return CompressionType::COMPRESSION_DICTIONARY;
+	} else {
+		throw ParserException(
+		    "Unrecognized compression type '%s', expected auto, uncompressed, rle, bitpacking or dictionary", str);
+	}
+}
+
+} // namespace duckdb
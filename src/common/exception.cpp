@@ -7,16 +7,62 @@ namespace duckdb {
 
 Exception::Exception(const string &msg) : std::exception(), type(ExceptionType::INVALID) {
 	exception_message_ = msg;
+	raw_message_ = msg;
 }
 
 Exception::Exception(ExceptionType exception_type, const string &message) : std::exception(), type(exception_type) {
 	exception_message_ = ExceptionTypeToString(exception_type) + " Error: " + message;
+	raw_message_ = message;
 }
 
 const char *Exception::what() const noexcept {
 	return exception_message_.c_str();
 }
 
+const string &Exception::RawMessage() const {
+	return raw_message_;
+}
+
+void Exception::ThrowAsTypeWithMessage(ExceptionType type, const string &message) {
+	switch (type) {
+	case ExceptionType::INVALID:
+		throw Exception(message);
+	case ExceptionType::OUT_OF_RANGE:
+		throw OutOfRangeException(message);
+	case ExceptionType::CONVERSION:
+		throw ConversionException(message);
+	case ExceptionType::TRANSACTION:
+		throw TransactionException(message);
+	case ExceptionType::NOT_IMPLEMENTED:
+		throw NotImplementedException(message);
+	case ExceptionType::CATALOG:
+		throw CatalogException(message);
+	case ExceptionType::PARSER:
+		throw ParserException(message);
+	case ExceptionType::BINDER:
+		throw BinderException(message);
+	case ExceptionType::SYNTAX:
+		throw SyntaxException(message);
+	case ExceptionType::CONSTRAINT:
+		throw ConstraintException(message);
+	case ExceptionType::IO:
+		throw IOException(message);
+	case ExceptionType::SERIALIZATION:
+		throw SerializationException(message);
+	case ExceptionType::INTERRUPT:
+		throw InterruptException();
+	case ExceptionType::FATAL:
+		throw FatalException(message);
+	case ExceptionType::INTERNAL:
+		throw InternalException(message);
+	case ExceptionType::INVALID_INPUT:
+		throw InvalidInputException(message);
+	default:
+		// the remaining types have no exception class that is constructed from a plain message
+		throw Exception(type, message);
+	}
+}
+
 string Exception::ConstructMessageRecursive(const string &msg, vector<ExceptionFormatValue> &values) {
 	return ExceptionFormatValue::Format(msg, values);
 }
@@ -821,6 +821,33 @@ string FileSystem::GetHomeDirectory() {
 	return homedir;
 }
 
+//! A read that is executed when it is waited on
+class DeferredRead : public AsyncRead {
+public:
+	DeferredRead(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location)
+	    : handle(handle), buffer(buffer), nr_bytes(nr_bytes), location(location), finished(false) {
+	}
+
+	void Wait() override {
+		if (finished) {
+			return;
+		}
+		handle.file_system.Read(handle, buffer, nr_bytes, location);
+		finished = true;
+	}
+
+private:
+	FileHandle &handle;
+	void *buffer;
+	int64_t nr_bytes;
+	idx_t location;
+	bool finished;
+};
+
+unique_ptr<AsyncRead> FileSystem::ReadAsync(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
+	return make_unique<DeferredRead>(handle, buffer, nr_bytes, location);
+}
+
 bool FileSystem::CanSeek() {
 	return true;
 }
@@ -712,6 +712,7 @@ void RowDataCollection::Merge(RowDataCollection &other) {
 		temp.block_capacity = other.block_capacity;
 		temp.entry_size = other.entry_size;
 		temp.blocks = move(other.blocks);
+		temp.pinned_blocks = move(other.pinned_blocks);
 		other.count = 0;
 	}
 
@@ -722,6 +723,10 @@ void RowDataCollection::Merge(RowDataCollection &other) {
 	for (auto &block : temp.blocks) {
 		blocks.emplace_back(move(block));
 	}
+	// the pointers into the blocks of the other collection have to stay valid as well
+	for (auto &handle : temp.pinned_blocks) {
+		pinned_blocks.push_back(move(handle));
+	}
 }
 
 template <class T>
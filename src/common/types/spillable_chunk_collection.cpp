@@ -0,0 +1,71 @@
+#include "duckdb/common/types/spillable_chunk_collection.hpp"
+
+#include "duckdb/common/serializer/buffered_deserializer.hpp"
+#include "duckdb/common/serializer/buffered_serializer.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+
+namespace duckdb {
+
+SpillableChunkCollection::SpillableChunkCollection(BufferManager &buffer_manager)
+    : buffer_manager(buffer_manager), count(0), size_in_bytes(0) {
+}
+
+void SpillableChunkCollection::Append(DataChunk &chunk) {
+	if (chunk.size() == 0) {
+		return;
+	}
+	// serialize the chunk outside of the lock
+	BufferedSerializer serializer;
+	chunk.Serialize(serializer);
+	auto entry_size = sizeof(uint64_t) + serializer.blob.size;
+
+	lock_guard<mutex> append_lock(lock);
+	if (blocks.empty() || blocks.back().capacity - blocks.back().size < entry_size) {
+		// the entry does not fit in the last block: allocate a new block
+		SpillableBlock new_block;
+		new_block.capacity = MaxValue<idx_t>(Storage::BLOCK_SIZE, entry_size);
+		new_block.size = 0;
+		new_block.block = buffer_manager.RegisterMemory(new_block.capacity, false);
+		blocks.push_back(move(new_block));
+	}
+	auto &block = blocks.back();
+	auto handle = buffer_manager.Pin(block.block);
+	auto dataptr = handle->node->buffer + block.size;
+	// every entry is prefixed by its size
+	Store<uint64_t>(serializer.blob.size, dataptr);
+	memcpy(dataptr + sizeof(uint64_t), serializer.blob.data.get(), serializer.blob.size);
+	block.size += entry_size;
+
+	count += chunk.size();
+	size_in_bytes += entry_size;
+}
+
+bool SpillableChunkCollection::Scan(SpillableChunkScanState &state, DataChunk &result) {
+	while (state.block_index < blocks.size() && state.offset >= blocks[state.block_index].size) {
+		state.block_index++;
+		state.offset = 0;
+	}
+	if (state.block_index >= blocks.size()) {
+		return false;
+	}
+	auto &block = blocks[state.block_index];
+	auto handle = buffer_manager.Pin(block.block);
+	auto dataptr = handle->node->buffer + state.offset;
+	auto entry_size = Load<uint64_t>(dataptr);
+
+	BufferedDeserializer source(dataptr + sizeof(uint64_t), entry_size);
+	result.Destroy();
+	result.Deserialize(source);
+
+	state.offset += sizeof(uint64_t) + entry_size;
+	return true;
+}
+
+void SpillableChunkCollection::Reset() {
+	lock_guard<mutex> append_lock(lock);
+	blocks.clear();
+	count = 0;
+	size_in_bytes = 0;
+}
+
+} // namespace duckdb
@@ -1280,6 +1280,10 @@ void StringVector::AddHeapReference(Vector &vector, Vector &other) {
 		StringVector::AddHeapReference(vector, DictionaryVector::Child(other));
 		return;
 	}
+	if (vector.GetVectorType() == VectorType::DICTIONARY_VECTOR) {
+		StringVector::AddHeapReference(DictionaryVector::Child(vector), other);
+		return;
+	}
 	if (!other.auxiliary) {
 		return;
 	}
@@ -36,6 +36,15 @@ static inline void TightLoopHash(T *__restrict ldata, hash_t *__restrict result_
 	}
 }
 
+//! Hashes the entries of the dictionary of a dictionary vector
+template <class T>
+static inline void HashDictionary(Vector &input, Vector &dictionary_hashes) {
+	auto &child = DictionaryVector::Child(input);
+	TightLoopHash<false, T>(FlatVector::GetData<T>(child), FlatVector::GetData<hash_t>(dictionary_hashes), nullptr,
+	                        DictionaryVector::DictionarySize(input), &FlatVector::INCREMENTAL_SELECTION_VECTOR,
+	                        FlatVector::Validity(child));
+}
+
 template <bool HAS_RSEL, class T>
 static inline void TemplatedLoopHash(Vector &input, Vector &result, const SelectionVector *rsel, idx_t count) {
 	if (input.GetVectorType() == VectorType::CONSTANT_VECTOR) {
@@ -44,6 +53,18 @@ static inline void TemplatedLoopHash(Vector &input, Vector &result, const Select
 		auto ldata = ConstantVector::GetData<T>(input);
 		auto result_data = ConstantVector::GetData<hash_t>(result);
 		*result_data = HashOp::Operation(*ldata, ConstantVector::IsNull(input));
+	} else if (!HAS_RSEL && DictionaryVector::IsSmallDictionary(input, count)) {
+		// hash every dictionary entry only once
+		Vector dictionary_hashes(LogicalType::HASH, DictionaryVector::DictionarySize(input));
+		HashDictionary<T>(input, dictionary_hashes);
+
+		result.SetVectorType(VectorType::FLAT_VECTOR);
+		auto &sel = DictionaryVector::SelVector(input);
+		auto dictionary_data = FlatVector::GetData<hash_t>(dictionary_hashes);
+		auto result_data = FlatVector::GetData<hash_t>(result);
+		for (idx_t i = 0; i < count; i++) {
+			result_data[i] = dictionary_data[sel.get_index(i)];
+		}
 	} else {
 		result.SetVectorType(VectorType::FLAT_VECTOR);
 
@@ -262,6 +283,27 @@ void TemplatedLoopCombineHash(Vector &input, Vector &hashes, const SelectionVect
 
 		auto other_hash = HashOp::Operation(*ldata, ConstantVector::IsNull(input));
 		*hash_data = CombineHashScalar(*hash_data, other_hash);
+	} else if (!HAS_RSEL && DictionaryVector::IsSmallDictionary(input, count)) {
+		// hash every dictionary entry only once
+		Vector dictionary_hashes(LogicalType::HASH, DictionaryVector::DictionarySize(input));
+		HashDictionary<T>(input, dictionary_hashes);
+
+		auto &sel = DictionaryVector::SelVector(input);
+		auto dictionary_data = FlatVector::GetData<hash_t>(dictionary_hashes);
+		if (hashes.GetVectorType() == VectorType::CONSTANT_VECTOR) {
+			auto constant_hash = *ConstantVector::GetData<hash_t>(hashes);
+			hashes.SetVectorType(VectorType::FLAT_VECTOR);
+			auto hash_data = FlatVector::GetData<hash_t>(hashes);
+			for (idx_t i = 0; i < count; i++) {
+				hash_data[i] = CombineHashScalar(constant_hash, dictionary_data[sel.get_index(i)]);
+			}
+		} else {
+			D_ASSERT(hashes.GetVectorType() == VectorType::FLAT_VECTOR);
+			auto hash_data = FlatVector::GetData<hash_t>(hashes);
+			for (idx_t i = 0; i < count; i++) {
+				hash_data[i] = CombineHashScalar(hash_data[i], dictionary_data[sel.get_index(i)]);
+			}
+		}
 	} else {
 		VectorData idata;
 		input.Orrify(count, idata);
@@ -2,6 +2,7 @@
 
 #include "duckdb/common/algorithm.hpp"
 #include "duckdb/common/exception.hpp"
+#include "duckdb/common/prefetch.hpp"
 #include "duckdb/common/types/null_value.hpp"
 #include "duckdb/common/types/row_data_collection.hpp"
 #include "duckdb/common/row_operations/row_operations.hpp"
@@ -90,7 +91,8 @@ GroupedAggregateHashTable::GroupedAggregateHashTable(BufferManager &buffer_manag
 		payload_idx += aggr.child_count;
 	}
 	predicates.resize(layout.ColumnCount() - 1, ExpressionType::COMPARE_EQUAL);
-	string_heap = make_unique<RowDataCollection>(buffer_manager, (idx_t)Storage::BLOCK_SIZE, 1);
+	// the groups point into the string heap: its blocks have to stay pinned
+	string_heap = make_unique<RowDataCollection>(buffer_manager, (idx_t)Storage::BLOCK_SIZE, 1, true);
 }
 
 GroupedAggregateHashTable::~GroupedAggregateHashTable() {
@@ -191,6 +193,14 @@ idx_t GroupedAggregateHashTable::MaxCapacity() {
 	return max_pages * MinValue(max_tuples, (idx_t)Storage::BLOCK_SIZE / tuple_size);
 }
 
+idx_t GroupedAggregateHashTable::SizeInBytes() {
+	idx_t size = payload_hds.size() * Storage::BLOCK_SIZE;
+	if (hashes_hdl) {
+		size += hashes_hdl->node->size;
+	}
+	return size;
+}
+
 void GroupedAggregateHashTable::Verify() {
 #ifdef DEBUG
 	switch (entry_type) {
@@ -433,6 +443,12 @@ idx_t GroupedAggregateHashTable::FindOrCreateGroupsInternal(DataChunk &groups, V
 		idx_t need_compare_count = 0;
 		idx_t no_match_count = 0;
 
+		// the entries are accessed in random order: issue the loads for all of them before looking at any of them
+		for (idx_t i = 0; i < remaining_entries; i++) {
+			const idx_t index = sel_vector->get_index(i);
+			PrefetchAddress(((ENTRY *)this->hashes_hdl_ptr) + ht_offsets_ptr[index]);
+		}
+
 		// first figure out for each remaining whether or not it belongs to a full or empty group
 		for (idx_t i = 0; i < remaining_entries; i++) {
 			const idx_t index = sel_vector->get_index(i);
@@ -467,16 +483,19 @@ idx_t GroupedAggregateHashTable::FindOrCreateGroupsInternal(DataChunk &groups, V
 			} else {
 				// cell is occupied: add to check list
 				// only need to check if hash salt in ptr == prefix of hash in payload
-				if (ht_entry_ptr->salt == hash_salts_ptr[index]) {
-					group_compare_vector.set_index(need_compare_count++, index);
-
-					auto page_ptr = payload_hds_ptrs[ht_entry_ptr->page_nr - 1];
-					auto page_offset = ht_entry_ptr->page_offset * tuple_size;
-					addresses_ptr[index] = page_ptr + page_offset;
-
-				} else {
-					no_match_vector.set_index(no_match_count++, index);
-				}
+				// whether the salt matches is unpredictable, so both lists are written and only one of them grows
+				const bool salt_match = ht_entry_ptr->salt == hash_salts_ptr[index];
+				group_compare_vector.set_index(need_compare_count, index);
+				no_match_vector.set_index(no_match_count, index);
+				need_compare_count += salt_match;
+				no_match_count += !salt_match;
+
+				auto page_ptr = payload_hds_ptrs[ht_entry_ptr->page_nr - 1];
+				auto page_offset = ht_entry_ptr->page_offset * tuple_size;
+				addresses_ptr[index] = page_ptr + page_offset;
+				// the groups of the matching rows are compared below: start loading them. For the other rows the load
+				// is wasted, which is cheaper than branching on the salt
+				PrefetchAddress(addresses_ptr[index]);
 			}
 		}
 
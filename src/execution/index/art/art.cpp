@@ -2,15 +2,20 @@
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/common/bit_operations.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/meta_block_reader.hpp"
+#include "duckdb/storage/meta_block_writer.hpp"
 #include <algorithm>
 #include <ctgmath>
 #include <cstring>
+#include <iterator>
 
 namespace duckdb {
 
 ART::ART(const vector<column_t> &column_ids, const vector<unique_ptr<Expression>> &unbound_expressions, bool is_unique,
          bool is_primary)
-    : Index(IndexType::ART, column_ids, unbound_expressions, is_unique, is_primary) {
+    : Index(IndexType::ART, column_ids, unbound_expressions, is_unique, is_primary), db(nullptr), loaded_memory(0),
+      compacted_blocks(0) {
 	tree = nullptr;
 	expression_result.Initialize(logical_types);
 	is_little_endian = IsLittleEndian();
@@ -36,6 +41,18 @@ ART::ART(const vector<column_t> &column_ids, const vector<unique_ptr<Expression>
 ART::~ART() {
 }
 
+void ART::InitializeTree() {
+	if (db && loaded_memory > 0) {
+		auto &buffer_manager = BufferManager::GetBufferManager(*db);
+		if (buffer_manager.GetUsedMemory() + loaded_memory > buffer_manager.GetMaxMemory()) {
+			// the loaded nodes exceed the memory limit: release all nodes that can be loaded from disk again
+			Node::Swizzle(*this, tree);
+			loaded_memory = 0;
+		}
+	}
+	Node::Unswizzle(*this, tree);
+}
+
 bool ART::LeafMatches(Node *node, Key &key, unsigned depth) {
 	auto leaf = static_cast<Leaf *>(node);
 	Key &leaf_key = *leaf->value;
@@ -206,6 +223,7 @@ bool ART::Insert(IndexLock &lock, DataChunk &input, Vector &row_ids) {
 	vector<unique_ptr<Key>> keys;
 	GenerateKeys(input, keys);
 
+	InitializeTree();
 	// now insert the elements into the index
 	row_ids.Normalify(input.size());
 	auto row_identifiers = FlatVector::GetData<row_t>(row_ids);
@@ -270,6 +288,7 @@ void ART::VerifyAppend(DataChunk &chunk) {
 	vector<unique_ptr<Key>> keys;
 	GenerateKeys(expression_result, keys);
 
+	InitializeTree();
 	for (idx_t i = 0; i < chunk.size(); i++) {
 		if (!keys[i]) {
 			continue;
@@ -304,6 +323,7 @@ bool ART::Insert(unique_ptr<Node> &node, unique_ptr<Key> value, unsigned depth,
 		node = make_unique<Leaf>(*this, move(value), row_id);
 		return true;
 	}
+	node->SetModified();
 
 	if (node->type == NodeType::NLeaf) {
 		// Replace leaf with Node4 and store both leaves in it
@@ -357,7 +377,7 @@ bool ART::Insert(unique_ptr<Node> &node, unique_ptr<Key> value, unsigned depth,
 	// Recurse
 	idx_t pos = node->GetChildPos(key[depth]);
 	if (pos != INVALID_INDEX) {
-		auto child = node->GetChild(pos);
+		auto child = node->GetChild(*this, pos);
 		return Insert(*child, move(value), depth + 1, row_id);
 	}
 	unique_ptr<Node> new_node = make_unique<Leaf>(*this, move(value), row_id);
@@ -365,6 +385,143 @@ bool ART::Insert(unique_ptr<Node> &node, unique_ptr<Key> value, unsigned depth,
 	return true;
 }
 
+//===--------------------------------------------------------------------===//
+// Bulk Construction
+//===--------------------------------------------------------------------===//
+static bool ARTBuildEntryLessThan(const ARTBuildEntry &a, const ARTBuildEntry &b) {
+	if (*a.key < *b.key) {
+		return true;
+	}
+	if (*b.key < *a.key) {
+		return false;
+	}
+	return a.row_id < b.row_id;
+}
+
+unique_ptr<IndexBuildState> ART::InitializeBuild() {
+	return make_unique<ARTBuildState>();
+}
+
+void ART::BuildAppend(IndexBuildState &state_p, DataChunk &input, Vector &row_ids) {
+	auto &state = (ARTBuildState &)state_p;
+	D_ASSERT(row_ids.GetType().InternalType() == ROW_TYPE);
+
+	vector<unique_ptr<Key>> keys;
+	GenerateKeys(input, keys);
+
+	row_ids.Normalify(input.size());
+	auto row_identifiers = FlatVector::GetData<row_t>(row_ids);
+	for (idx_t i = 0; i < input.size(); i++) {
+		if (!keys[i]) {
+			continue;
+		}
+		ARTBuildEntry entry;
+		entry.key = move(keys[i]);
+		entry.row_id = row_identifiers[i];
+		state.entries.push_back(move(entry));
+	}
+}
+
+void ART::FinishBuild(IndexBuildState &state_p) {
+	auto &state = (ARTBuildState &)state_p;
+	std::sort(state.entries.begin(), state.entries.end(), ARTBuildEntryLessThan);
+}
+
+bool ART::Build(IndexLock &lock, vector<unique_ptr<IndexBuildState>> &states) {
+	D_ASSERT(!tree);
+	// merge the sorted runs of all build states pairwise until a single run is left
+	vector<vector<ARTBuildEntry>> runs;
+	for (auto &state : states) {
+		auto &entries = ((ARTBuildState &)*state).entries;
+		if (!entries.empty()) {
+			runs.push_back(move(entries));
+		}
+	}
+	states.clear();
+	if (runs.empty()) {
+		return true;
+	}
+	while (runs.size() > 1) {
+		vector<vector<ARTBuildEntry>> merged_runs;
+		for (idx_t i = 0; i < runs.size(); i += 2) {
+			if (i + 1 == runs.size()) {
+				merged_runs.push_back(move(runs[i]));
+				continue;
+			}
+			vector<ARTBuildEntry> merged;
+			merged.reserve(runs[i].size() + runs[i + 1].size());
+			std::merge(std::make_move_iterator(runs[i].begin()), std::make_move_iterator(runs[i].end()),
+			           std::make_move_iterator(runs[i + 1].begin()), std::make_move_iterator(runs[i + 1].end()),
+			           std::back_inserter(merged), ARTBuildEntryLessThan);
+			merged_runs.push_back(move(merged));
+		}
+		runs = move(merged_runs);
+	}
+	// construct the tree bottom-up from the sorted keys
+	if (!Construct(runs[0], 0, runs[0].size(), 0, tree)) {
+		tree.reset();
+		return false;
+	}
+	return true;
+}
+
+bool ART::Construct(vector<ARTBuildEntry> &entries, idx_t start, idx_t end, idx_t depth, unique_ptr<Node> &node) {
+	D_ASSERT(start < end);
+	auto &first_key = *entries[start].key;
+	auto &last_key = *entries[end - 1].key;
+	if (first_key == last_key) {
+		// all keys in the range are equal: they are stored in a single leaf
+		auto count = end - start;
+		if (is_unique && count > 1) {
+			return false;
+		}
+		auto row_ids = unique_ptr<row_t[]>(new row_t[count]);
+		for (idx_t i = start; i < end; i++) {
+			row_ids[i - start] = entries[i].row_id;
+		}
+		node = make_unique<Leaf>(*this, move(entries[start].key), move(row_ids), count);
+		return true;
+	}
+	// the keys are sorted: the prefix shared by all keys is the prefix shared by the first and the last key
+	uint32_t prefix_length = 0;
+	while (first_key[depth + prefix_length] == last_key[depth + prefix_length]) {
+		prefix_length++;
+		D_ASSERT(depth + prefix_length < first_key.len && depth + prefix_length < last_key.len);
+	}
+	auto key_depth = depth + prefix_length;
+
+	// every distinct byte after the prefix becomes a child, pick the smallest node that fits all of them
+	vector<idx_t> child_starts;
+	for (idx_t i = start; i < end; i++) {
+		if (i == start || (*entries[i].key)[key_depth] != (*entries[i - 1].key)[key_depth]) {
+			child_starts.push_back(i);
+		}
+	}
+	if (child_starts.size() <= 4) {
+		node = make_unique<Node4>(*this, prefix_length);
+	} else if (child_starts.size() <= 16) {
+		node = make_unique<Node16>(*this, prefix_length);
+	} else if (child_starts.size() <= 48) {
+		node = make_unique<Node48>(*this, prefix_length);
+	} else {
+		node = make_unique<Node256>(*this, prefix_length);
+	}
+	node->prefix_length = prefix_length;
+	memcpy(node->prefix.get(), &first_key[depth], prefix_length);
+
+	for (idx_t child_idx = 0; child_idx < child_starts.size(); child_idx++) {
+		auto child_start = child_starts[child_idx];
+		auto child_end = child_idx + 1 < child_starts.size() ? child_starts[child_idx + 1] : end;
+		auto key_byte = (*entries[child_start].key)[key_depth];
+		unique_ptr<Node> child;
+		if (!Construct(entries, child_start, child_end, key_depth + 1, child)) {
+			return false;
+		}
+		Node::InsertLeaf(*this, node, key_byte, child);
+	}
+	return true;
+}
+
 //===--------------------------------------------------------------------===//
 // Delete
 //===--------------------------------------------------------------------===//
@@ -379,6 +536,7 @@ void ART::Delete(IndexLock &state, DataChunk &input, Vector &row_ids) {
 	vector<unique_ptr<Key>> keys;
 	GenerateKeys(expression_result, keys);
 
+	InitializeTree();
 	// now erase the elements from the database
 	row_ids.Normalify(input.size());
 	auto row_identifiers = FlatVector::GetData<row_t>(row_ids);
@@ -404,6 +562,7 @@ void ART::Erase(unique_ptr<Node> &node, Key &key, unsigned depth, row_t row_id)
 	if (!node) {
 		return;
 	}
+	node->SetModified();
 	// Delete a leaf from a tree
 	if (node->type == NodeType::NLeaf) {
 		// Make sure we have the right leaf
@@ -426,13 +585,14 @@ void ART::Erase(unique_ptr<Node> &node, Key &key, unsigned depth, row_t row_id)
 	}
 	idx_t pos = node->GetChildPos(key[depth]);
 	if (pos != INVALID_INDEX) {
-		auto child = node->GetChild(pos);
+		auto child = node->GetChild(*this, pos);
 		D_ASSERT(child);
 
 		unique_ptr<Node> &child_ref = *child;
 		if (child_ref->type == NodeType::NLeaf && LeafMatches(child_ref.get(), key, depth)) {
 			// Leaf found, remove entry
 			auto leaf = static_cast<Leaf *>(child_ref.get());
+			leaf->SetModified();
 			leaf->Remove(row_id);
 			if (leaf->num_elements == 0) {
 				// Leaf is empty, delete leaf, decrement node counter and maybe shrink node
@@ -485,6 +645,7 @@ static unique_ptr<Key> CreateKey(ART &art, PhysicalType type, Value &value) {
 
 bool ART::SearchEqual(ARTIndexScanState *state, idx_t max_count, vector<row_t> &result_ids) {
 	auto key = CreateKey(*this, types[0], state->values[0]);
+	InitializeTree();
 	auto leaf = static_cast<Leaf *>(Lookup(tree, *key, 0));
 	if (!leaf) {
 		return true;
@@ -502,6 +663,7 @@ bool ART::SearchEqual(ARTIndexScanState *state, idx_t max_count, vector<row_t> &
 void ART::SearchEqualJoinNoFetch(Value &equal_value, idx_t &result_size) {
 	//! We need to look for a leaf
 	auto key = CreateKey(*this, types[0], equal_value);
+	InitializeTree();
 	auto leaf = static_cast<Leaf *>(Lookup(tree, *key, 0));
 	if (!leaf) {
 		return;
@@ -536,7 +698,7 @@ Node *ART::Lookup(unique_ptr<Node> &node, Key &key, unsigned depth) {
 		if (pos == INVALID_INDEX) {
 			return nullptr;
 		}
-		node_val = node_val->GetChild(pos)->get();
+		node_val = node_val->GetChild(*this, pos)->get();
 		D_ASSERT(node_val);
 
 		depth++;
@@ -605,7 +767,7 @@ bool ART::IteratorNext(Iterator &it) {
 		top.pos = node->GetNextPos(top.pos);
 		if (top.pos != INVALID_INDEX) {
 			// next node found: go there
-			it.SetEntry(it.depth, IteratorEntry(node->GetChild(top.pos)->get(), INVALID_INDEX));
+			it.SetEntry(it.depth, IteratorEntry(node->GetChild(*this, top.pos)->get(), INVALID_INDEX));
 			it.depth++;
 		} else {
 			// no node found: move up the tree
@@ -635,7 +797,7 @@ bool ART::Bound(unique_ptr<Node> &n, Key &key, Iterator &it, bool inclusive) {
 		it.depth++;
 		if (!equal) {
 			while (node->type != NodeType::NLeaf) {
-				node = node->GetChild(node->GetMin())->get();
+				node = node->GetChild(*this, node->GetMin())->get();
 				auto &c_top = it.stack[it.depth];
 				c_top.node = node;
 				it.depth++;
@@ -696,7 +858,7 @@ bool ART::Bound(unique_ptr<Node> &n, Key &key, Iterator &it, bool inclusive) {
 			// Find min leaf
 			top.pos = node->GetMin();
 		}
-		node = node->GetChild(top.pos)->get();
+		node = node->GetChild(*this, top.pos)->get();
 		//! This means all children of this node qualify as geq
 
 		depth++;
@@ -724,25 +886,17 @@ bool ART::SearchGreater(ARTIndexScanState *state, bool inclusive, idx_t max_coun
 //===--------------------------------------------------------------------===//
 // Less Than
 //===--------------------------------------------------------------------===//
-static Leaf &FindMinimum(Iterator &it, Node &node) {
-	Node *next = nullptr;
+static Leaf &FindMinimum(ART &art, Iterator &it, Node &node) {
 	idx_t pos = 0;
 	switch (node.type) {
 	case NodeType::NLeaf:
 		it.node = (Leaf *)&node;
 		return (Leaf &)node;
-	case NodeType::N4:
-		next = ((Node4 &)node).child[0].get();
-		break;
-	case NodeType::N16:
-		next = ((Node16 &)node).child[0].get();
-		break;
 	case NodeType::N48: {
 		auto &n48 = (Node48 &)node;
 		while (n48.child_index[pos] == Node::EMPTY_MARKER) {
 			pos++;
 		}
-		next = n48.child[n48.child_index[pos]].get();
 		break;
 	}
 	case NodeType::N256: {
@@ -750,13 +904,15 @@ static Leaf &FindMinimum(Iterator &it, Node &node) {
 		while (!n256.child[pos]) {
 			pos++;
 		}
-		next = n256.child[pos].get();
 		break;
 	}
+	default:
+		break;
 	}
+	auto next = node.GetChild(art, pos)->get();
 	it.SetEntry(it.depth, IteratorEntry(&node, pos));
 	it.depth++;
-	return FindMinimum(it, *next);
+	return FindMinimum(art, it, *next);
 }
 
 bool ART::SearchLess(ARTIndexScanState *state, bool inclusive, idx_t max_count, vector<row_t> &result_ids) {
@@ -769,7 +925,7 @@ bool ART::SearchLess(ARTIndexScanState *state, bool inclusive, idx_t max_count,
 
 	if (!it->start) {
 		// first find the minimum value in the ART: we start scanning from this value
-		auto &minimum = FindMinimum(state->iterator, *tree);
+		auto &minimum = FindMinimum(*this, state->iterator, *tree);
 		// early out min value higher than upper bound query
 		if (*minimum.value > *upper_bound) {
 			return true;
@@ -818,6 +974,7 @@ bool ART::Scan(Transaction &transaction, DataTable &table, IndexScanState &table
 	bool success = true;
 	if (state->values[1].is_null) {
 		lock_guard<mutex> l(lock);
+		InitializeTree();
 		// single predicate
 		switch (state->expressions[0]) {
 		case ExpressionType::COMPARE_EQUAL:
@@ -840,6 +997,7 @@ bool ART::Scan(Transaction &transaction, DataTable &table, IndexScanState &table
 		}
 	} else {
 		lock_guard<mutex> l(lock);
+		InitializeTree();
 		// two predicates
 		D_ASSERT(state->values[1].type().InternalType() == types[0]);
 		bool left_inclusive = state->expressions[0] == ExpressionType ::COMPARE_GREATERTHANOREQUALTO;
@@ -866,4 +1024,93 @@ bool ART::Scan(Transaction &transaction, DataTable &table, IndexScanState &table
 	return true;
 }
 
+//===--------------------------------------------------------------------===//
+// Serialization
+//===--------------------------------------------------------------------===//
+BlockPointer ART::Serialize(MetaBlockWriter &writer) {
+	lock_guard<mutex> l(lock);
+	db = &writer.db;
+	auto &block_manager = BlockManager::GetBlockManager(*db);
+	if (!tree) {
+		CommitDrop();
+		return Index::Serialize(writer);
+	}
+	BlockPointer root_pointer = tree->persistent_pointer;
+	if (root_pointer.block_id == INVALID_BLOCK) {
+		// the tree was modified: the nodes of unmodified subtrees remain in the blocks of earlier checkpoints, so the
+		// blocks of the index grow with every checkpoint. Once they have doubled, all nodes are written again and the
+		// old blocks are released.
+		bool rewrite = blocks.size() >= 2 * compacted_blocks;
+		// swizzled nodes are loaded while they are written, and swizzled again afterwards
+		// these do not count towards the memory of the loaded nodes
+		auto current_memory = loaded_memory;
+		MetaBlockWriter node_writer(*db);
+		root_pointer = tree->Serialize(*this, node_writer, rewrite);
+		node_writer.Flush();
+		loaded_memory = current_memory;
+		if (rewrite) {
+			for (auto &entry : blocks) {
+				block_manager.MarkBlockAsModified(entry.first);
+			}
+			blocks.clear();
+			compacted_blocks = node_writer.written_blocks.size();
+		}
+		for (auto &block_id : node_writer.written_blocks) {
+			blocks[block_id] = nullptr;
+		}
+	}
+	auto pointer = writer.GetBlockPointer();
+	writer.Write<block_id_t>(root_pointer.block_id);
+	writer.Write<uint32_t>(root_pointer.offset);
+	writer.Write<uint64_t>(compacted_blocks);
+	writer.Write<uint64_t>(blocks.size());
+	for (auto &entry : blocks) {
+		writer.Write<block_id_t>(entry.first);
+	}
+	return pointer;
+}
+
+void ART::Deserialize(DatabaseInstance &db, BlockPointer pointer) {
+	D_ASSERT(!tree);
+	if (pointer.block_id == INVALID_BLOCK) {
+		return;
+	}
+	this->db = &db;
+	MetaBlockReader reader(db, pointer.block_id);
+	reader.offset = pointer.offset;
+	BlockPointer root_pointer;
+	root_pointer.block_id = reader.Read<block_id_t>();
+	root_pointer.offset = reader.Read<uint32_t>();
+	compacted_blocks = reader.Read<uint64_t>();
+	auto block_count = reader.Read<uint64_t>();
+	for (idx_t i = 0; i < block_count; i++) {
+		blocks[reader.Read<block_id_t>()] = nullptr;
+	}
+	// only the root is loaded: the remaining nodes are loaded once they are accessed
+	tree = Node::Deserialize(*this, root_pointer);
+}
+
+void ART::CommitDrop() {
+	if (!db) {
+		return;
+	}
+	auto &block_manager = BlockManager::GetBlockManager(*db);
+	for (auto &entry : blocks) {
+		block_manager.MarkBlockAsModified(entry.first);
+	}
+	blocks.clear();
+	compacted_blocks = 0;
+}
+
+unique_ptr<BufferHandle> ART::PinBlock(block_id_t block_id) {
+	D_ASSERT(db);
+	D_ASSERT(blocks.find(block_id) != blocks.end());
+	auto &buffer_manager = BufferManager::GetBufferManager(*db);
+	auto &block = blocks[block_id];
+	if (!block) {
+		block = buffer_manager.RegisterBlock(block_id);
+	}
+	return buffer_manager.Pin(block);
+}
+
 } // namespace duckdb
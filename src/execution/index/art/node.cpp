@@ -1,11 +1,17 @@
 #include "duckdb/execution/index/art/node.hpp"
 #include "duckdb/execution/index/art/art.hpp"
 #include "duckdb/common/exception.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/meta_block_writer.hpp"
+
+#include <cstring>
 
 namespace duckdb {
 
 Node::Node(ART &art, NodeType type, size_t compressed_prefix_size) : prefix_length(0), count(0), type(type) {
 	this->prefix = unique_ptr<uint8_t[]>(new uint8_t[compressed_prefix_size]);
+	this->persistent_pointer.block_id = INVALID_BLOCK;
+	this->persistent_pointer.offset = 0;
 }
 
 void Node::CopyPrefix(ART &art, Node *src, Node *dst) {
@@ -13,7 +19,7 @@ void Node::CopyPrefix(ART &art, Node *src, Node *dst) {
 	memcpy(dst->prefix.get(), src->prefix.get(), src->prefix_length);
 }
 
-unique_ptr<Node> *Node::GetChild(idx_t pos) {
+unique_ptr<Node> *Node::GetChild(ART &art, idx_t pos) {
 	D_ASSERT(0);
 	return nullptr;
 }
@@ -75,4 +81,236 @@ void Node::Erase(ART &art, unique_ptr<Node> &node, idx_t pos) {
 	}
 }
 
+//===--------------------------------------------------------------------===//
+// Serialization
+//===--------------------------------------------------------------------===//
+//! Returns the child at the given position without loading it if it is swizzled
+static unique_ptr<Node> &GetChildReference(Node &node, idx_t pos) {
+	switch (node.type) {
+	case NodeType::N4:
+		return ((Node4 &)node).child[pos];
+	case NodeType::N16:
+		return ((Node16 &)node).child[pos];
+	case NodeType::N48: {
+		auto &n48 = (Node48 &)node;
+		return n48.child[n48.child_index[pos]];
+	}
+	case NodeType::N256:
+		return ((Node256 &)node).child[pos];
+	default:
+		throw InternalException("Node type does not have children");
+	}
+}
+
+BlockPointer Node::Serialize(ART &art, MetaBlockWriter &writer, bool rewrite) {
+	if (!rewrite && persistent_pointer.block_id != INVALID_BLOCK) {
+		return persistent_pointer;
+	}
+	if (type == NodeType::NLeaf) {
+		auto leaf = (Leaf *)this;
+		auto pointer = writer.GetBlockPointer();
+		writer.Write<uint8_t>((uint8_t)type);
+		writer.Write<uint32_t>(prefix_length);
+		writer.WriteData(prefix.get(), prefix_length);
+		writer.Write<uint64_t>(leaf->value->len);
+		writer.WriteData(leaf->value->data.get(), leaf->value->len);
+		writer.Write<uint64_t>(leaf->num_elements);
+		writer.WriteData((const_data_ptr_t)leaf->GetRowIds(), leaf->num_elements * sizeof(row_t));
+		persistent_pointer = pointer;
+		return pointer;
+	}
+	// serialize the children first, so the pointers to them are known
+	vector<uint8_t> child_keys;
+	vector<BlockPointer> child_pointers;
+	for (idx_t pos = GetNextPos(INVALID_INDEX); pos != INVALID_INDEX; pos = GetNextPos(pos)) {
+		switch (type) {
+		case NodeType::N4:
+			child_keys.push_back(((Node4 *)this)->key[pos]);
+			break;
+		case NodeType::N16:
+			child_keys.push_back(((Node16 *)this)->key[pos]);
+			break;
+		default:
+			// the position in a Node48 or Node256 is the key byte
+			child_keys.push_back((uint8_t)pos);
+			break;
+		}
+		auto &child = GetChildReference(*this, pos);
+		if (!rewrite || child->type != NodeType::NSwizzled) {
+			child_pointers.push_back(child->Serialize(art, writer, rewrite));
+			continue;
+		}
+		// the whole tree is rewritten: swizzled children are loaded, written and swizzled again, now pointing to
+		// their new location
+		auto child_pointer = (*GetChild(art, pos))->Serialize(art, writer, rewrite);
+		Swizzle(art, child);
+		child_pointers.push_back(child_pointer);
+	}
+	D_ASSERT(child_pointers.size() == count);
+
+	auto pointer = writer.GetBlockPointer();
+	writer.Write<uint8_t>((uint8_t)type);
+	writer.Write<uint32_t>(prefix_length);
+	writer.WriteData(prefix.get(), prefix_length);
+	writer.Write<uint16_t>(count);
+	for (idx_t i = 0; i < child_pointers.size(); i++) {
+		writer.Write<uint8_t>(child_keys[i]);
+		writer.Write<block_id_t>(child_pointers[i].block_id);
+		writer.Write<uint32_t>(child_pointers[i].offset);
+	}
+	persistent_pointer = pointer;
+	return pointer;
+}
+
+static unique_ptr<Node> CreateSwizzledNode(ART &art, BlockPointer pointer) {
+	auto result = make_unique<Node>(art, NodeType::NSwizzled, 0);
+	result->persistent_pointer = pointer;
+	return result;
+}
+
+//! Reads a node from the blocks of the index. Unlike a MetaBlockReader, the blocks are pinned through the handles
+//! kept by the ART, and they are not marked as modified: unmodified nodes are not rewritten in the next checkpoint.
+class NodeReader : public Deserializer {
+public:
+	NodeReader(ART &art, BlockPointer pointer) : art(art) {
+		ReadNewBlock(pointer.block_id);
+		offset = pointer.offset;
+	}
+
+	void ReadData(data_ptr_t buffer, idx_t read_size) override {
+		while (offset + read_size > handle->node->size) {
+			// the node continues in the next block
+			idx_t to_read = handle->node->size - offset;
+			if (to_read > 0) {
+				memcpy(buffer, handle->node->buffer + offset, to_read);
+				read_size -= to_read;
+				buffer += to_read;
+			}
+			ReadNewBlock(next_block);
+		}
+		memcpy(buffer, handle->node->buffer + offset, read_size);
+		offset += read_size;
+	}
+
+private:
+	void ReadNewBlock(block_id_t block_id) {
+		handle = art.PinBlock(block_id);
+		next_block = Load<block_id_t>(handle->node->buffer);
+		offset = sizeof(block_id_t);
+	}
+
+	ART &art;
+	unique_ptr<BufferHandle> handle;
+	idx_t offset;
+	block_id_t next_block;
+};
+
+unique_ptr<Node> Node::Deserialize(ART &art, BlockPointer pointer) {
+	NodeReader reader(art, pointer);
+	auto node_type = (NodeType)reader.Read<uint8_t>();
+	auto prefix_length = reader.Read<uint32_t>();
+	auto prefix = unique_ptr<uint8_t[]>(new uint8_t[prefix_length]);
+	reader.ReadData(prefix.get(), prefix_length);
+
+	unique_ptr<Node> result;
+	idx_t memory_size = prefix_length;
+	if (node_type == NodeType::NLeaf) {
+		auto key_length = reader.Read<uint64_t>();
+		auto key_data = unique_ptr<data_t[]>(new data_t[key_length]);
+		reader.ReadData(key_data.get(), key_length);
+		auto num_elements = reader.Read<uint64_t>();
+		auto row_ids = unique_ptr<row_t[]>(new row_t[num_elements]);
+		reader.ReadData((data_ptr_t)row_ids.get(), num_elements * sizeof(row_t));
+		result = make_unique<Leaf>(art, make_unique<Key>(move(key_data), key_length), move(row_ids), num_elements);
+		memory_size += sizeof(Leaf) + sizeof(Key) + key_length + num_elements * sizeof(row_t);
+	} else {
+		// the children are not loaded yet: they are swizzled until they are accessed
+		auto child_count = reader.Read<uint16_t>();
+		vector<uint8_t> child_keys;
+		vector<BlockPointer> child_pointers;
+		for (idx_t i = 0; i < child_count; i++) {
+			child_keys.push_back(reader.Read<uint8_t>());
+			BlockPointer child_pointer;
+			child_pointer.block_id = reader.Read<block_id_t>();
+			child_pointer.offset = reader.Read<uint32_t>();
+			child_pointers.push_back(child_pointer);
+		}
+		switch (node_type) {
+		case NodeType::N4: {
+			auto node = make_unique<Node4>(art, prefix_length);
+			for (idx_t i = 0; i < child_count; i++) {
+				node->key[i] = child_keys[i];
+				node->child[i] = CreateSwizzledNode(art, child_pointers[i]);
+			}
+			result = move(node);
+			memory_size += sizeof(Node4);
+			break;
+		}
+		case NodeType::N16: {
+			auto node = make_unique<Node16>(art, prefix_length);
+			for (idx_t i = 0; i < child_count; i++) {
+				node->key[i] = child_keys[i];
+				node->child[i] = CreateSwizzledNode(art, child_pointers[i]);
+			}
+			result = move(node);
+			memory_size += sizeof(Node16);
+			break;
+		}
+		case NodeType::N48: {
+			auto node = make_unique<Node48>(art, prefix_length);
+			for (idx_t i = 0; i < child_count; i++) {
+				node->child_index[child_keys[i]] = i;
+				node->child[i] = CreateSwizzledNode(art, child_pointers[i]);
+			}
+			result = move(node);
+			memory_size += sizeof(Node48);
+			break;
+		}
+		case NodeType::N256: {
+			auto node = make_unique<Node256>(art, prefix_length);
+			for (idx_t i = 0; i < child_count; i++) {
+				node->child[child_keys[i]] = CreateSwizzledNode(art, child_pointers[i]);
+			}
+			result = move(node);
+			memory_size += sizeof(Node256);
+			break;
+		}
+		default:
+			throw InternalException("Unrecognized ART node type in Node::Deserialize");
+		}
+		result->count = child_count;
+		memory_size += child_count * sizeof(Node);
+	}
+	result->prefix_length = prefix_length;
+	result->prefix = move(prefix);
+	result->persistent_pointer = pointer;
+	art.loaded_memory += memory_size;
+	return result;
+}
+
+unique_ptr<Node> *Node::Unswizzle(ART &art, unique_ptr<Node> &node) {
+	if (node && node->type == NodeType::NSwizzled) {
+		node = Deserialize(art, node->persistent_pointer);
+	}
+	return &node;
+}
+
+void Node::Swizzle(ART &art, unique_ptr<Node> &node) {
+	if (!node || node->type == NodeType::NSwizzled) {
+		return;
+	}
+	if (node->persistent_pointer.block_id != INVALID_BLOCK) {
+		// the subtree has not been modified since it was loaded or written: release it
+		node = CreateSwizzledNode(art, node->persistent_pointer);
+		return;
+	}
+	if (node->type == NodeType::NLeaf) {
+		return;
+	}
+	// the node itself was modified, but (some of) its children might not be
+	for (idx_t pos = node->GetNextPos(INVALID_INDEX); pos != INVALID_INDEX; pos = node->GetNextPos(pos)) {
+		Swizzle(art, GetChildReference(*node, pos));
+	}
+}
+
 } // namespace duckdb
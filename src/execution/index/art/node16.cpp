@@ -43,9 +43,9 @@ idx_t Node16::GetNextPos(idx_t pos) {
 	return pos < count ? pos : INVALID_INDEX;
 }
 
-unique_ptr<Node> *Node16::GetChild(idx_t pos) {
+unique_ptr<Node> *Node16::GetChild(ART &art, idx_t pos) {
 	D_ASSERT(pos < count);
-	return &child[pos];
+	return Node::Unswizzle(art, child[pos]);
 }
 
 idx_t Node16::GetMin() {
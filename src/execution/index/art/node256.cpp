@@ -46,9 +46,9 @@ idx_t Node256::GetNextPos(idx_t pos) {
 	return Node::GetNextPos(pos);
 }
 
-unique_ptr<Node> *Node256::GetChild(idx_t pos) {
+unique_ptr<Node> *Node256::GetChild(ART &art, idx_t pos) {
 	D_ASSERT(child[pos]);
-	return &child[pos];
+	return Node::Unswizzle(art, child[pos]);
 }
 
 void Node256::Insert(ART &art, unique_ptr<Node> &node, uint8_t key_byte, unique_ptr<Node> &child) {
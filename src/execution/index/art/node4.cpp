@@ -43,9 +43,9 @@ idx_t Node4::GetNextPos(idx_t pos) {
 	return pos < count ? pos : INVALID_INDEX;
 }
 
-unique_ptr<Node> *Node4::GetChild(idx_t pos) {
+unique_ptr<Node> *Node4::GetChild(ART &art, idx_t pos) {
 	D_ASSERT(pos < count);
-	return &child[pos];
+	return Node::Unswizzle(art, child[pos]);
 }
 
 void Node4::Insert(ART &art, unique_ptr<Node> &node, uint8_t key_byte, unique_ptr<Node> &child) {
@@ -96,7 +96,9 @@ void Node4::Erase(ART &art, unique_ptr<Node> &node, int pos) {
 
 	// This is a one way node
 	if (n->count == 1) {
-		auto childref = n->child[0].get();
+		// the prefix of the child is changed: it has to be loaded and can no longer be swizzled
+		auto childref = n->GetChild(art, 0)->get();
+		childref->SetModified();
 		//! concatenate prefixes
 		auto new_length = node->prefix_length + childref->prefix_length + 1;
 		//! have to allocate space in our prefix array
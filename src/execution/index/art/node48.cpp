@@ -41,9 +41,9 @@ idx_t Node48::GetNextPos(idx_t pos) {
 	return Node::GetNextPos(pos);
 }
 
-unique_ptr<Node> *Node48::GetChild(idx_t pos) {
+unique_ptr<Node> *Node48::GetChild(ART &art, idx_t pos) {
 	D_ASSERT(child_index[pos] != Node::EMPTY_MARKER);
-	return &child[child_index[pos]];
+	return Node::Unswizzle(art, child[child_index[pos]]);
 }
 
 idx_t Node48::GetMin() {
@@ -2,6 +2,7 @@
 
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/operator/comparison_operators.hpp"
+#include "duckdb/common/prefetch.hpp"
 #include "duckdb/common/row_operations/row_operations.hpp"
 #include "duckdb/common/types/null_value.hpp"
 #include "duckdb/common/types/row_data_collection.hpp"
@@ -16,7 +17,8 @@ using ScanStructure = JoinHashTable::ScanStructure;
 JoinHashTable::JoinHashTable(BufferManager &buffer_manager, vector<JoinCondition> &conditions,
                              vector<LogicalType> btypes, JoinType type)
     : buffer_manager(buffer_manager), build_types(move(btypes)), entry_size(0), tuple_size(0),
-      vfound(Value::BOOLEAN(false)), join_type(type), finalized(false), has_null(false), count(0) {
+      vfound(Value::BOOLEAN(false)), join_type(type), finalized(false), has_null(false), count(0), total_count(0),
+      active_builders(0), external(false), current_partition(0) {
 	for (auto &condition : conditions) {
 		D_ASSERT(condition.left->return_type == condition.right->return_type);
 		auto type = condition.left->return_type;
@@ -55,7 +57,8 @@ JoinHashTable::JoinHashTable(BufferManager &buffer_manager, vector<JoinCondition
 
 	// compute the per-block capacity of this HT
 	block_capacity = MaxValue<idx_t>(STANDARD_VECTOR_SIZE, (Storage::BLOCK_SIZE / entry_size) + 1);
-	string_heap = make_unique<RowDataCollection>(buffer_manager, (idx_t)Storage::BLOCK_SIZE, 1);
+	// the entries of the HT point into the string heap, so the heap has to stay pinned
+	string_heap = make_unique<RowDataCollection>(buffer_manager, (idx_t)Storage::BLOCK_SIZE, 1, true);
 }
 
 JoinHashTable::~JoinHashTable() {
@@ -190,13 +193,46 @@ void JoinHashTable::Build(DataChunk &keys, DataChunk &payload) {
 		return;
 	}
 
+	// hash the keys and obtain an entry in the list
+	// note that we only hash the keys used in the equality comparison
+	Vector hash_values(LogicalType::HASH);
+	Hash(keys, *current_sel, added_count, hash_values);
+
+	if (!AppendRows(keys, key_data, payload, hash_values, *current_sel, added_count, true)) {
+		// the HT has been partitioned: append the rows to the build partitions instead
+		DataChunk rows;
+		rows.InitializeEmpty(keys.GetTypes());
+		for (idx_t i = 0; i < keys.ColumnCount(); i++) {
+			rows.data[i].Reference(keys.data[i]);
+		}
+		for (idx_t i = 0; i < payload.ColumnCount(); i++) {
+			rows.data.emplace_back(payload.data[i]);
+		}
+		rows.data.emplace_back(hash_values);
+		rows.SetCardinality(keys);
+		AppendToPartitions(rows, hash_values, *current_sel, added_count, build_partitions);
+	}
+}
+
+bool JoinHashTable::AppendRows(DataChunk &keys, unique_ptr<VectorData[]> &key_data, DataChunk &payload,
+                               Vector &hash_values, const SelectionVector &sel, idx_t added_count, bool check_memory) {
 	vector<unique_ptr<BufferHandle>> handles;
 	vector<BlockAppendEntry> append_entries;
 	// first allocate space of where to serialize the keys and payload columns
 	idx_t remaining = added_count;
 	{
 		// first append to the last block (if any)
-		lock_guard<mutex> append_lock(ht_lock);
+		unique_lock<mutex> append_lock(ht_lock);
+		if (check_memory) {
+			if (!external && ExceedsMemoryBudget(added_count)) {
+				// the build side does not fit in memory: partition the HT
+				PartitionBuildSide(append_lock);
+			}
+			if (external) {
+				return false;
+			}
+		}
+		active_builders++;
 		count += added_count;
 
 		if (!blocks.empty()) {
@@ -235,17 +271,12 @@ void JoinHashTable::Build(DataChunk &keys, DataChunk &payload) {
 		idx_t next = append_idx + append_entry.count;
 		for (; append_idx < next; append_idx++) {
 			// Set the validity mask (clearing is less common)
-			auto idx = current_sel->get_index(append_idx);
+			auto idx = sel.get_index(append_idx);
 			key_locations[idx] = append_entry.baseptr;
 			append_entry.baseptr += entry_size;
 		}
 	}
 
-	// hash the keys and obtain an entry in the list
-	// note that we only hash the keys used in the equality comparison
-	Vector hash_values(LogicalType::HASH);
-	Hash(keys, *current_sel, added_count, hash_values);
-
 	// build a chunk so we can handle nested types that need more than Orrification
 	DataChunk source_chunk;
 	source_chunk.InitializeEmpty(layout.GetTypes());
@@ -282,11 +313,153 @@ void JoinHashTable::Build(DataChunk &keys, DataChunk &payload) {
 
 	source_chunk.SetCardinality(keys);
 
-	RowOperations::Scatter(source_chunk, source_data.data(), layout, addresses, *string_heap, *current_sel,
-	                       added_count);
+	RowOperations::Scatter(source_chunk, source_data.data(), layout, addresses, *string_heap, sel, added_count);
+	lock_guard<mutex> append_lock(ht_lock);
+	active_builders--;
+	if (active_builders == 0) {
+		builders_done.notify_all();
+	}
+	return true;
+}
+
+bool JoinHashTable::ExceedsMemoryBudget(idx_t added_count) {
+	if (join_type == JoinType::MARK && !correlated_mark_join_info.correlated_types.empty()) {
+		// the correlated counts of a correlated MARK join cannot be partitioned
+		return false;
+	}
+	// we allow the HT to use up to half of the memory limit
+	return SizeInBytes(count + added_count) > buffer_manager.GetMaxMemory() / 2;
 }
 
-void JoinHashTable::InsertHashes(Vector &hashes, idx_t count, data_ptr_t key_locations[]) {
+idx_t JoinHashTable::SizeInBytes(idx_t entry_count) {
+	idx_t heap_size;
+	{
+		lock_guard<mutex> heap_lock(string_heap->rc_lock);
+		heap_size = string_heap->blocks.size() * string_heap->block_capacity * string_heap->entry_size;
+	}
+	// the HT needs to hold the entries, the string heap and the pointer table in memory
+	return entry_count * entry_size + NextPowerOfTwo(entry_count * 2) * sizeof(data_ptr_t) + heap_size;
+}
+
+void JoinHashTable::PartitionBuildSide(unique_lock<mutex> &append_lock) {
+	D_ASSERT(!external);
+	external = true;
+	// wait for the other threads to finish appending to the blocks; they cannot start new appends because the HT is
+	// external now
+	builders_done.wait(append_lock, [&]() { return active_builders == 0; });
+	// pick the amount of partitions such that every partition comfortably fits in memory
+	auto partition_budget = MaxValue<idx_t>(buffer_manager.GetMaxMemory() / 8, 1);
+	auto ht_size = SizeInBytes(count);
+	partition_info = make_unique<RadixPartitionInfo>(MaxValue<idx_t>(16, 4 * ht_size / partition_budget));
+	for (idx_t i = 0; i < partition_info->n_partitions; i++) {
+		build_partitions.push_back(make_unique<SpillableChunkCollection>(buffer_manager));
+		probe_partitions.push_back(make_unique<SpillableChunkCollection>(buffer_manager));
+	}
+
+	// gather the entries that are stored in the HT and move them to their partitions
+	auto types = condition_types;
+	types.insert(types.end(), build_types.begin(), build_types.end());
+	types.emplace_back(LogicalType::HASH);
+	DataChunk rows;
+	rows.Initialize(types);
+	Vector addresses(LogicalType::POINTER);
+	auto key_locations = FlatVector::GetData<data_ptr_t>(addresses);
+	const auto &sel_vector = FlatVector::INCREMENTAL_SELECTION_VECTOR;
+	for (auto &block : blocks) {
+		auto handle = buffer_manager.Pin(block.block);
+		data_ptr_t dataptr = handle->node->buffer;
+		idx_t entry = 0;
+		while (entry < block.count) {
+			idx_t next = MinValue<idx_t>(STANDARD_VECTOR_SIZE, block.count - entry);
+			for (idx_t i = 0; i < next; i++) {
+				key_locations[i] = dataptr;
+				dataptr += entry_size;
+			}
+			rows.Reset();
+			for (idx_t col_idx = 0; col_idx < rows.ColumnCount(); col_idx++) {
+				// the hash is the last column of both the layout and the chunk
+				auto col_no = col_idx + 1 == rows.ColumnCount() ? layout.ColumnCount() - 1 : col_idx;
+				RowOperations::Gather(addresses, sel_vector, rows.data[col_idx], sel_vector, next,
+				                      layout.GetOffsets()[col_no], col_no);
+			}
+			rows.SetCardinality(next);
+			AppendToPartitions(rows, rows.data.back(), sel_vector, next, build_partitions);
+			entry += next;
+		}
+	}
+	// release the in-memory entries
+	blocks.clear();
+	string_heap = make_unique<RowDataCollection>(buffer_manager, (idx_t)Storage::BLOCK_SIZE, 1, true);
+	count = 0;
+}
+
+void JoinHashTable::AppendToPartitions(DataChunk &rows, Vector &hashes, const SelectionVector &sel, idx_t row_count,
+                                       vector<unique_ptr<SpillableChunkCollection>> &partitions) {
+	D_ASSERT(partition_info);
+	VectorData hdata;
+	hashes.Orrify(rows.size(), hdata);
+	auto hash_data = (hash_t *)hdata.data;
+
+	// compute the partition of every row, and sort the rows by partition
+	idx_t partition_counts[256];
+	idx_t partition_offsets[256];
+	uint8_t row_partitions[STANDARD_VECTOR_SIZE];
+	memset(partition_counts, 0, sizeof(idx_t) * partition_info->n_partitions);
+	for (idx_t i = 0; i < row_count; i++) {
+		auto idx = sel.get_index(i);
+		auto hash = hash_data[hdata.sel->get_index(idx)];
+		row_partitions[i] = (hash & partition_info->radix_mask) >> RadixPartitionInfo::RADIX_SHIFT;
+		partition_counts[row_partitions[i]]++;
+	}
+	idx_t offset = 0;
+	for (idx_t p = 0; p < partition_info->n_partitions; p++) {
+		partition_offsets[p] = offset;
+		offset += partition_counts[p];
+	}
+	SelectionVector partition_sel(STANDARD_VECTOR_SIZE);
+	for (idx_t i = 0; i < row_count; i++) {
+		partition_sel.set_index(partition_offsets[row_partitions[i]]++, sel.get_index(i));
+	}
+
+	// now append the rows of every partition
+	DataChunk partition_chunk;
+	partition_chunk.InitializeEmpty(rows.GetTypes());
+	offset = 0;
+	for (idx_t p = 0; p < partition_info->n_partitions; p++) {
+		if (partition_counts[p] == 0) {
+			continue;
+		}
+		SelectionVector slice_sel(partition_sel.data() + offset);
+		partition_chunk.Slice(rows, slice_sel, partition_counts[p]);
+		partitions[p]->Append(partition_chunk);
+		offset += partition_counts[p];
+	}
+}
+
+template <bool PARALLEL>
+static inline void InsertHashesLoop(atomic<data_ptr_t> pointers[], const hash_t indices[], const idx_t count,
+                                    const data_ptr_t key_locations[], const idx_t pointer_offset) {
+	for (idx_t i = 0; i < count; i++) {
+		auto index = indices[i];
+		if (PARALLEL) {
+			// other threads can insert into the same bucket: swap in the current tuple with a compare-and-swap
+			data_ptr_t head;
+			do {
+				head = pointers[index].load();
+				Store<data_ptr_t>(head, key_locations[i] + pointer_offset);
+			} while (!pointers[index].compare_exchange_weak(head, key_locations[i]));
+		} else {
+			// set prev in current key to the value (NOTE: this will be nullptr if
+			// there is none)
+			Store<data_ptr_t>(pointers[index].load(std::memory_order_relaxed), key_locations[i] + pointer_offset);
+
+			// set pointer to current tuple
+			pointers[index].store(key_locations[i], std::memory_order_relaxed);
+		}
+	}
+}
+
+void JoinHashTable::InsertHashes(Vector &hashes, idx_t count, data_ptr_t key_locations[], bool parallel) {
 	D_ASSERT(hashes.GetType().id() == LogicalTypeId::HASH);
 
 	// use bitmask to get position in array
@@ -295,21 +468,16 @@ void JoinHashTable::InsertHashes(Vector &hashes, idx_t count, data_ptr_t key_loc
 	hashes.Normalify(count);
 
 	D_ASSERT(hashes.GetVectorType() == VectorType::FLAT_VECTOR);
-	auto pointers = (data_ptr_t *)hash_map->node->buffer;
+	auto pointers = (atomic<data_ptr_t> *)hash_map->node->buffer;
 	auto indices = FlatVector::GetData<hash_t>(hashes);
-	for (idx_t i = 0; i < count; i++) {
-		auto index = indices[i];
-		// set prev in current key to the value (NOTE: this will be nullptr if
-		// there is none)
-		Store<data_ptr_t>(pointers[index], key_locations[i] + pointer_offset);
-
-		// set pointer to current tuple
-		pointers[index] = key_locations[i];
+	if (parallel) {
+		InsertHashesLoop<true>(pointers, indices, count, key_locations, pointer_offset);
+	} else {
+		InsertHashesLoop<false>(pointers, indices, count, key_locations, pointer_offset);
 	}
 }
 
-void JoinHashTable::Finalize() {
-	// the build has finished, now iterate over all the nodes and construct the final hash table
+void JoinHashTable::InitializePointerTable() {
 	// select a HT that has at least 50% empty space
 	idx_t capacity = NextPowerOfTwo(MaxValue<idx_t>(count * 2, (Storage::BLOCK_SIZE / sizeof(data_ptr_t)) + 1));
 	// size needs to be a power of 2
@@ -320,16 +488,28 @@ void JoinHashTable::Finalize() {
 	hash_map = buffer_manager.Allocate(capacity * sizeof(data_ptr_t));
 	memset(hash_map->node->buffer, 0, capacity * sizeof(data_ptr_t));
 
+	// we pin all the blocks of the HT and keep them pinned until the HT is destroyed
+	// this is so that we can keep pointers around to the blocks
+	for (auto &block : blocks) {
+		pinned_handles.push_back(buffer_manager.Pin(block.block));
+	}
+	// no more entries can be added to the HT from this point on
+	if (!external) {
+		total_count = count;
+	}
+	finalized = true;
+}
+
+void JoinHashTable::InsertBlocks(idx_t block_idx_start, idx_t block_idx_end, bool parallel) {
+	D_ASSERT(finalized);
+	D_ASSERT(block_idx_end <= blocks.size());
 	Vector hashes(LogicalType::HASH);
 	auto hash_data = FlatVector::GetData<hash_t>(hashes);
 	data_ptr_t key_locations[STANDARD_VECTOR_SIZE];
 	// now construct the actual hash table; scan the nodes
-	// as we can the nodes we pin all the blocks of the HT and keep them pinned until the HT is destroyed
-	// this is so that we can keep pointers around to the blocks
-	// FIXME: if we cannot keep everything pinned in memory, we could switch to an out-of-memory merge join or so
-	for (auto &block : blocks) {
-		auto handle = buffer_manager.Pin(block.block);
-		data_ptr_t dataptr = handle->node->buffer;
+	for (idx_t block_idx = block_idx_start; block_idx < block_idx_end; block_idx++) {
+		auto &block = blocks[block_idx];
+		data_ptr_t dataptr = pinned_handles[block_idx]->node->buffer;
 		idx_t entry = 0;
 		while (entry < block.count) {
 			// fetch the next vector of entries from the blocks
@@ -340,18 +520,121 @@ void JoinHashTable::Finalize() {
 				dataptr += entry_size;
 			}
 			// now insert into the hash table
-			InsertHashes(hashes, next, key_locations);
+			InsertHashes(hashes, next, key_locations, parallel);
 
 			entry += next;
 		}
-		pinned_handles.push_back(move(handle));
 	}
+}
 
-	finalized = true;
+void JoinHashTable::BuildPointerTable() {
+	InitializePointerTable();
+	InsertBlocks(0, blocks.size(), false);
+}
+
+void JoinHashTable::Finalize() {
+	// the build has finished, now iterate over all the nodes and construct the final hash table
+	if (!external) {
+		BuildPointerTable();
+		return;
+	}
+	// external HT: load the first partition
+	total_count = 0;
+	for (auto &partition : build_partitions) {
+		total_count += partition->Count();
+	}
+	LoadPartition(0);
+}
+
+void JoinHashTable::LoadPartition(idx_t partition_idx) {
+	D_ASSERT(external);
+	// release the entries of the previously loaded partition
+	hash_map.reset();
+	pinned_handles.clear();
+	blocks.clear();
+	string_heap = make_unique<RowDataCollection>(buffer_manager, (idx_t)Storage::BLOCK_SIZE, 1, true);
+	count = 0;
+	finalized = false;
+
+	// now build the HT from the entries of the partition
+	current_partition = partition_idx;
+	auto &partition = *build_partitions[current_partition];
+	DataChunk keys, payload;
+	keys.InitializeEmpty(condition_types);
+	if (!build_types.empty()) {
+		// semi and anti joins do not have any payload
+		payload.InitializeEmpty(build_types);
+	}
+	DataChunk rows;
+	SpillableChunkScanState scan_state;
+	while (partition.Scan(scan_state, rows)) {
+		for (idx_t i = 0; i < keys.ColumnCount(); i++) {
+			keys.data[i].Reference(rows.data[i]);
+		}
+		for (idx_t i = 0; i < payload.ColumnCount(); i++) {
+			payload.data[i].Reference(rows.data[keys.ColumnCount() + i]);
+		}
+		keys.SetCardinality(rows);
+		payload.SetCardinality(rows);
+		auto key_data = keys.Orrify();
+		AppendRows(keys, key_data, payload, rows.data.back(), FlatVector::INCREMENTAL_SELECTION_VECTOR, rows.size(),
+		           false);
+	}
+	partition.Reset();
+	BuildPointerTable();
+}
+
+bool JoinHashTable::LoadNextPartition() {
+	D_ASSERT(external);
+	// the probe side of the current partition has been processed
+	probe_partitions[current_partition]->Reset();
+	if (current_partition + 1 >= build_partitions.size()) {
+		return false;
+	}
+	LoadPartition(current_partition + 1);
+	return true;
+}
+
+idx_t JoinHashTable::PartitionProbeSide(DataChunk &keys, DataChunk &payload, SelectionVector &sel) {
+	D_ASSERT(external);
+	Vector hashes(LogicalType::HASH);
+	Hash(keys, FlatVector::INCREMENTAL_SELECTION_VECTOR, keys.size(), hashes);
+
+	// split the rows into the ones that belong to the loaded partition and the ones that need to be spilled
+	VectorData hdata;
+	hashes.Orrify(keys.size(), hdata);
+	auto hash_data = (hash_t *)hdata.data;
+	SelectionVector spill_sel(STANDARD_VECTOR_SIZE);
+	idx_t current_count = 0;
+	idx_t spill_count = 0;
+	for (idx_t i = 0; i < keys.size(); i++) {
+		auto hash = hash_data[hdata.sel->get_index(i)];
+		auto partition_idx = (hash & partition_info->radix_mask) >> RadixPartitionInfo::RADIX_SHIFT;
+		if (partition_idx == current_partition) {
+			sel.set_index(current_count++, i);
+		} else {
+			spill_sel.set_index(spill_count++, i);
+		}
+	}
+	if (spill_count > 0) {
+		// spill the payload followed by the keys
+		DataChunk rows;
+		rows.InitializeEmpty(payload.GetTypes());
+		for (idx_t i = 0; i < payload.ColumnCount(); i++) {
+			rows.data[i].Reference(payload.data[i]);
+		}
+		for (idx_t i = 0; i < keys.ColumnCount(); i++) {
+			rows.data.emplace_back(keys.data[i]);
+		}
+		rows.data.emplace_back(hashes);
+		rows.SetCardinality(keys);
+		AppendToPartitions(rows, hashes, spill_sel, spill_count, probe_partitions);
+	}
+	return current_count;
 }
 
 unique_ptr<ScanStructure> JoinHashTable::Probe(DataChunk &keys) {
-	D_ASSERT(count > 0); // should be handled before
+	D_ASSERT(count > 0 || external); // should be handled before
 	D_ASSERT(finalized);
 
 	// set up the scan structure
@@ -376,15 +659,23 @@ unique_ptr<ScanStructure> JoinHashTable::Probe(DataChunk &keys) {
 	// now initialize the pointers of the scan structure based on the hashes
 	ApplyBitmask(hashes, *current_sel, ss->count, ss->pointers);
 
+	// the buckets are spread over the whole pointer table: issue the loads for all of them first
+	auto pointers = FlatVector::GetData<data_ptr_t>(ss->pointers);
+	for (idx_t i = 0; i < ss->count; i++) {
+		PrefetchAddress(pointers[current_sel->get_index(i)]);
+	}
+
 	// create the selection vector linking to only non-empty entries
+	// whether a bucket is empty is unpredictable: every row is written to the selection vector, but only the rows
+	// with a non-empty bucket are counted. The keys of these rows are compared next: start loading them (prefetching
+	// a null pointer is a no-op).
 	idx_t count = 0;
-	auto pointers = FlatVector::GetData<data_ptr_t>(ss->pointers);
 	for (idx_t i = 0; i < ss->count; i++) {
 		auto idx = current_sel->get_index(i);
 		pointers[idx] = Load<data_ptr_t>(pointers[idx]);
-		if (pointers[idx]) {
-			ss->sel_vector.set_index(count++, idx);
-		}
+		PrefetchAddress(pointers[idx]);
+		ss->sel_vector.set_index(count, idx);
+		count += pointers[idx] != nullptr;
 	}
 	ss->count = count;
 	return ss;
@@ -466,9 +757,9 @@ void ScanStructure::AdvancePointers(const SelectionVector &sel, idx_t sel_count)
 	for (idx_t i = 0; i < sel_count; i++) {
 		auto idx = sel.get_index(i);
 		ptrs[idx] = Load<data_ptr_t>(ptrs[idx] + ht.pointer_offset);
-		if (ptrs[idx]) {
-			this->sel_vector.set_index(new_count++, idx);
-		}
+		PrefetchAddress(ptrs[idx]);
+		this->sel_vector.set_index(new_count, idx);
+		new_count += ptrs[idx] != nullptr;
 	}
 	this->count = new_count;
 }
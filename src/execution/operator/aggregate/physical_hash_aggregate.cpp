@@ -95,7 +95,10 @@ class HashAggregateGlobalState : public GlobalOperatorState {
 public:
 	HashAggregateGlobalState(PhysicalHashAggregate &op_p, ClientContext &context)
 	    : op(op_p), is_empty(true), total_groups(0),
-	      partition_info((idx_t)TaskScheduler::GetScheduler(context).NumberOfThreads()) {
+	      partition_info((idx_t)TaskScheduler::GetScheduler(context).NumberOfThreads()), is_external(false) {
+		// the hash tables of all threads together may use up to a quarter of the memory limit before spilling
+		auto threads = (idx_t)TaskScheduler::GetScheduler(context).NumberOfThreads();
+		spill_threshold = BufferManager::GetBufferManager(context).GetMaxMemory() / (4 * threads);
 	}
 
 	PhysicalHashAggregate &op;
@@ -110,11 +113,18 @@ public:
 	atomic<idx_t> total_groups;
 
 	RadixPartitionInfo partition_info;
+
+	//! The size of the hash tables of a single thread at which the thread starts spilling its input
+	idx_t spill_threshold;
+	//! Whether or not any input was spilled because it did not fit in memory; the partitions are then finalized one at
+	//! a time while scanning
+	atomic<bool> is_external;
 };
 
 class HashAggregateLocalState : public LocalSinkState {
 public:
-	explicit HashAggregateLocalState(PhysicalHashAggregate &op_p) : op(op_p), is_empty(true) {
+	explicit HashAggregateLocalState(PhysicalHashAggregate &op_p)
+	    : op(op_p), is_empty(true), observed_rows(0), observed_groups(0) {
 		group_chunk.InitializeEmpty(op.group_types);
 		if (!op.payload_types.empty()) {
 			aggregate_input_chunk.InitializeEmpty(op.payload_types);
@@ -136,8 +146,16 @@ public:
 
 	//! Whether or not any tuples were added to the HT
 	bool is_empty;
+	//! The amount of rows and new groups seen by the local HT in the current observation window
+	idx_t observed_rows;
+	idx_t observed_groups;
 };
 
+//! The amount of rows after which the effectiveness of the local pre-aggregation is evaluated
+static constexpr idx_t PREAGGREGATION_OBSERVE_ROWS = 16 * STANDARD_VECTOR_SIZE;
+//! If more than this fraction of the observed rows created a new group, the local pre-aggregation is skipped
+static constexpr double PREAGGREGATION_BYPASS_RATIO = 0.95;
+
 unique_ptr<GlobalOperatorState> PhysicalHashAggregate::GetGlobalState(ClientContext &context) {
 	return make_unique<HashAggregateGlobalState>(*this, context);
 }
@@ -212,9 +230,36 @@ void PhysicalHashAggregate::Sink(ExecutionContext &context, GlobalOperatorState
 		                                                 gstate.partition_info, group_types, payload_types, bindings);
 	}
 
-	gstate.total_groups +=
-	    llstate.ht->AddChunk(group_chunk, aggregate_input_chunk,
-	                         gstate.total_groups > radix_limit && gstate.partition_info.n_partitions > 1);
+	auto new_groups = llstate.ht->AddChunk(group_chunk, aggregate_input_chunk,
+	                                       gstate.total_groups > radix_limit && gstate.partition_info.n_partitions > 1);
+	gstate.total_groups += new_groups;
+	if (llstate.ht->IsSpilling()) {
+		return;
+	}
+
+	// when the hash tables of this thread grow too large, the rest of the input is spilled per partition
+	if (llstate.ht->SizeInBytes() > gstate.spill_threshold) {
+		if (!llstate.ht->IsPartitioned()) {
+			llstate.ht->Partition();
+		}
+		llstate.ht->Spill();
+		gstate.is_external = true;
+		return;
+	}
+
+	// when (almost) every row creates a new group, the local HT does not reduce the input but only costs probing and
+	// resizing: skip it and only radix-partition the remaining rows, they are aggregated in the final combine
+	llstate.observed_rows += group_chunk.size();
+	llstate.observed_groups += new_groups;
+	if (llstate.observed_rows >= PREAGGREGATION_OBSERVE_ROWS) {
+		if (llstate.ht->IsPartitioned() &&
+		    double(llstate.observed_groups) > PREAGGREGATION_BYPASS_RATIO * double(llstate.observed_rows)) {
+			llstate.ht->Spill();
+			return;
+		}
+		llstate.observed_rows = 0;
+		llstate.observed_groups = 0;
+	}
 }
 
 class PhysicalHashAggregateState : public PhysicalOperatorState {
@@ -287,11 +332,43 @@ public:
 				ht.reset();
 			}
 		}
+		// aggregate the input that was spilled for this partition
+		auto &op = gstate.op;
+		DataChunk groups, payload, spilled_chunk;
+		groups.InitializeEmpty(op.group_types);
+		if (!op.payload_types.empty()) {
+			payload.InitializeEmpty(op.payload_types);
+		}
+		for (auto &pht : gstate.intermediate_hts) {
+			auto spilled = pht->GetSpilledPartition(radix);
+			if (!spilled) {
+				continue;
+			}
+			SpillableChunkScanState scan_state;
+			while (spilled->Scan(scan_state, spilled_chunk)) {
+				idx_t col_idx = 0;
+				for (idx_t i = 0; i < groups.ColumnCount(); i++) {
+					groups.data[i].Reference(spilled_chunk.data[col_idx++]);
+				}
+				for (idx_t i = 0; i < payload.ColumnCount(); i++) {
+					payload.data[i].Reference(spilled_chunk.data[col_idx++]);
+				}
+				groups.SetCardinality(spilled_chunk.size());
+				payload.SetCardinality(spilled_chunk.size());
+				gstate.finalized_hts[radix]->AddChunk(groups, payload);
+			}
+		}
 		gstate.finalized_hts[radix]->Finalize();
 	}
 
 	void Execute() override {
-		FinalizeHT(state, radix);
+		try {
+			FinalizeHT(state, radix);
+		} catch (std::exception &ex) {
+			parent.executor.PushError(ex.what());
+		} catch (...) {
+			parent.executor.PushError("Unknown exception in aggregate Finalize!");
+		}
 		auto total_tasks = parent.total_tasks.load();
 		auto finished_tasks = ++parent.finished_tasks;
 		// finish the whole pipeline
@@ -346,6 +423,24 @@ bool PhysicalHashAggregate::FinalizeInternal(ClientContext &context, unique_ptr<
 				pht->Partition();
 			}
 		}
+		if (!gstate.is_external) {
+			// input that skipped the thread-local pre-aggregation is only aggregated when the partitions are finalized:
+			// if it does not fit in the quarter of the memory limit that the hash tables may use, finalize it like
+			// spilled input
+			idx_t total_size = 0;
+			for (auto &pht : gstate.intermediate_hts) {
+				total_size += pht->SizeInBytes() + pht->SpilledSizeInBytes();
+			}
+			if (total_size > BufferManager::GetBufferManager(context).GetMaxMemory() / 4) {
+				gstate.is_external = true;
+			}
+		}
+		if (gstate.is_external) {
+			// the aggregate does not fit in memory: instead of finalizing all partitions in parallel, every
+			// partition is finalized right before it is scanned so only a single partition is in memory at a time
+			gstate.finalized_hts.resize(gstate.partition_info.n_partitions);
+			return true;
+		}
 		// schedule additional tasks to combine the partial HTs
 		if (!immediate) {
 			D_ASSERT(pipeline);
@@ -424,6 +519,12 @@ void PhysicalHashAggregate::GetChunkInternal(ExecutionContext &context, DataChun
 			state.finished = true;
 			return;
 		}
+		if (gstate.is_external && !gstate.finalized_hts[state.ht_index]) {
+			gstate.finalized_hts[state.ht_index] =
+			    make_unique<GroupedAggregateHashTable>(BufferManager::GetBufferManager(context.client), group_types,
+			                                           payload_types, bindings, HtEntryType::HT_WIDTH_64);
+			PhysicalHashAggregateFinalizeTask::FinalizeHT(gstate, state.ht_index);
+		}
 		elements_found = gstate.finalized_hts[state.ht_index]->Scan(state.ht_scan_position, state.scan_chunk);
 
 		if (elements_found > 0) {
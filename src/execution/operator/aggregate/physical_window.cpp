@@ -3,9 +3,11 @@
 #include "duckdb/common/operator/comparison_operators.hpp"
 #include "duckdb/common/types/chunk_collection.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/execution/executor.hpp"
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/execution/window_segment_tree.hpp"
 #include "duckdb/parallel/task_context.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 #include "duckdb/planner/expression/bound_reference_expression.hpp"
 #include "duckdb/planner/expression/bound_window_expression.hpp"
 #include "duckdb/common/windows_undefs.hpp"
@@ -17,19 +19,28 @@ namespace duckdb {
 
 using counts_t = std::vector<size_t>;
 
+//	A hash partition of the input
+struct WindowHashPartition {
+	//! The input rows of the partition
+	ChunkCollection chunks;
+	//! The materialized OVER columns of the partition
+	ChunkCollection over_collection;
+	//! The results of the window functions
+	ChunkCollection window_results;
+};
+
 //	Global sink state
 class WindowGlobalState : public GlobalOperatorState {
 public:
-	WindowGlobalState(PhysicalWindow &op_p, ClientContext &context) : op(op_p) {
+	WindowGlobalState(PhysicalWindow &op_p, ClientContext &context) : op(op_p), next_partition(0) {
 	}
 
 	PhysicalWindow &op;
 	mutex lock;
-	ChunkCollection chunks;
-	ChunkCollection over_collection;
-	ChunkCollection hash_collection;
-	ChunkCollection window_results;
-	counts_t counts;
+	//! The hash partitions of the input (a single partition if there is no PARTITION BY clause)
+	vector<unique_ptr<WindowHashPartition>> partitions;
+	//! The next partition to evaluate during the finalize
+	atomic<idx_t> next_partition;
 };
 
 //	Per-thread sink state
@@ -802,43 +813,122 @@ static void ComputeWindowExpressions(WindowExpressions &window_exprs, ChunkColle
 	}
 }
 
-static void AppendCollection(const ChunkCollection &source, ChunkCollection &target, SelectionVector &sel,
-                             const idx_t source_count, const idx_t chunk_idx) {
-
-	DataChunk chunk;
-	chunk.Initialize(source.Types());
-	source.GetChunk(chunk_idx).Copy(chunk, sel, source_count);
-	target.Append(chunk);
+static void AppendToPartition(DataChunk &source, const SelectionVector &sel, const idx_t count,
+                              unique_ptr<DataChunk> &buffer, ChunkCollection &target) {
+	idx_t offset = 0;
+	while (offset < count) {
+		if (!buffer) {
+			buffer = make_unique<DataChunk>();
+			buffer->Initialize(source.GetTypes());
+		}
+		const auto buffer_count = buffer->size();
+		const auto append_count = MinValue<idx_t>(count - offset, STANDARD_VECTOR_SIZE - buffer_count);
+		for (idx_t col_idx = 0; col_idx < source.ColumnCount(); ++col_idx) {
+			VectorOperations::Copy(source.data[col_idx], buffer->data[col_idx], sel, offset + append_count, offset,
+			                       buffer_count);
+		}
+		buffer->SetCardinality(buffer_count + append_count);
+		offset += append_count;
+		if (buffer->size() == STANDARD_VECTOR_SIZE) {
+			target.Append(*buffer);
+			buffer->Reset();
+		}
+	}
 }
 
-static void ExtractPartition(WindowGlobalState &gstate, ChunkCollection &chunks, ChunkCollection &window_results,
-                             ChunkCollection &over_collection, const hash_t hash_bin, const hash_t hash_mask) {
-
-	//	Copy the partition data so we can work with it on this thread
-	ChunkCollection &hashes = gstate.hash_collection;
-	SelectionVector sel;
-	for (idx_t chunk_idx = 0; chunk_idx < hashes.ChunkCount(); ++chunk_idx) {
-		//	Build a selection vector of matching hashes
-		auto &hash_chunk = hashes.GetChunk(chunk_idx);
-		auto hash_size = hash_chunk.size();
-		auto hash_data = FlatVector::GetData<hash_t>(hash_chunk.data[0]);
-		sel.Initialize(hash_size);
-		idx_t bin_size = 0;
-		for (idx_t i = 0; i < hash_size; ++i) {
-			if ((hash_data[i] & hash_mask) == hash_bin) {
-				sel.set_index(bin_size++, i);
+//	Scatter the rows gathered by a thread to their hash partitions
+static void ScatterToPartitions(WindowLocalState &lstate, vector<unique_ptr<WindowHashPartition>> &partitions) {
+	const auto partition_count = lstate.counts.size();
+	const auto partition_mask = hash_t(partition_count - 1);
+	partitions.resize(partition_count);
+
+	//	Partially filled chunks, so every partition receives full chunks
+	vector<unique_ptr<DataChunk>> chunk_buffers(partition_count);
+	vector<unique_ptr<DataChunk>> over_buffers(partition_count);
+
+	counts_t bin_counts(partition_count);
+	counts_t bin_offsets(partition_count);
+	SelectionVector sel(STANDARD_VECTOR_SIZE);
+	for (idx_t chunk_idx = 0; chunk_idx < lstate.hash_collection.ChunkCount(); ++chunk_idx) {
+		auto &hash_chunk = lstate.hash_collection.GetChunk(chunk_idx);
+		auto &input_chunk = lstate.chunks.GetChunk(chunk_idx);
+		auto &over_chunk = lstate.over_collection.GetChunk(chunk_idx);
+		D_ASSERT(hash_chunk.size() == input_chunk.size() && hash_chunk.size() == over_chunk.size());
+		const auto count = hash_chunk.size();
+		auto hashes = FlatVector::GetData<hash_t>(hash_chunk.data[0]);
+
+		//	Group the rows of the chunk by partition
+		std::fill(bin_counts.begin(), bin_counts.end(), 0);
+		for (idx_t i = 0; i < count; ++i) {
+			++bin_counts[hashes[i] & partition_mask];
+		}
+		size_t offset = 0;
+		for (idx_t bin = 0; bin < partition_count; ++bin) {
+			bin_offsets[bin] = offset;
+			offset += bin_counts[bin];
+		}
+		for (idx_t i = 0; i < count; ++i) {
+			sel.set_index(bin_offsets[hashes[i] & partition_mask]++, i);
+		}
+
+		//	Copy the rows of each group to their partition
+		for (idx_t bin = 0; bin < partition_count; ++bin) {
+			const auto bin_count = bin_counts[bin];
+			if (bin_count == 0) {
+				continue;
 			}
+			if (!partitions[bin]) {
+				partitions[bin] = make_unique<WindowHashPartition>();
+			}
+			auto &partition = *partitions[bin];
+			SelectionVector bin_sel(sel.data() + bin_offsets[bin] - bin_count);
+			AppendToPartition(input_chunk, bin_sel, bin_count, chunk_buffers[bin], partition.chunks);
+			AppendToPartition(over_chunk, bin_sel, bin_count, over_buffers[bin], partition.over_collection);
 		}
+	}
 
-		//	Copy the data for each collection
-		if (bin_size == 0) {
-			continue;
+	//	Flush the partially filled chunks
+	for (idx_t bin = 0; bin < partition_count; ++bin) {
+		if (chunk_buffers[bin]) {
+			partitions[bin]->chunks.Append(*chunk_buffers[bin]);
+			partitions[bin]->over_collection.Append(*over_buffers[bin]);
+		}
+	}
+	lstate.chunks.Reset();
+	lstate.over_collection.Reset();
+	lstate.hash_collection.Reset();
+}
+
+//	Sort a partition and evaluate the window functions over it
+static void EvaluatePartition(PhysicalWindow &op, WindowHashPartition &partition) {
+	WindowExpressions window_exprs;
+	vector<LogicalType> window_types;
+	for (idx_t expr_idx = 0; expr_idx < op.select_list.size(); ++expr_idx) {
+		D_ASSERT(op.select_list[expr_idx]->GetExpressionClass() == ExpressionClass::BOUND_WINDOW);
+		auto wexpr = reinterpret_cast<BoundWindowExpression *>(op.select_list[expr_idx].get());
+		window_exprs.emplace_back(wexpr);
+		window_types.push_back(wexpr->return_type);
+	}
+
+	ChunkCollection &big_data = partition.chunks;
+	ChunkCollection &window_results = partition.window_results;
+	for (idx_t i = 0; i < big_data.ChunkCount(); i++) {
+		DataChunk window_chunk;
+		window_chunk.Initialize(window_types);
+		window_chunk.SetCardinality(big_data.GetChunk(i).size());
+		for (idx_t col_idx = 0; col_idx < window_chunk.ColumnCount(); col_idx++) {
+			window_chunk.data[col_idx].SetVectorType(VectorType::CONSTANT_VECTOR);
+			ConstantVector::SetNull(window_chunk.data[col_idx], true);
 		}
 
-		AppendCollection(gstate.chunks, chunks, sel, bin_size, chunk_idx);
-		AppendCollection(gstate.window_results, window_results, sel, bin_size, chunk_idx);
-		AppendCollection(gstate.over_collection, over_collection, sel, bin_size, chunk_idx);
+		window_chunk.Verify();
+		window_results.Append(window_chunk);
 	}
+	D_ASSERT(window_results.ColumnCount() == op.select_list.size());
+
+	ComputeWindowExpressions(window_exprs, big_data, window_results, partition.over_collection);
+	//	The OVER columns are not needed for the scan
+	partition.over_collection.Reset();
 }
 
 //===--------------------------------------------------------------------===//
@@ -853,17 +943,13 @@ idx_t PhysicalWindow::MaxThreads(ClientContext &context) {
 	}
 	auto &state = (WindowGlobalState &)*this->sink_state;
 
-	// If there is only one partition, we have to process it on one thread.
-	if (state.counts.empty()) {
-		return 1;
-	}
-
+	// Every partition is scanned by a single thread
 	idx_t max_threads = 0;
-	for (const auto count : state.counts) {
-		max_threads += int(count > 0);
+	for (const auto &partition : state.partitions) {
+		max_threads += int(partition != nullptr);
 	}
 
-	return max_threads;
+	return MaxValue<idx_t>(max_threads, 1);
 }
 
 //	Global read state
@@ -884,20 +970,17 @@ unique_ptr<ParallelState> PhysicalWindow::GetParallelState() {
 class PhysicalWindowOperatorState : public PhysicalOperatorState {
 public:
 	PhysicalWindowOperatorState(PhysicalOperator &op, PhysicalOperator *child)
-	    : PhysicalOperatorState(op, child), parallel_state(nullptr), initialized(false) {
+	    : PhysicalOperatorState(op, child), parallel_state(nullptr), initialized(false), next_part(0),
+	      partition(nullptr), position(0) {
 	}
 
 	ParallelState *parallel_state;
 	bool initialized;
 
-	//! The number of partitions to process (0 if there is no partitioning)
-	size_t partitions;
 	//! The output read position.
 	size_t next_part;
-	//! The generated input chunks
-	ChunkCollection chunks;
-	//! The generated output chunks
-	ChunkCollection window_results;
+	//! The partition that is being scanned
+	WindowHashPartition *partition;
 	//! The read cursor
 	idx_t position;
 };
@@ -906,42 +989,9 @@ unique_ptr<PhysicalOperatorState> PhysicalWindow::GetOperatorState() {
 	return make_unique<PhysicalWindowOperatorState>(*this, children.empty() ? nullptr : children[0].get());
 }
 
-static void GeneratePartition(PhysicalWindowOperatorState &state, WindowGlobalState &gstate, const idx_t hash_bin) {
-	auto &op = (PhysicalWindow &)gstate.op;
-	WindowExpressions window_exprs;
-	for (idx_t expr_idx = 0; expr_idx < op.select_list.size(); ++expr_idx) {
-		D_ASSERT(op.select_list[expr_idx]->GetExpressionClass() == ExpressionClass::BOUND_WINDOW);
-		auto wexpr = reinterpret_cast<BoundWindowExpression *>(op.select_list[expr_idx].get());
-		window_exprs.emplace_back(wexpr);
-	}
-
-	//	Get rid of any stale data
-	state.chunks.Reset();
-	state.window_results.Reset();
-	state.position = 0;
-
-	if (gstate.counts.empty() && hash_bin == 0) {
-		ChunkCollection &big_data = gstate.chunks;
-		ChunkCollection &window_results = gstate.window_results;
-		ChunkCollection &over_collection = gstate.over_collection;
-		ComputeWindowExpressions(window_exprs, big_data, window_results, over_collection);
-		state.chunks.Merge(big_data);
-		state.window_results.Merge(window_results);
-	} else if (hash_bin < gstate.counts.size() && gstate.counts[hash_bin] > 0) {
-		ChunkCollection input;
-		ChunkCollection output;
-		ChunkCollection over;
-		const auto hash_mask = hash_t(gstate.counts.size() - 1);
-		ExtractPartition(gstate, input, output, over, hash_bin, hash_mask);
-		ComputeWindowExpressions(window_exprs, input, output, over);
-		state.chunks.Merge(input);
-		state.window_results.Merge(output);
-	}
-}
-
 static void Scan(PhysicalWindowOperatorState &state, DataChunk &chunk) {
-	ChunkCollection &big_data = state.chunks;
-	ChunkCollection &window_results = state.window_results;
+	ChunkCollection &big_data = state.partition->chunks;
+	ChunkCollection &window_results = state.partition->window_results;
 
 	if (state.position >= big_data.Count()) {
 		return;
@@ -972,13 +1022,11 @@ void PhysicalWindow::GetChunkInternal(ExecutionContext &context, DataChunk &chun
 
 	if (!state.initialized) {
 		// initialize thread-local operator state
-		state.partitions = gstate.counts.size();
 		state.next_part = 0;
 		// record parallel state (if any)
 		state.parallel_state = nullptr;
 		auto &task = context.task;
 		// check if there is any parallel state to fetch
-		state.parallel_state = nullptr;
 		auto task_info = task.task_info.find(this);
 		if (task_info != task.task_info.end()) {
 			// parallel scan init
@@ -987,41 +1035,27 @@ void PhysicalWindow::GetChunkInternal(ExecutionContext &context, DataChunk &chun
 		state.initialized = true;
 	}
 
-	if (!state.parallel_state) {
-		// sequential scan
-		if (state.position >= state.chunks.Count()) {
-			auto hash_bin = state.next_part++;
-			for (; hash_bin < state.partitions; hash_bin = state.next_part++) {
-				if (gstate.counts[hash_bin] > 0) {
-					break;
-				}
-			}
-			GeneratePartition(state, gstate, hash_bin);
-		}
-		Scan(state, chunk);
-		if (chunk.size() != 0) {
-			return;
-		}
-	} else {
-		// parallel scan
-		auto &parallel_state = *reinterpret_cast<WindowParallelState *>(state.parallel_state);
-		do {
-			if (state.position >= state.chunks.Count()) {
-				auto hash_bin = parallel_state.next_part++;
-				for (; hash_bin < state.partitions; hash_bin = parallel_state.next_part++) {
-					if (gstate.counts[hash_bin] > 0) {
-						break;
-					}
-				}
-				GeneratePartition(state, gstate, hash_bin);
-			}
+	while (true) {
+		if (state.partition) {
 			Scan(state, chunk);
 			if (chunk.size() != 0) {
 				return;
-			} else {
-				break;
 			}
-		} while (true);
+			state.partition = nullptr;
+		}
+		// fetch the next partition to scan: in a parallel scan every partition is scanned by a single thread
+		idx_t hash_bin;
+		if (state.parallel_state) {
+			auto &parallel_state = *reinterpret_cast<WindowParallelState *>(state.parallel_state);
+			hash_bin = parallel_state.next_part++;
+		} else {
+			hash_bin = state.next_part++;
+		}
+		if (hash_bin >= gstate.partitions.size()) {
+			break;
+		}
+		state.partition = gstate.partitions[hash_bin].get();
+		state.position = 0;
 	}
 	D_ASSERT(chunk.size() == 0);
 }
@@ -1062,55 +1096,103 @@ void PhysicalWindow::Combine(ExecutionContext &context, GlobalOperatorState &gst
 		return;
 	}
 	auto &gstate = (WindowGlobalState &)gstate_p;
-	lock_guard<mutex> glock(gstate.lock);
-	gstate.chunks.Merge(lstate.chunks);
-	gstate.over_collection.Merge(lstate.over_collection);
-	gstate.hash_collection.Merge(lstate.hash_collection);
-	if (gstate.counts.empty()) {
-		gstate.counts = lstate.counts;
-	} else {
-		D_ASSERT(gstate.counts.size() == lstate.counts.size());
-		for (idx_t i = 0; i < gstate.counts.size(); ++i) {
-			gstate.counts[i] += lstate.counts[i];
+	if (lstate.counts.empty()) {
+		// no partitioning: all rows end up in a single partition
+		lock_guard<mutex> glock(gstate.lock);
+		if (gstate.partitions.empty()) {
+			gstate.partitions.push_back(make_unique<WindowHashPartition>());
 		}
+		auto &partition = *gstate.partitions[0];
+		partition.chunks.Merge(lstate.chunks);
+		partition.over_collection.Merge(lstate.over_collection);
+		return;
 	}
-}
-
-bool PhysicalWindow::FinalizeInternal(ClientContext &context, unique_ptr<GlobalOperatorState> gstate_p) {
-	this->sink_state = move(gstate_p);
-	auto &gstate = (WindowGlobalState &)*this->sink_state;
 
-	ChunkCollection &big_data = gstate.chunks;
-	ChunkCollection &window_results = gstate.window_results;
+	// scatter the rows to their partitions outside of the lock
+	vector<unique_ptr<WindowHashPartition>> partitions;
+	ScatterToPartitions(lstate, partitions);
 
-	if (big_data.Count() == 0) {
-		return true;
+	lock_guard<mutex> glock(gstate.lock);
+	if (gstate.partitions.empty()) {
+		gstate.partitions = move(partitions);
+		return;
+	}
+	D_ASSERT(gstate.partitions.size() == partitions.size());
+	for (idx_t i = 0; i < partitions.size(); ++i) {
+		if (!partitions[i]) {
+			continue;
+		}
+		if (!gstate.partitions[i]) {
+			gstate.partitions[i] = move(partitions[i]);
+			continue;
+		}
+		gstate.partitions[i]->chunks.Merge(partitions[i]->chunks);
+		gstate.partitions[i]->over_collection.Merge(partitions[i]->over_collection);
 	}
+}
 
-	vector<LogicalType> window_types;
-	for (idx_t expr_idx = 0; expr_idx < select_list.size(); expr_idx++) {
-		window_types.push_back(select_list[expr_idx]->return_type);
+//	Evaluates the window functions of the partitions that have not been claimed by another task yet
+class WindowFinalizeTask : public Task {
+public:
+	WindowFinalizeTask(Pipeline &parent_p, PhysicalWindow &op_p, WindowGlobalState &state_p)
+	    : parent(parent_p), op(op_p), state(state_p) {
 	}
 
-	for (idx_t i = 0; i < big_data.ChunkCount(); i++) {
-		DataChunk window_chunk;
-		window_chunk.Initialize(window_types);
-		window_chunk.SetCardinality(big_data.GetChunk(i).size());
-		for (idx_t col_idx = 0; col_idx < window_chunk.ColumnCount(); col_idx++) {
-			window_chunk.data[col_idx].SetVectorType(VectorType::CONSTANT_VECTOR);
-			ConstantVector::SetNull(window_chunk.data[col_idx], true);
+	void Execute() override {
+		try {
+			for (idx_t i = state.next_partition++; i < state.partitions.size(); i = state.next_partition++) {
+				if (state.partitions[i]) {
+					EvaluatePartition(op, *state.partitions[i]);
+				}
+			}
+		} catch (std::exception &ex) {
+			parent.executor.PushError(ex.what());
+		} catch (...) {
+			parent.executor.PushError("Unknown exception in window Finalize!");
+		}
+		auto total_tasks = parent.total_tasks.load();
+		auto finished_tasks = ++parent.finished_tasks;
+		// finish the whole pipeline
+		if (total_tasks == finished_tasks) {
+			parent.Finish();
 		}
-
-		window_chunk.Verify();
-		window_results.Append(window_chunk);
 	}
 
-	D_ASSERT(window_results.ColumnCount() == select_list.size());
-	return true;
-}
+private:
+	Pipeline &parent;
+	PhysicalWindow &op;
+	WindowGlobalState &state;
+};
 
 bool PhysicalWindow::Finalize(Pipeline &pipeline, ClientContext &context, unique_ptr<GlobalOperatorState> gstate_p) {
-	return FinalizeInternal(context, move(gstate_p));
+	this->sink_state = move(gstate_p);
+	auto &gstate = (WindowGlobalState &)*this->sink_state;
+
+	idx_t partition_count = 0;
+	for (auto &partition : gstate.partitions) {
+		partition_count += int(partition != nullptr);
+	}
+
+	auto &scheduler = TaskScheduler::GetScheduler(context);
+	idx_t num_threads = scheduler.NumberOfThreads();
+	if (num_threads == 1 || partition_count <= 1) {
+		// evaluate the partitions on this thread
+		for (auto &partition : gstate.partitions) {
+			if (partition) {
+				EvaluatePartition(*this, *partition);
+			}
+		}
+		return true;
+	}
+	// sort and evaluate the partitions in parallel
+	gstate.next_partition = 0;
+	idx_t task_count = MinValue<idx_t>(num_threads, partition_count);
+	pipeline.total_tasks += task_count;
+	for (idx_t i = 0; i < task_count; i++) {
+		auto new_task = make_unique<WindowFinalizeTask>(pipeline, *this, gstate);
+		scheduler.ScheduleTask(pipeline.token, move(new_task));
+	}
+	return false;
 }
 
 unique_ptr<LocalSinkState> PhysicalWindow::GetLocalSinkState(ExecutionContext &context) {
@@ -32,21 +32,28 @@ PhysicalFilter::PhysicalFilter(vector<LogicalType> types, vector<unique_ptr<Expr
 void PhysicalFilter::GetChunkInternal(ExecutionContext &context, DataChunk &chunk,
                                       PhysicalOperatorState *state_p) const {
 	auto state = reinterpret_cast<PhysicalFilterState *>(state_p);
-	SelectionVector sel(STANDARD_VECTOR_SIZE);
-	idx_t initial_count;
-	idx_t result_count;
 	do {
 		// fetch a chunk from the child and run the filter
 		// we repeat this process until either (1) passing tuples are found, or (2) the child is completely exhausted
-		children[0]->GetChunk(context, chunk, state->child_state.get());
-		if (chunk.size() == 0) {
+		children[0]->GetChunk(context, state->child_chunk, state->child_state.get());
+		if (state->child_chunk.size() == 0) {
 			return;
 		}
-		initial_count = chunk.size();
-		result_count = state->executor.SelectExpression(chunk, sel);
-	} while (result_count == 0);
+		ExecuteInternal(context, state->child_chunk, chunk, state_p);
+	} while (chunk.size() == 0);
+}
 
-	if (result_count == initial_count) {
+void PhysicalFilter::ExecuteInternal(ExecutionContext &context, DataChunk &input, DataChunk &chunk,
+                                     PhysicalOperatorState *state_p) const {
+	auto state = reinterpret_cast<PhysicalFilterState *>(state_p);
+	SelectionVector sel(STANDARD_VECTOR_SIZE);
+	idx_t result_count = state->executor.SelectExpression(input, sel);
+	if (result_count == 0) {
+		// all tuples were filtered out: return an empty chunk
+		return;
+	}
+	chunk.Reference(input);
+	if (result_count == input.size()) {
 		// nothing was filtered: skip adding any selection vectors
 		return;
 	}
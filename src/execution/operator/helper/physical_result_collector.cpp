@@ -0,0 +1,135 @@
+#include "duckdb/execution/operator/helper/physical_result_collector.hpp"
+
+#include "duckdb/common/types/chunk_collection.hpp"
+#include "duckdb/execution/operator/scan/physical_table_scan.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+
+#include <map>
+
+namespace duckdb {
+
+PhysicalResultCollector::PhysicalResultCollector(PhysicalOperator &plan)
+    : PhysicalSink(PhysicalOperatorType::RESULT_COLLECTOR, plan.types, plan.estimated_cardinality), plan(plan) {
+}
+
+bool PhysicalResultCollector::CanCollectInParallel(ClientContext &context, PhysicalOperator &plan) {
+	if (TaskScheduler::GetScheduler(context).NumberOfThreads() <= 1) {
+		return false;
+	}
+	// the plan has to consist of streaming operators on top of a scan that can restore the order of its batches
+	auto source = &plan;
+	while (source->IsStreaming()) {
+		source = source->children[0].get();
+	}
+	if (source->type != PhysicalOperatorType::TABLE_SCAN) {
+		return false;
+	}
+	return ((PhysicalTableScan &)*source).SupportsBatchIndex();
+}
+
+//===--------------------------------------------------------------------===//
+// Sink
+//===--------------------------------------------------------------------===//
+class ResultCollectorGlobalState : public GlobalOperatorState {
+public:
+	mutex lock;
+	//! The collected chunks of every batch
+	std::map<idx_t, unique_ptr<ChunkCollection>> batches;
+	//! The collected chunks in the order of the batches (after Finalize)
+	vector<unique_ptr<ChunkCollection>> result;
+};
+
+class ResultCollectorLocalState : public LocalSinkState {
+public:
+	ResultCollectorLocalState() : current_batch(0) {
+	}
+
+	//! The batch that is currently being collected
+	idx_t current_batch;
+	//! The chunks of the current batch
+	unique_ptr<ChunkCollection> collection;
+};
+
+static void FlushBatch(ResultCollectorGlobalState &gstate, ResultCollectorLocalState &lstate) {
+	if (!lstate.collection) {
+		return;
+	}
+	lock_guard<mutex> glock(gstate.lock);
+	D_ASSERT(gstate.batches.find(lstate.current_batch) == gstate.batches.end());
+	gstate.batches[lstate.current_batch] = move(lstate.collection);
+}
+
+void PhysicalResultCollector::Sink(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate_p,
+                                   DataChunk &input) const {
+	auto &gstate = (ResultCollectorGlobalState &)state;
+	auto &lstate = (ResultCollectorLocalState &)lstate_p;
+	if (lstate.collection && lstate.batch_index != lstate.current_batch) {
+		// the input belongs to a new batch: move the previous batch to the global state
+		FlushBatch(gstate, lstate);
+	}
+	if (!lstate.collection) {
+		lstate.collection = make_unique<ChunkCollection>();
+		lstate.current_batch = lstate.batch_index;
+	}
+	lstate.collection->Append(input);
+}
+
+void PhysicalResultCollector::Combine(ExecutionContext &context, GlobalOperatorState &state,
+                                      LocalSinkState &lstate_p) {
+	auto &gstate = (ResultCollectorGlobalState &)state;
+	auto &lstate = (ResultCollectorLocalState &)lstate_p;
+	FlushBatch(gstate, lstate);
+}
+
+unique_ptr<GlobalOperatorState> PhysicalResultCollector::GetGlobalState(ClientContext &context) {
+	return make_unique<ResultCollectorGlobalState>();
+}
+
+unique_ptr<LocalSinkState> PhysicalResultCollector::GetLocalSinkState(ExecutionContext &context) {
+	return make_unique<ResultCollectorLocalState>();
+}
+
+bool PhysicalResultCollector::Finalize(Pipeline &pipeline, ClientContext &context,
+                                       unique_ptr<GlobalOperatorState> state) {
+	auto &gstate = (ResultCollectorGlobalState &)*state;
+	for (auto &entry : gstate.batches) {
+		gstate.result.push_back(move(entry.second));
+	}
+	gstate.batches.clear();
+	return PhysicalSink::Finalize(pipeline, context, move(state));
+}
+
+//===--------------------------------------------------------------------===//
+// GetChunkInternal
+//===--------------------------------------------------------------------===//
+class PhysicalResultCollectorState : public PhysicalOperatorState {
+public:
+	explicit PhysicalResultCollectorState(PhysicalOperator &op)
+	    : PhysicalOperatorState(op, nullptr), collection_index(0), chunk_index(0) {
+	}
+
+	idx_t collection_index;
+	idx_t chunk_index;
+};
+
+void PhysicalResultCollector::GetChunkInternal(ExecutionContext &context, DataChunk &chunk,
+                                               PhysicalOperatorState *state_p) const {
+	auto &state = (PhysicalResultCollectorState &)*state_p;
+	auto &gstate = (ResultCollectorGlobalState &)*sink_state;
+	while (state.collection_index < gstate.result.size()) {
+		auto &collection = *gstate.result[state.collection_index];
+		if (state.chunk_index < collection.ChunkCount()) {
+			chunk.Reference(collection.GetChunk(state.chunk_index++));
+			return;
+		}
+		state.collection_index++;
+		state.chunk_index = 0;
+	}
+}
+
+unique_ptr<PhysicalOperatorState> PhysicalResultCollector::GetOperatorState() {
+	return make_unique<PhysicalResultCollectorState>(*this);
+}
+
+} // namespace duckdb
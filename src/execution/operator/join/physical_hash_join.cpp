@@ -7,6 +7,8 @@
 #include "duckdb/function/aggregate/distributive_functions.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/main/query_profiler.hpp"
+#include "duckdb/parallel/pipeline.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 
 namespace duckdb {
 
@@ -62,6 +64,9 @@ unique_ptr<GlobalOperatorState> PhysicalHashJoin::GetGlobalState(ClientContext &
 	auto state = make_unique<HashJoinGlobalState>();
 	state->hash_table =
 	    make_unique<JoinHashTable>(BufferManager::GetBufferManager(context), conditions, build_types, join_type);
+	for (auto &join_key_filter : join_key_filters) {
+		join_key_filter->Initialize(children[1]->estimated_cardinality);
+	}
 	if (!delim_types.empty() && join_type == JoinType::MARK) {
 		// correlated MARK join
 		if (delim_types.size() + 1 == conditions.size()) {
@@ -123,6 +128,9 @@ void PhysicalHashJoin::Sink(ExecutionContext &context, GlobalOperatorState &stat
 	auto &lstate = (HashJoinLocalState &)lstate_p;
 	// resolve the join keys for the right chunk
 	lstate.build_executor.Execute(input, lstate.join_keys);
+	for (idx_t i = 0; i < join_key_filters.size(); i++) {
+		join_key_filters[i]->AddKeys(lstate.join_keys.data[join_key_filter_conditions[i]], lstate.join_keys.size());
+	}
 	// build the HT
 	if (!right_projection_map.empty()) {
 		// there is a projection map: fill the build chunk with the projected columns
@@ -145,12 +153,70 @@ void PhysicalHashJoin::Sink(ExecutionContext &context, GlobalOperatorState &stat
 //===--------------------------------------------------------------------===//
 // Finalize
 //===--------------------------------------------------------------------===//
+//! The minimum amount of blocks of the hash table that each task inserts when the pointer table is constructed in
+//! parallel
+static constexpr const idx_t MINIMUM_BLOCKS_PER_FINALIZE_TASK = 4;
+
+class HashJoinFinalizeTask : public Task {
+public:
+	HashJoinFinalizeTask(Pipeline &parent_p, JoinHashTable &ht_p, idx_t block_idx_start_p, idx_t block_idx_end_p)
+	    : parent(parent_p), ht(ht_p), block_idx_start(block_idx_start_p), block_idx_end(block_idx_end_p) {
+	}
+
+	void Execute() override {
+		ht.InsertBlocks(block_idx_start, block_idx_end, true);
+		auto total_tasks = parent.total_tasks.load();
+		auto finished_tasks = ++parent.finished_tasks;
+		// finish the whole pipeline
+		if (total_tasks == finished_tasks) {
+			parent.Finish();
+		}
+	}
+
+private:
+	Pipeline &parent;
+	JoinHashTable &ht;
+	idx_t block_idx_start;
+	idx_t block_idx_end;
+};
+
 bool PhysicalHashJoin::Finalize(Pipeline &pipeline, ClientContext &context, unique_ptr<GlobalOperatorState> state) {
 	auto &sink = (HashJoinGlobalState &)*state;
-	sink.hash_table->Finalize();
-
+	auto &ht = *sink.hash_table;
 	PhysicalSink::Finalize(pipeline, context, move(state));
-	return true;
+	// the probe side is scanned after the build has finished: enable the join key filters in its table scan
+	for (auto &join_key_filter : join_key_filters) {
+		join_key_filter->Publish();
+	}
+
+	auto &scheduler = TaskScheduler::GetScheduler(context);
+	idx_t num_threads = scheduler.NumberOfThreads();
+	idx_t block_count = ht.BlockCount();
+	if (ht.IsExternal() || num_threads == 1 || block_count < 2 * MINIMUM_BLOCKS_PER_FINALIZE_TASK) {
+		// construct the pointer table on this thread
+		ht.Finalize();
+		return true;
+	}
+	// construct the pointer table in parallel: every task inserts the entries of a range of blocks
+	ht.InitializePointerTable();
+	idx_t blocks_per_task =
+	    MaxValue<idx_t>((block_count + num_threads - 1) / num_threads, MINIMUM_BLOCKS_PER_FINALIZE_TASK);
+	idx_t task_count = (block_count + blocks_per_task - 1) / blocks_per_task;
+	pipeline.total_tasks += task_count;
+	for (idx_t block_idx = 0; block_idx < block_count; block_idx += blocks_per_task) {
+		auto block_idx_end = MinValue<idx_t>(block_idx + blocks_per_task, block_count);
+		auto new_task = make_unique<HashJoinFinalizeTask>(pipeline, ht, block_idx, block_idx_end);
+		scheduler.ScheduleTask(pipeline.token, move(new_task));
+	}
+	return false;
+}
+
+bool PhysicalHashJoin::IsExternal() const {
+	if (!sink_state) {
+		return false;
+	}
+	auto &sink = (HashJoinGlobalState &)*sink_state;
+	return sink.hash_table->IsExternal();
 }
 
 //===--------------------------------------------------------------------===//
@@ -167,18 +233,41 @@ public:
 	DataChunk join_keys;
 	ExpressionExecutor probe_executor;
 	unique_ptr<JoinHashTable::ScanStructure> scan_structure;
+
+	//! External hash join only: the chunk fetched from the probe side and its join keys
+	DataChunk probe_input;
+	DataChunk probe_keys;
+	//! External hash join only: whether or not the probe side has been exhausted
+	bool probe_side_finished = false;
+	//! External hash join only: whether or not the unmatched tuples of the loaded partition have been scanned
+	bool full_outer_finished = false;
+	//! External hash join only: the scan over the spilled probe side rows of the loaded partition
+	SpillableChunkScanState spill_scan_state;
+	//! External hash join only: a chunk of spilled probe side rows (payload followed by the join keys)
+	DataChunk spill_chunk;
 };
 
 unique_ptr<PhysicalOperatorState> PhysicalHashJoin::GetOperatorState() {
 	auto state = make_unique<PhysicalHashJoinState>(*this, children[0].get(), children[1].get(), conditions);
 	state->cached_chunk.Initialize(types);
 	state->join_keys.Initialize(condition_types);
+	state->probe_keys.Initialize(condition_types);
 	for (auto &cond : conditions) {
 		state->probe_executor.AddExpression(*cond.left);
 	}
 	return move(state);
 }
 
+//! Empties the chunk cache after it has been handed out. Appending to the cache only copies the NULLs of the input,
+//! so the validity masks are cleared: otherwise NULLs of a previous round (e.g. the NULL-padded rows of an outer
+//! join) would remain set. The data itself is shared with the handed out chunk and is left untouched.
+static void ResetCachedChunk(DataChunk &cached_chunk) {
+	for (idx_t i = 0; i < cached_chunk.ColumnCount(); i++) {
+		FlatVector::Validity(cached_chunk.data[i]).Reset();
+	}
+	cached_chunk.SetCardinality(0);
+}
+
 void PhysicalHashJoin::GetChunkInternal(ExecutionContext &context, DataChunk &chunk,
                                         PhysicalOperatorState *state_p) const {
 	auto state = reinterpret_cast<PhysicalHashJoinState *>(state_p);
@@ -198,7 +287,7 @@ void PhysicalHashJoin::GetChunkInternal(ExecutionContext &context, DataChunk &ch
 			if (state->cached_chunk.size() > 0) {
 				// finished probing but cached data remains, return cached chunk
 				chunk.Reference(state->cached_chunk);
-				state->cached_chunk.SetCardinality(0);
+				ResetCachedChunk(state->cached_chunk);
 			} else
 #endif
 			    if (IsRightOuterJoin(join_type)) {
@@ -214,7 +303,7 @@ void PhysicalHashJoin::GetChunkInternal(ExecutionContext &context, DataChunk &ch
 				if (state->cached_chunk.size() >= (STANDARD_VECTOR_SIZE - 64)) {
 					// chunk cache full: return it
 					chunk.Reference(state->cached_chunk);
-					state->cached_chunk.SetCardinality(0);
+					ResetCachedChunk(state->cached_chunk);
 					return;
 				} else {
 					// chunk cache not full: probe again
@@ -234,6 +323,10 @@ void PhysicalHashJoin::ProbeHashTable(ExecutionContext &context, DataChunk &chun
                                       PhysicalOperatorState *state_p) const {
 	auto state = reinterpret_cast<PhysicalHashJoinState *>(state_p);
 	auto &sink = (HashJoinGlobalState &)*sink_state;
+	if (sink.hash_table->IsExternal()) {
+		ProbeExternalHashTable(context, chunk, state_p);
+		return;
+	}
 
 	if (state->child_chunk.size() > 0 && state->scan_structure) {
 		// still have elements remaining from the previous probe (i.e. we got
@@ -264,6 +357,85 @@ void PhysicalHashJoin::ProbeHashTable(ExecutionContext &context, DataChunk &chun
 		state->scan_structure->Next(state->join_keys, state->child_chunk, chunk);
 	} while (chunk.size() == 0);
 }
+void PhysicalHashJoin::ProbeExternalHashTable(ExecutionContext &context, DataChunk &chunk,
+                                              PhysicalOperatorState *state_p) const {
+	auto state = reinterpret_cast<PhysicalHashJoinState *>(state_p);
+	auto &sink = (HashJoinGlobalState &)*sink_state;
+	auto &ht = *sink.hash_table;
+
+	if (state->child_chunk.size() > 0 && state->scan_structure) {
+		// still have elements remaining from the previous probe
+		state->scan_structure->Next(state->join_keys, state->child_chunk, chunk);
+		if (chunk.size() > 0) {
+			return;
+		}
+		state->scan_structure = nullptr;
+	}
+
+	do {
+		if (!state->probe_side_finished) {
+			// fetch the chunk from the left side
+			if (state->probe_input.ColumnCount() == 0) {
+				state->probe_input.Initialize(children[0]->GetTypes());
+			}
+			state->probe_input.Reset();
+			children[0]->GetChunk(context, state->probe_input, state->child_state.get());
+			if (state->probe_input.size() == 0) {
+				state->probe_side_finished = true;
+				continue;
+			}
+			// resolve the join keys, and spill the rows that do not belong to the loaded partition
+			state->probe_keys.Reset();
+			state->probe_executor.Execute(state->probe_input, state->probe_keys);
+			SelectionVector sel(STANDARD_VECTOR_SIZE);
+			auto partition_count = ht.PartitionProbeSide(state->probe_keys, state->probe_input, sel);
+			if (partition_count == 0) {
+				continue;
+			}
+			state->child_chunk.Reset();
+			state->child_chunk.Slice(state->probe_input, sel, partition_count);
+			state->join_keys.Reset();
+			state->join_keys.Slice(state->probe_keys, sel, partition_count);
+		} else if (ht.GetProbePartition().Scan(state->spill_scan_state, state->spill_chunk)) {
+			// probe the loaded partition with the spilled rows of the probe side
+			idx_t payload_count = state->child_chunk.ColumnCount();
+			state->child_chunk.Reset();
+			for (idx_t i = 0; i < payload_count; i++) {
+				state->child_chunk.data[i].Reference(state->spill_chunk.data[i]);
+			}
+			state->child_chunk.SetCardinality(state->spill_chunk);
+			state->join_keys.Reset();
+			for (idx_t i = 0; i < state->join_keys.ColumnCount(); i++) {
+				state->join_keys.data[i].Reference(state->spill_chunk.data[payload_count + i]);
+			}
+			state->join_keys.SetCardinality(state->spill_chunk);
+		} else {
+			// the loaded partition has been probed with all rows of the probe side
+			if (IsRightOuterJoin(join_type) && !state->full_outer_finished) {
+				// scan the unmatched tuples from the RHS of this partition
+				ht.ScanFullOuter(chunk, sink.ht_scan_state);
+				if (chunk.size() > 0) {
+					return;
+				}
+				state->full_outer_finished = true;
+			}
+			// move on to the next partition
+			if (!ht.LoadNextPartition()) {
+				return;
+			}
+			state->full_outer_finished = false;
+			state->spill_scan_state = SpillableChunkScanState();
+			sink.ht_scan_state.position = 0;
+			sink.ht_scan_state.block_position = 0;
+			continue;
+		}
+
+		// perform the actual probe
+		state->scan_structure = ht.Probe(state->join_keys);
+		state->scan_structure->Next(state->join_keys, state->child_chunk, chunk);
+	} while (chunk.size() == 0);
+}
+
 void PhysicalHashJoin::FinalizeOperatorState(PhysicalOperatorState &state, ExecutionContext &context) {
 	auto &state_p = reinterpret_cast<PhysicalHashJoinState &>(state);
 	context.thread.profiler.Flush(this, &state_p.probe_executor, "probe_executor", 0);
@@ -913,6 +913,10 @@ void BufferedCSVReader::ParseComplexCSV(DataChunk &insert_chunk) {
 value_start:
 	/* state: value_start */
 	// this state parses the first characters of a value
+	if (column == 0 && RangeExhausted()) {
+		// the next row starts outside of the range of this reader: finish parsing
+		goto final_state;
+	}
 	offset = 0;
 	delimiter_pos = 0;
 	quote_pos = 0;
@@ -1134,6 +1138,10 @@ value_start:
 	offset = 0;
 	/* state: value_start */
 	// this state parses the first character of a value
+	if (column == 0 && RangeExhausted()) {
+		// the next row starts outside of the range of this reader: finish parsing
+		goto final_state;
+	}
 	if (buffer[position] == options.quote[0]) {
 		// quote: actual value starts in the next position
 		// move to in_quotes state
@@ -1304,6 +1312,10 @@ bool BufferedCSVReader::ReadBuffer(idx_t &start) {
 	if (remaining + buffer_read_size > MAXIMUM_CSV_LINE_SIZE) {
 		throw InvalidInputException("Maximum line size of %llu bytes exceeded!", MAXIMUM_CSV_LINE_SIZE);
 	}
+	if (plain_file_source) {
+		// keep track of where the buffer starts within the file
+		buffer_offset = file_handle->SeekPosition() - remaining;
+	}
 	buffer = unique_ptr<char[]>(new char[buffer_read_size + remaining + 1]);
 	buffer_size = remaining + buffer_read_size;
 	if (remaining > 0) {
@@ -1330,6 +1342,45 @@ bool BufferedCSVReader::ReadBuffer(idx_t &start) {
 	return read_count > 0;
 }
 
+void BufferedCSVReader::SetRange(idx_t range_start, idx_t range_end_p) {
+	D_ASSERT(plain_file_source);
+	D_ASSERT(!options.auto_detect);
+	range_end = range_end_p;
+	if (range_start == 0) {
+		// the range starts at the beginning of the file: the header (if any) has already been skipped
+		return;
+	}
+	// seek to the byte before the start of the range, so that we can detect whether a row starts exactly at the start
+	ResetBuffer();
+	file_handle->Seek(range_start - 1);
+	bom_checked = true;
+	// the line numbers are not known when reading a range
+	linenr_estimated = true;
+	// skip the remainder of the row that the range starts in
+	for (;; position++) {
+		if (position >= buffer_size) {
+			start = position;
+			if (!ReadBuffer(start)) {
+				return;
+			}
+		}
+		if (StringUtil::CharacterIsNewline(buffer[position])) {
+			break;
+		}
+	}
+	bool carriage_return = buffer[position] == '\r';
+	start = ++position;
+	if (carriage_return) {
+		// \r newline, skip an optional \n afterwards
+		if (position >= buffer_size && !ReadBuffer(start)) {
+			return;
+		}
+		if (buffer[position] == '\n') {
+			start = ++position;
+		}
+	}
+}
+
 void BufferedCSVReader::ParseCSV(DataChunk &insert_chunk) {
 	// if no auto-detect or auto-detect with jumping samples, we have nothing cached and start from the beginning
 	if (cached_chunks.empty()) {
@@ -1,25 +1,55 @@
 #include "duckdb/execution/operator/persistent/physical_copy_to_file.hpp"
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/pair.hpp"
+#include "duckdb/common/types/chunk_collection.hpp"
+#include "duckdb/common/unordered_map.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 
 #include <algorithm>
+#include <map>
 
 namespace duckdb {
 
+//! The amount of rows a thread buffers before the copy function serializes them
+static constexpr idx_t COPY_TO_BATCH_SIZE = 100000;
+
 class CopyToFunctionGlobalState : public GlobalOperatorState {
 public:
 	explicit CopyToFunctionGlobalState(unique_ptr<GlobalFunctionData> global_state)
-	    : rows_copied(0), global_state(move(global_state)) {
+	    : rows_copied(0), global_state(move(global_state)), batch_sequence(0), thread_count(0) {
 	}
 
-	idx_t rows_copied;
+	atomic<idx_t> rows_copied;
 	unique_ptr<GlobalFunctionData> global_state;
+
+	//! Lock protecting the prepared batches and the active batches
+	mutex lock;
+	//! Lock held by the thread that is appending prepared batches to the file
+	mutex flush_lock;
+	//! The prepared batches that have not been written yet, ordered by (batch index, sequence number)
+	std::map<pair<idx_t, idx_t>, unique_ptr<PreparedBatchData>> prepared_batches;
+	//! The sequence number of the next prepared batch
+	idx_t batch_sequence;
+	//! The batch index that every active thread is currently writing
+	unordered_map<idx_t, idx_t> active_batches;
+	//! The amount of threads that have started writing
+	idx_t thread_count;
 };
 
 class CopyToFunctionLocalState : public LocalSinkState {
 public:
-	explicit CopyToFunctionLocalState(unique_ptr<LocalFunctionData> local_state) : local_state(move(local_state)) {
+	explicit CopyToFunctionLocalState(unique_ptr<LocalFunctionData> local_state)
+	    : local_state(move(local_state)), thread_index(0), current_batch(0) {
 	}
 	unique_ptr<LocalFunctionData> local_state;
+
+	//! The index of this thread in the set of active threads (parallel write only)
+	idx_t thread_index;
+	//! The batch that is currently being buffered (parallel write only)
+	idx_t current_batch;
+	//! The buffered rows of the current batch (parallel write only)
+	unique_ptr<ChunkCollection> collection;
 };
 
 void PhysicalCopyToFile::GetChunkInternal(ExecutionContext &context, DataChunk &chunk,
@@ -32,25 +62,111 @@ void PhysicalCopyToFile::GetChunkInternal(ExecutionContext &context, DataChunk &
 	state->finished = true;
 }
 
+//===--------------------------------------------------------------------===//
+// Parallel Write
+//===--------------------------------------------------------------------===//
+//! Appends the prepared batches that are next in line to the file. A prepared batch can be written once all threads
+//! have moved past its batch: the batches of a parallel scan are handed out in increasing order, so any lower batch
+//! that has not been prepared by then did not produce any rows.
+static void FlushPreparedBatches(ClientContext &context, const PhysicalCopyToFile &op, CopyToFunctionGlobalState &g,
+                                 bool force) {
+	unique_lock<mutex> flush_guard(g.flush_lock, std::defer_lock);
+	if (force) {
+		flush_guard.lock();
+	} else if (!flush_guard.try_lock()) {
+		// another thread is writing to the file: it (or the next flush) picks up our batches
+		return;
+	}
+	while (true) {
+		unique_ptr<PreparedBatchData> batch;
+		{
+			lock_guard<mutex> glock(g.lock);
+			if (g.prepared_batches.empty()) {
+				return;
+			}
+			auto entry = g.prepared_batches.begin();
+			for (auto &active : g.active_batches) {
+				if (active.second < entry->first.first) {
+					// a thread might still produce rows that precede this batch
+					return;
+				}
+			}
+			batch = move(entry->second);
+			g.prepared_batches.erase(entry);
+		}
+		// only the append itself is serialized: the batch was serialized by the thread that produced it
+		op.function.copy_to_flush_batch(context, *op.bind_data, *g.global_state, *batch);
+	}
+}
+
+static void PrepareBatch(ClientContext &context, const PhysicalCopyToFile &op, CopyToFunctionGlobalState &g,
+                         CopyToFunctionLocalState &l, idx_t next_batch, bool finished) {
+	unique_ptr<PreparedBatchData> batch;
+	if (l.collection && l.collection->Count() > 0) {
+		batch = op.function.copy_to_prepare_batch(context, *op.bind_data, *g.global_state, *l.collection);
+	}
+	l.collection.reset();
+	{
+		lock_guard<mutex> glock(g.lock);
+		if (batch) {
+			g.prepared_batches[make_pair(l.current_batch, g.batch_sequence++)] = move(batch);
+		}
+		// the batch is handed over and the thread moves on in the same step, so no rows can be overtaken
+		if (finished) {
+			g.active_batches.erase(l.thread_index);
+		} else {
+			g.active_batches[l.thread_index] = next_batch;
+		}
+	}
+	l.current_batch = next_batch;
+	FlushPreparedBatches(context, op, g, false);
+}
+
+//===--------------------------------------------------------------------===//
+// Sink
+//===--------------------------------------------------------------------===//
 void PhysicalCopyToFile::Sink(ExecutionContext &context, GlobalOperatorState &gstate, LocalSinkState &lstate,
                               DataChunk &input) const {
 	auto &g = (CopyToFunctionGlobalState &)gstate;
 	auto &l = (CopyToFunctionLocalState &)lstate;
 
 	g.rows_copied += input.size();
-	function.copy_to_sink(context.client, *bind_data, *g.global_state, *l.local_state, input);
+	if (!SupportsParallelWrite()) {
+		function.copy_to_sink(context.client, *bind_data, *g.global_state, *l.local_state, input);
+		return;
+	}
+	if (l.batch_index != l.current_batch) {
+		// the input belongs to a new batch: serialize the rows of the previous batch
+		PrepareBatch(context.client, *this, g, l, l.batch_index, false);
+	}
+	if (!l.collection) {
+		l.collection = make_unique<ChunkCollection>();
+	}
+	l.collection->Append(input);
+	if (l.collection->Count() >= COPY_TO_BATCH_SIZE) {
+		PrepareBatch(context.client, *this, g, l, l.current_batch, false);
+	}
 }
 
 void PhysicalCopyToFile::Combine(ExecutionContext &context, GlobalOperatorState &gstate, LocalSinkState &lstate) {
 	auto &g = (CopyToFunctionGlobalState &)gstate;
 	auto &l = (CopyToFunctionLocalState &)lstate;
 
+	if (SupportsParallelWrite()) {
+		PrepareBatch(context.client, *this, g, l, l.current_batch, true);
+		return;
+	}
 	if (function.copy_to_combine) {
 		function.copy_to_combine(context.client, *bind_data, *g.global_state, *l.local_state);
 	}
 }
 bool PhysicalCopyToFile::Finalize(Pipeline &pipeline, ClientContext &context, unique_ptr<GlobalOperatorState> gstate) {
 	auto g = (CopyToFunctionGlobalState *)gstate.get();
+	if (SupportsParallelWrite()) {
+		// all threads are done: write any batches that are left
+		FlushPreparedBatches(context, *this, *g, true);
+		D_ASSERT(g->prepared_batches.empty());
+	}
 	if (function.copy_to_finalize) {
 		function.copy_to_finalize(context, *bind_data, *g->global_state);
 	}
@@ -59,8 +175,25 @@ bool PhysicalCopyToFile::Finalize(Pipeline &pipeline, ClientContext &context, un
 }
 
 unique_ptr<LocalSinkState> PhysicalCopyToFile::GetLocalSinkState(ExecutionContext &context) {
+	if (SupportsParallelWrite()) {
+		return make_unique<CopyToFunctionLocalState>(nullptr);
+	}
 	return make_unique<CopyToFunctionLocalState>(function.copy_to_initialize_local(context.client, *bind_data));
 }
+
+void PhysicalCopyToFile::InitializeLocalSinkState(ExecutionContext &context, GlobalOperatorState &gstate,
+                                                  LocalSinkState &lstate) const {
+	if (!SupportsParallelWrite()) {
+		return;
+	}
+	auto &g = (CopyToFunctionGlobalState &)gstate;
+	auto &l = (CopyToFunctionLocalState &)lstate;
+	lock_guard<mutex> glock(g.lock);
+	// the batch index of the first rows of this thread is not known yet: hold back all batches until it is
+	l.thread_index = g.thread_count++;
+	g.active_batches[l.thread_index] = 0;
+}
+
 unique_ptr<GlobalOperatorState> PhysicalCopyToFile::GetGlobalState(ClientContext &context) {
 	return make_unique<CopyToFunctionGlobalState>(function.copy_to_initialize_global(context, *bind_data));
 }
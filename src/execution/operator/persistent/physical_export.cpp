@@ -63,6 +63,10 @@ static void WriteCopyStatement(FileSystem &fs, stringstream &ss, TableCatalogEnt
 		}
 	}
 	for (auto &copy_option : info.options) {
+		if (StringUtil::Lower(copy_option.first) == "preserve_order") {
+			// only applies to writing the data
+			continue;
+		}
 		ss << ", " << copy_option.first << " ";
 		if (copy_option.second.size() == 1) {
 			WriteValueAsSQL(ss, copy_option.second[0]);
@@ -1,7 +1,6 @@
 #include "duckdb/execution/operator/persistent/physical_insert.hpp"
 #include "duckdb/parallel/thread_context.hpp"
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
-#include "duckdb/common/types/chunk_collection.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/storage/data_table.hpp"
@@ -19,6 +18,8 @@ public:
 
 	mutex lock;
 	idx_t insert_count;
+	//! The state of the ordered append of the row groups (parallel insert only)
+	BatchAppendState append_state;
 };
 
 class InsertLocalState : public LocalSinkState {
@@ -30,6 +31,10 @@ public:
 
 	DataChunk insert_chunk;
 	ExpressionExecutor default_executor;
+	//! The rows inserted by this thread that have not been handed over yet (parallel insert only)
+	LocalBatchAppendState append_state;
+	//! The amount of rows inserted by this thread (parallel insert only)
+	idx_t insert_count = 0;
 };
 
 void PhysicalInsert::Sink(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate,
@@ -63,6 +68,13 @@ void PhysicalInsert::Sink(ExecutionContext &context, GlobalOperatorState &state,
 		}
 	}
 
+	if (parallel) {
+		// parallel insert: gather the rows of every batch locally and append them to the table without the global lock
+		table->storage->LocalBatchAppend(*table, context.client, istate.insert_chunk, istate.batch_index,
+		                                 gstate.append_state, istate.append_state);
+		istate.insert_count += chunk.size();
+		return;
+	}
 	lock_guard<mutex> glock(gstate.lock);
 	table->storage->Append(*table, context.client, istate.insert_chunk);
 	gstate.insert_count += chunk.size();
@@ -76,6 +88,16 @@ unique_ptr<LocalSinkState> PhysicalInsert::GetLocalSinkState(ExecutionContext &c
 	return make_unique<InsertLocalState>(table->GetTypes(), bound_defaults);
 }
 
+void PhysicalInsert::InitializeLocalSinkState(ExecutionContext &context, GlobalOperatorState &gstate_p,
+                                              LocalSinkState &lstate) const {
+	if (!parallel) {
+		return;
+	}
+	auto &gstate = (InsertGlobalState &)gstate_p;
+	auto &state = (InsertLocalState &)lstate;
+	table->storage->InitializeBatchAppend(gstate.append_state, state.append_state);
+}
+
 //===--------------------------------------------------------------------===//
 // GetChunkInternal
 //===--------------------------------------------------------------------===//
@@ -87,10 +109,27 @@ void PhysicalInsert::GetChunkInternal(ExecutionContext &context, DataChunk &chun
 
 	state->finished = true;
 }
-void PhysicalInsert::Combine(ExecutionContext &context, GlobalOperatorState &gstate, LocalSinkState &lstate) {
+void PhysicalInsert::Combine(ExecutionContext &context, GlobalOperatorState &gstate_p, LocalSinkState &lstate) {
+	auto &gstate = (InsertGlobalState &)gstate_p;
 	auto &state = (InsertLocalState &)lstate;
+	if (parallel) {
+		// hand over the remaining rows of this thread
+		table->storage->FinishBatchAppend(context.client, gstate.append_state, state.append_state);
+		lock_guard<mutex> glock(gstate.lock);
+		gstate.insert_count += state.insert_count;
+	}
 	context.thread.profiler.Flush(this, &state.default_executor, "default_executor", 1);
 	context.client.profiler->Flush(context.thread.profiler);
 }
 
+bool PhysicalInsert::Finalize(Pipeline &pipeline, ClientContext &context, unique_ptr<GlobalOperatorState> gstate_p) {
+	auto &gstate = (InsertGlobalState &)*gstate_p;
+	if (parallel) {
+		// all threads are done: merge the rows that are left into the table
+		table->storage->FinalizeBatchAppend(context, gstate.append_state);
+	}
+	PhysicalSink::Finalize(pipeline, context, move(gstate_p));
+	return true;
+}
+
 } // namespace duckdb
@@ -24,7 +24,13 @@ void PhysicalProjection::GetChunkInternal(ExecutionContext &context, DataChunk &
 		return;
 	}
 
-	state->executor.Execute(state->child_chunk, chunk);
+	ExecuteInternal(context, state->child_chunk, chunk, state_p);
+}
+
+void PhysicalProjection::ExecuteInternal(ExecutionContext &context, DataChunk &input, DataChunk &chunk,
+                                         PhysicalOperatorState *state_p) const {
+	auto state = reinterpret_cast<PhysicalProjectionState *>(state_p);
+	state->executor.Execute(input, chunk);
 }
 
 unique_ptr<PhysicalOperatorState> PhysicalProjection::GetOperatorState() {
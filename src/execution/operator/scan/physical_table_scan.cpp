@@ -96,6 +96,19 @@ void PhysicalTableScan::GetChunkInternal(ExecutionContext &context, DataChunk &c
 	}
 }
 
+bool PhysicalTableScan::SupportsBatchIndex() const {
+	return function.max_threads && function.get_batch_index;
+}
+
+idx_t PhysicalTableScan::GetBatchIndex(ExecutionContext &context, PhysicalOperatorState *state_p) const {
+	auto &state = (PhysicalTableScanOperatorState &)*state_p;
+	if (!state.parallel_state || !state.operator_data || !function.get_batch_index) {
+		// sequential scan (or a scan that cannot tell its batches apart): all data belongs to a single batch
+		return 0;
+	}
+	return function.get_batch_index(context.client, bind_data.get(), state.operator_data.get(), state.parallel_state);
+}
+
 string PhysicalTableScan::GetName() const {
 	return StringUtil::Upper(function.name);
 }
@@ -23,6 +23,8 @@ public:
 	mutex append_lock;
 	TableCatalogEntry *table;
 	int64_t inserted_count;
+	//! The state of the ordered append of the row groups
+	BatchAppendState append_state;
 };
 
 unique_ptr<GlobalOperatorState> PhysicalCreateTableAs::GetGlobalState(ClientContext &context) {
@@ -32,14 +34,62 @@ unique_ptr<GlobalOperatorState> PhysicalCreateTableAs::GetGlobalState(ClientCont
 	return move(sink);
 }
 
+class CreateTableAsLocalState : public LocalSinkState {
+public:
+	CreateTableAsLocalState() : inserted_count(0) {
+	}
+
+	//! The rows inserted by this thread that have not been handed over yet
+	LocalBatchAppendState append_state;
+	//! The amount of rows inserted by this thread
+	int64_t inserted_count;
+};
+
+unique_ptr<LocalSinkState> PhysicalCreateTableAs::GetLocalSinkState(ExecutionContext &context) {
+	return make_unique<CreateTableAsLocalState>();
+}
+
+void PhysicalCreateTableAs::InitializeLocalSinkState(ExecutionContext &context, GlobalOperatorState &gstate,
+                                                     LocalSinkState &lstate_p) const {
+	auto &sink = (CreateTableAsGlobalState &)gstate;
+	auto &lstate = (CreateTableAsLocalState &)lstate_p;
+	if (sink.table) {
+		sink.table->storage->InitializeBatchAppend(sink.append_state, lstate.append_state);
+	}
+}
+
 void PhysicalCreateTableAs::Sink(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate_p,
                                  DataChunk &input) const {
 	auto &sink = (CreateTableAsGlobalState &)state;
+	auto &lstate = (CreateTableAsLocalState &)lstate_p;
+	if (sink.table) {
+		// gather the rows of every batch locally and append them to the table without the global lock
+		sink.table->storage->LocalBatchAppend(*sink.table, context.client, input, lstate.batch_index,
+		                                      sink.append_state, lstate.append_state);
+		lstate.inserted_count += input.size();
+	}
+}
+
+void PhysicalCreateTableAs::Combine(ExecutionContext &context, GlobalOperatorState &gstate, LocalSinkState &lstate_p) {
+	auto &sink = (CreateTableAsGlobalState &)gstate;
+	auto &lstate = (CreateTableAsLocalState &)lstate_p;
 	if (sink.table) {
+		// hand over the remaining rows of this thread
+		sink.table->storage->FinishBatchAppend(context.client, sink.append_state, lstate.append_state);
 		lock_guard<mutex> client_guard(sink.append_lock);
-		sink.table->storage->Append(*sink.table, context.client, input);
-		sink.inserted_count += input.size();
+		sink.inserted_count += lstate.inserted_count;
+	}
+}
+
+bool PhysicalCreateTableAs::Finalize(Pipeline &pipeline, ClientContext &context,
+                                     unique_ptr<GlobalOperatorState> gstate) {
+	auto &sink = (CreateTableAsGlobalState &)*gstate;
+	if (sink.table) {
+		// all threads are done: merge the rows that are left into the table
+		sink.table->storage->FinalizeBatchAppend(context, sink.append_state);
 	}
+	PhysicalSink::Finalize(pipeline, context, move(gstate));
+	return true;
 }
 
 //===--------------------------------------------------------------------===//
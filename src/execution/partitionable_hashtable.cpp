@@ -49,7 +49,7 @@ PartitionableHashTable::PartitionableHashTable(BufferManager &buffer_manager_p,
                                                vector<BoundAggregateExpression *> bindings_p)
     : buffer_manager(buffer_manager_p), group_types(move(group_types_p)), payload_types(move(payload_types_p)),
       bindings(move(bindings_p)), is_partitioned(false), partition_info(partition_info_p), hashes(LogicalType::HASH),
-      hashes_subset(LogicalType::HASH) {
+      hashes_subset(LogicalType::HASH), is_spilling(false) {
 
 	sel_vectors.resize(partition_info.n_partitions);
 	sel_vector_sizes.resize(partition_info.n_partitions);
@@ -116,8 +116,24 @@ idx_t PartitionableHashTable::AddChunk(DataChunk &groups, DataChunk &payload, bo
 	for (hash_t r = 0; r < partition_info.n_partitions; r++) {
 		group_subset.Slice(groups, sel_vectors[r], sel_vector_sizes[r]);
 		payload_subset.Slice(payload, sel_vectors[r], sel_vector_sizes[r]);
-		hashes_subset.Slice(hashes, sel_vectors[r], sel_vector_sizes[r]);
 
+		if (IsSpilling()) {
+			if (sel_vector_sizes[r] == 0) {
+				continue;
+			}
+			// the rows are aggregated when the partition is finalized, we do not know yet how many groups they add
+			idx_t col_idx = 0;
+			for (idx_t i = 0; i < group_subset.ColumnCount(); i++) {
+				spill_chunk.data[col_idx++].Reference(group_subset.data[i]);
+			}
+			for (idx_t i = 0; i < payload_subset.ColumnCount(); i++) {
+				spill_chunk.data[col_idx++].Reference(payload_subset.data[i]);
+			}
+			spill_chunk.SetCardinality(sel_vector_sizes[r]);
+			spilled_partitions[r]->Append(spill_chunk);
+			continue;
+		}
+		hashes_subset.Slice(hashes, sel_vectors[r], sel_vector_sizes[r]);
 		group_count += ListAddChunk(radix_partitioned_hts[r], group_subset, hashes_subset, payload_subset);
 	}
 	return group_count;
@@ -157,7 +173,61 @@ HashTableList PartitionableHashTable::GetUnpartitioned() {
 	return move(unpartitioned_hts);
 }
 
+void PartitionableHashTable::Spill() {
+	D_ASSERT(IsPartitioned());
+	D_ASSERT(!IsSpilling());
+	// the hash tables will not receive any new groups: release their hashes
+	Finalize();
+
+	auto spill_types = group_types;
+	spill_types.insert(spill_types.end(), payload_types.begin(), payload_types.end());
+	spill_chunk.InitializeEmpty(spill_types);
+	for (idx_t r = 0; r < partition_info.n_partitions; r++) {
+		spilled_partitions.push_back(make_unique<SpillableChunkCollection>(buffer_manager));
+	}
+	is_spilling = true;
+}
+
+bool PartitionableHashTable::IsSpilling() {
+	return is_spilling;
+}
+
+unique_ptr<SpillableChunkCollection> PartitionableHashTable::GetSpilledPartition(idx_t partition) {
+	if (!IsSpilling()) {
+		return nullptr;
+	}
+	D_ASSERT(partition < spilled_partitions.size());
+	return move(spilled_partitions[partition]);
+}
+
+idx_t PartitionableHashTable::SizeInBytes() {
+	idx_t size = 0;
+	for (auto &ht : unpartitioned_hts) {
+		size += ht->SizeInBytes();
+	}
+	for (auto &ht_list : radix_partitioned_hts) {
+		for (auto &ht : ht_list.second) {
+			size += ht->SizeInBytes();
+		}
+	}
+	return size;
+}
+
+idx_t PartitionableHashTable::SpilledSizeInBytes() {
+	idx_t size = 0;
+	for (auto &spilled : spilled_partitions) {
+		if (spilled) {
+			size += spilled->SizeInBytes();
+		}
+	}
+	return size;
+}
+
 void PartitionableHashTable::Finalize() {
+	if (IsSpilling()) {
+		// the hash tables were already finalized when we started spilling
+		return;
+	}
 	if (IsPartitioned()) {
 		for (auto &ht_list : radix_partitioned_hts) {
 			for (auto &ht : ht_list.second) {
@@ -44,6 +44,26 @@ void PhysicalOperator::GetChunk(ExecutionContext &context, DataChunk &chunk, Phy
 	chunk.Verify();
 }
 
+void PhysicalOperator::ExecuteInternal(ExecutionContext &context, DataChunk &input, DataChunk &chunk,
+                                       PhysicalOperatorState *state) const {
+	throw InternalException("Execute called on non-streaming operator %s", GetName());
+}
+
+void PhysicalOperator::Execute(ExecutionContext &context, DataChunk &input, DataChunk &chunk,
+                               PhysicalOperatorState *state) const {
+	D_ASSERT(IsStreaming());
+	if (context.client.interrupted) {
+		throw InterruptException();
+	}
+	chunk.Reset();
+
+	context.thread.profiler.StartOperator(this);
+	ExecuteInternal(context, input, chunk, state);
+	context.thread.profiler.EndOperator(&chunk);
+
+	chunk.Verify();
+}
+
 void PhysicalOperator::Print() {
 	Printer::Print(ToString());
 }
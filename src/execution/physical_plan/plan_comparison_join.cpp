@@ -7,6 +7,8 @@
 #include "duckdb/execution/physical_plan_generator.hpp"
 #include "duckdb/function/table/table_scan.hpp"
 #include "duckdb/main/client_context.hpp"
+#include "duckdb/planner/expression/bound_reference_expression.hpp"
+#include "duckdb/planner/filter/join_key_filter.hpp"
 #include "duckdb/planner/operator/logical_comparison_join.hpp"
 #include "duckdb/transaction/transaction.hpp"
 
@@ -65,6 +67,43 @@ void TransformIndexJoin(ClientContext &context, LogicalComparisonJoin &op, Index
 	}
 }
 
+//! Pushes filters on the join keys into a table scan on the probe side of the hash join, the filters are filled with the
+//! range and a bloom filter of the build keys while the hash table is built
+static void PushJoinKeyFilters(PhysicalHashJoin &join) {
+	if (join.join_type != JoinType::INNER && join.join_type != JoinType::SEMI && join.join_type != JoinType::RIGHT) {
+		// only joins that discard the probe rows without a join partner
+		return;
+	}
+	auto &probe = *join.children[0];
+	if (probe.type != PhysicalOperatorType::TABLE_SCAN) {
+		return;
+	}
+	auto &scan = (PhysicalTableScan &)probe;
+	if (scan.function.name != "seq_scan" || !scan.function.filter_pushdown) {
+		return;
+	}
+	for (idx_t cond_idx = 0; cond_idx < join.conditions.size(); cond_idx++) {
+		auto &cond = join.conditions[cond_idx];
+		if (cond.comparison != ExpressionType::COMPARE_EQUAL || cond.null_values_are_equal) {
+			continue;
+		}
+		if (cond.left->type != ExpressionType::BOUND_REF || !JoinKeyFilter::SupportsType(cond.left->return_type)) {
+			continue;
+		}
+		auto column_index = ((BoundReferenceExpression &)*cond.left).index;
+		if (scan.column_ids[column_index] == COLUMN_IDENTIFIER_ROW_ID) {
+			continue;
+		}
+		auto join_key_filter = make_unique<JoinKeyFilter>(cond.left->return_type);
+		join.join_key_filters.push_back(join_key_filter.get());
+		join.join_key_filter_conditions.push_back(cond_idx);
+		if (!scan.table_filters) {
+			scan.table_filters = make_unique<TableFilterSet>();
+		}
+		scan.table_filters->PushFilter(column_index, move(join_key_filter));
+	}
+}
+
 unique_ptr<PhysicalOperator> PhysicalPlanGenerator::CreatePlan(LogicalComparisonJoin &op) {
 	// now visit the children
 	D_ASSERT(op.children.size() == 2);
@@ -115,9 +154,11 @@ unique_ptr<PhysicalOperator> PhysicalPlanGenerator::CreatePlan(LogicalComparison
 			                                      right_index, true, op.estimated_cardinality);
 		}
 		// equality join: use hash join
-		plan = make_unique<PhysicalHashJoin>(op, move(left), move(right), move(op.conditions), op.join_type,
-		                                     op.left_projection_map, op.right_projection_map, move(op.delim_types),
-		                                     op.estimated_cardinality);
+		auto hash_join = make_unique<PhysicalHashJoin>(op, move(left), move(right), move(op.conditions), op.join_type,
+		                                               op.left_projection_map, op.right_projection_map,
+		                                               move(op.delim_types), op.estimated_cardinality);
+		PushJoinKeyFilters(*hash_join);
+		plan = move(hash_join);
 	} else {
 		D_ASSERT(!has_null_equal_conditions); // don't support this for anything but hash joins for now
 		if (op.conditions.size() == 1 && !has_inequality) {
@@ -7,7 +7,8 @@ namespace duckdb {
 unique_ptr<PhysicalOperator> PhysicalPlanGenerator::CreatePlan(LogicalCopyToFile &op) {
 	auto plan = CreatePlan(*op.children[0]);
 	// COPY from select statement to file
-	auto copy = make_unique<PhysicalCopyToFile>(op.types, op.function, move(op.bind_data), op.estimated_cardinality);
+	auto copy = make_unique<PhysicalCopyToFile>(op.types, op.function, move(op.bind_data), op.preserve_order,
+	                                            op.estimated_cardinality);
 
 	copy->children.push_back(move(plan));
 	return move(copy);
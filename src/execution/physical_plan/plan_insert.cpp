@@ -1,11 +1,44 @@
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 #include "duckdb/execution/operator/persistent/physical_insert.hpp"
 #include "duckdb/execution/physical_plan_generator.hpp"
+#include "duckdb/function/table/table_scan.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
 #include "duckdb/planner/operator/logical_insert.hpp"
+#include "duckdb/storage/data_table.hpp"
 
 namespace duckdb {
 
+static bool ScansTable(LogicalOperator &op, TableCatalogEntry *table) {
+	if (op.type == LogicalOperatorType::LOGICAL_GET) {
+		auto &get = (LogicalGet &)op;
+		auto scan_data = dynamic_cast<TableScanBindData *>(get.bind_data.get());
+		if (scan_data && scan_data->table == table) {
+			return true;
+		}
+	}
+	for (auto &child : op.children) {
+		if (ScansTable(*child, table)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool CanInsertInParallel(LogicalInsert &op) {
+	if (op.children.empty()) {
+		return false;
+	}
+	if (!op.table->storage->info->indexes.Empty()) {
+		// indexes have to be maintained through the transaction-local storage
+		return false;
+	}
+	// the rows of a parallel insert become visible in the base table before the insert is finished
+	// if the insert reads from the table it inserts into, it might read its own rows
+	return !ScansTable(*op.children[0], op.table);
+}
+
 unique_ptr<PhysicalOperator> PhysicalPlanGenerator::CreatePlan(LogicalInsert &op) {
+	bool parallel = CanInsertInParallel(op);
 	unique_ptr<PhysicalOperator> plan;
 	if (!op.children.empty()) {
 		D_ASSERT(op.children.size() == 1);
@@ -14,7 +47,7 @@ unique_ptr<PhysicalOperator> PhysicalPlanGenerator::CreatePlan(LogicalInsert &op
 
 	dependencies.insert(op.table);
 	auto insert = make_unique<PhysicalInsert>(op.types, op.table, op.column_index_map, move(op.bound_defaults),
-	                                          op.estimated_cardinality);
+	                                          op.estimated_cardinality, parallel);
 	if (plan) {
 		insert->children.push_back(move(plan));
 	}
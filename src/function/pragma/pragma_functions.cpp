@@ -248,6 +248,10 @@ static void PragmaDebugCheckpointAbort(ClientContext &context, const FunctionPar
 	}
 }
 
+static void PragmaForceCompression(ClientContext &context, const FunctionParameters &parameters) {
+	DBConfig::GetConfig(context).force_compression = CompressionTypeFromString(parameters.values[0].ToString());
+}
+
 static void PragmaSetTempDirectory(ClientContext &context, const FunctionParameters &parameters) {
 	auto &buffer_manager = BufferManager::GetBufferManager(context);
 	buffer_manager.SetTemporaryDirectory(parameters.values[0].ToString());
@@ -326,6 +330,9 @@ void PragmaFunctions::RegisterFunction(BuiltinFunctions &set) {
 	set.AddFunction(
 	    PragmaFunction::PragmaAssignment("debug_checkpoint_abort", PragmaDebugCheckpointAbort, LogicalType::VARCHAR));
 
+	set.AddFunction(
+	    PragmaFunction::PragmaAssignment("force_compression", PragmaForceCompression, LogicalType::VARCHAR));
+
 	set.AddFunction(PragmaFunction::PragmaAssignment("temp_directory", PragmaSetTempDirectory, LogicalType::VARCHAR));
 }
 
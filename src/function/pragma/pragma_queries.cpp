@@ -62,6 +62,14 @@ string PragmaDatabaseSize(ClientContext &context, const FunctionParameters &para
 	return "SELECT * FROM pragma_database_size()";
 }
 
+string PragmaTaskSchedulerInfo(ClientContext &context, const FunctionParameters &parameters) {
+	return "SELECT * FROM pragma_task_scheduler_info()";
+}
+
+string PragmaBufferManagerInfo(ClientContext &context, const FunctionParameters &parameters) {
+	return "SELECT * FROM pragma_buffer_manager_info()";
+}
+
 string PragmaStorageInfo(ClientContext &context, const FunctionParameters &parameters) {
 	return StringUtil::Format("SELECT * FROM pragma_storage_info('%s')", parameters.values[0].ToString());
 }
@@ -75,6 +83,8 @@ void PragmaQueries::RegisterFunction(BuiltinFunctions &set) {
 	set.AddFunction(PragmaFunction::PragmaCall("show", PragmaShow, {LogicalType::VARCHAR}));
 	set.AddFunction(PragmaFunction::PragmaStatement("version", PragmaVersion));
 	set.AddFunction(PragmaFunction::PragmaStatement("database_size", PragmaDatabaseSize));
+	set.AddFunction(PragmaFunction::PragmaStatement("task_scheduler_info", PragmaTaskSchedulerInfo));
+	set.AddFunction(PragmaFunction::PragmaStatement("buffer_manager_info", PragmaBufferManagerInfo));
 	set.AddFunction(PragmaFunction::PragmaStatement("functions", PragmaFunctionsQuery));
 	set.AddFunction(PragmaFunction::PragmaCall("import_database", PragmaImportDatabase, {LogicalType::VARCHAR}));
 	set.AddFunction(PragmaFunction::PragmaStatement("all_profiling_output", PragmaAllProfiling));
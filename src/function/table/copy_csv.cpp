@@ -5,6 +5,7 @@
 #include "duckdb/parser/parsed_data/copy_info.hpp"
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/common/file_system.hpp"
+#include "duckdb/common/types/chunk_collection.hpp"
 #include "duckdb/common/types/string_type.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/function/scalar/string_functions.hpp"
@@ -243,6 +244,8 @@ static unique_ptr<FunctionData> ReadCSVBind(ClientContext &context, CopyInfo &in
 			}
 		} else if (loption == "force_not_null") {
 			options.force_not_null = ParseColumnList(set, expected_names);
+		} else if (loption == "parallel") {
+			options.parallel = ParseBoolean(set);
 		} else if (loption == "date_format" || loption == "dateformat") {
 			string format = ParseString(set);
 			auto &date_format = options.date_format[LogicalTypeId::DATE];
@@ -271,6 +274,7 @@ static unique_ptr<FunctionData> ReadCSVBind(ClientContext &context, CopyInfo &in
 		options.force_not_null.resize(expected_types.size(), false);
 	}
 	bind_data->Finalize();
+	bind_data->detected_options = options;
 	return move(bind_data);
 }
 
@@ -395,11 +399,9 @@ static void WriteQuotedString(Serializer &serializer, WriteCSVData &csv_data, co
 //===--------------------------------------------------------------------===//
 // Sink
 //===--------------------------------------------------------------------===//
-struct LocalReadCSVData : public LocalFunctionData {
-	//! The thread-local buffer to write data into
+struct WriteCSVBatchData : public PreparedBatchData {
+	//! The serialized rows of the batch
 	BufferedSerializer serializer;
-	//! A chunk with VARCHAR columns to cast intermediates into
-	DataChunk cast_chunk;
 };
 
 struct GlobalWriteCSVData : public GlobalFunctionData {
@@ -420,18 +422,6 @@ struct GlobalWriteCSVData : public GlobalFunctionData {
 	unique_ptr<FileHandle> handle;
 };
 
-static unique_ptr<LocalFunctionData> WriteCSVInitializeLocal(ClientContext &context, FunctionData &bind_data) {
-	auto &csv_data = (WriteCSVData &)bind_data;
-	auto local_data = make_unique<LocalReadCSVData>();
-
-	// create the chunk with VARCHAR types
-	vector<LogicalType> types;
-	types.resize(csv_data.names.size(), LogicalType::VARCHAR);
-
-	local_data->cast_chunk.Initialize(types);
-	return move(local_data);
-}
-
 static unique_ptr<GlobalFunctionData> WriteCSVInitializeGlobal(ClientContext &context, FunctionData &bind_data) {
 	auto &csv_data = (WriteCSVData &)bind_data;
 	auto &options = csv_data.options;
@@ -453,17 +443,13 @@ static unique_ptr<GlobalFunctionData> WriteCSVInitializeGlobal(ClientContext &co
 	return move(global_data);
 }
 
-static void WriteCSVSink(ClientContext &context, FunctionData &bind_data, GlobalFunctionData &gstate,
-                         LocalFunctionData &lstate, DataChunk &input) {
-	auto &csv_data = (WriteCSVData &)bind_data;
+//===--------------------------------------------------------------------===//
+// Prepare Batch
+//===--------------------------------------------------------------------===//
+static void WriteCSVChunk(WriteCSVData &csv_data, DataChunk &input, DataChunk &cast_chunk, BufferedSerializer &writer) {
 	auto &options = csv_data.options;
-	auto &local_data = (LocalReadCSVData &)lstate;
-	auto &global_state = (GlobalWriteCSVData &)gstate;
-
-	// write data into the local buffer
 
 	// first cast the columns of the chunk to varchar
-	auto &cast_chunk = local_data.cast_chunk;
 	cast_chunk.SetCardinality(input);
 	for (idx_t col_idx = 0; col_idx < input.ColumnCount(); col_idx++) {
 		if (csv_data.sql_types[col_idx].id() == LogicalTypeId::VARCHAR) {
@@ -476,7 +462,6 @@ static void WriteCSVSink(ClientContext &context, FunctionData &bind_data, Global
 	}
 
 	cast_chunk.Normalify();
-	auto &writer = local_data.serializer;
 	// now loop over the vectors and output the values
 	for (idx_t row_idx = 0; row_idx < cast_chunk.size(); row_idx++) {
 		// write values
@@ -501,35 +486,56 @@ static void WriteCSVSink(ClientContext &context, FunctionData &bind_data, Global
 		}
 		writer.WriteBufferData(csv_data.newline);
 	}
-	// check if we should flush what we have currently written
-	if (writer.blob.size >= csv_data.flush_size) {
-		global_state.WriteData(writer.blob.data.get(), writer.blob.size);
-		writer.Reset();
+}
+
+static unique_ptr<PreparedBatchData> WriteCSVPrepareBatch(ClientContext &context, FunctionData &bind_data,
+                                                          GlobalFunctionData &gstate, ChunkCollection &collection) {
+	auto &csv_data = (WriteCSVData &)bind_data;
+
+	// create the chunk with VARCHAR types
+	vector<LogicalType> types;
+	types.resize(csv_data.names.size(), LogicalType::VARCHAR);
+	DataChunk cast_chunk;
+	cast_chunk.Initialize(types);
+
+	// write the rows into the buffer of the batch
+	auto batch = make_unique<WriteCSVBatchData>();
+	for (auto &chunk : collection.Chunks()) {
+		WriteCSVChunk(csv_data, *chunk, cast_chunk, batch->serializer);
 	}
+	return move(batch);
+}
+
+//===--------------------------------------------------------------------===//
+// Flush Batch
+//===--------------------------------------------------------------------===//
+static void WriteCSVFlushBatch(ClientContext &context, FunctionData &bind_data, GlobalFunctionData &gstate,
+                               PreparedBatchData &batch) {
+	auto &csv_batch = (WriteCSVBatchData &)batch;
+	auto &global_state = (GlobalWriteCSVData &)gstate;
+	auto &writer = csv_batch.serializer;
+	global_state.WriteData(writer.blob.data.get(), writer.blob.size);
+	writer.Reset();
 }
 
 //===--------------------------------------------------------------------===//
-// Combine
+// Finalize
 //===--------------------------------------------------------------------===//
-static void WriteCSVCombine(ClientContext &context, FunctionData &bind_data, GlobalFunctionData &gstate,
-                            LocalFunctionData &lstate) {
-	auto &local_data = (LocalReadCSVData &)lstate;
+static void WriteCSVFinalize(ClientContext &context, FunctionData &bind_data, GlobalFunctionData &gstate) {
 	auto &global_state = (GlobalWriteCSVData &)gstate;
-	auto &writer = local_data.serializer;
-	// flush the local writer
-	if (writer.blob.size > 0) {
-		global_state.WriteData(writer.blob.data.get(), writer.blob.size);
-		writer.Reset();
+	if (!global_state.handle->OnDiskFile()) {
+		// remote file systems (e.g. S3) complete the upload of the file when it is synced
+		global_state.handle->Sync();
 	}
 }
 
 void CSVCopyFunction::RegisterFunction(BuiltinFunctions &set) {
 	CopyFunction info("csv");
 	info.copy_to_bind = WriteCSVBind;
-	info.copy_to_initialize_local = WriteCSVInitializeLocal;
 	info.copy_to_initialize_global = WriteCSVInitializeGlobal;
-	info.copy_to_sink = WriteCSVSink;
-	info.copy_to_combine = WriteCSVCombine;
+	info.copy_to_prepare_batch = WriteCSVPrepareBatch;
+	info.copy_to_flush_batch = WriteCSVFlushBatch;
+	info.copy_to_finalize = WriteCSVFinalize;
 
 	info.copy_from_bind = ReadCSVBind;
 	info.copy_from_function = ReadCSVTableFunction::GetFunction();
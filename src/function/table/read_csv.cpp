@@ -5,6 +5,7 @@
 #include "duckdb/main/database.hpp"
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/main/config.hpp"
+#include "duckdb/parallel/parallel_state.hpp"
 #include "duckdb/parser/expression/constant_expression.hpp"
 #include "duckdb/parser/expression/function_expression.hpp"
 #include "duckdb/parser/tableref/table_function_ref.hpp"
@@ -118,6 +119,8 @@ static unique_ptr<FunctionData> ReadCSVBind(ClientContext &context, vector<Value
 			result->include_file_name = kv.second.value_.boolean;
 		} else if (kv.first == "skip") {
 			options.skip_rows = kv.second.GetValue<int64_t>();
+		} else if (kv.first == "parallel") {
+			options.parallel = kv.second.value_.boolean;
 		}
 	}
 	if (!options.auto_detect && return_types.empty()) {
@@ -134,9 +137,13 @@ static unique_ptr<FunctionData> ReadCSVBind(ClientContext &context, vector<Value
 
 		return_types.assign(initial_reader->sql_types.begin(), initial_reader->sql_types.end());
 		names.assign(initial_reader->col_names.begin(), initial_reader->col_names.end());
+		result->sql_types = initial_reader->sql_types;
+		result->detected_options = initial_reader->options;
+		result->detected_options.auto_detect = false;
 		result->initial_reader = move(initial_reader);
 	} else {
 		result->sql_types = return_types;
+		result->detected_options = options;
 		D_ASSERT(return_types.size() == names.size());
 	}
 	if (result->include_file_name) {
@@ -153,6 +160,17 @@ struct ReadCSVOperatorData : public FunctionOperatorData {
 	idx_t file_index;
 };
 
+struct ReadCSVParallelState : public ParallelState {
+	mutex lock;
+	//! The size of the file that is read
+	idx_t file_size;
+	//! The byte offset of the next range to read
+	idx_t next_offset;
+};
+
+//! The size of the byte ranges that a CSV file is split into when it is read in parallel
+static constexpr idx_t CSV_PARALLEL_RANGE_SIZE = 1 << 22;
+
 static unique_ptr<FunctionOperatorData> ReadCSVInit(ClientContext &context, const FunctionData *bind_data_p,
                                                     const vector<column_t> &column_ids,
                                                     TableFilterCollection *filters) {
@@ -203,6 +221,81 @@ static void ReadCSVFunction(ClientContext &context, const FunctionData *bind_dat
 	}
 }
 
+//! Returns the size of the file to read if it can be split into ranges that are read in parallel, or 0 otherwise
+static idx_t ReadCSVParallelFileSize(ClientContext &context, const ReadCSVData &bind_data) {
+	auto &options = bind_data.detected_options;
+	if (!options.parallel || options.auto_detect || bind_data.files.size() != 1 || options.compression == "gzip") {
+		return 0;
+	}
+	auto compression = options.compression == "infer" || options.compression == "auto"
+	                       ? FileCompressionType::AUTO_DETECT
+	                       : FileCompressionType::UNCOMPRESSED;
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto handle = fs.OpenFile(bind_data.files[0], FileFlags::FILE_FLAGS_READ, FileLockType::NO_LOCK, compression);
+	if (!handle->OnDiskFile() || !handle->CanSeek()) {
+		// compressed files and pipes have to be read sequentially
+		return 0;
+	}
+	return handle->GetFileSize();
+}
+
+static idx_t ReadCSVMaxThreads(ClientContext &context, const FunctionData *bind_data_p) {
+	auto &bind_data = (ReadCSVData &)*bind_data_p;
+	auto file_size = ReadCSVParallelFileSize(context, bind_data);
+	return (file_size + CSV_PARALLEL_RANGE_SIZE - 1) / CSV_PARALLEL_RANGE_SIZE;
+}
+
+static unique_ptr<ParallelState> ReadCSVInitParallelState(ClientContext &context, const FunctionData *bind_data_p) {
+	auto &bind_data = (ReadCSVData &)*bind_data_p;
+	auto result = make_unique<ReadCSVParallelState>();
+	result->file_size = ReadCSVParallelFileSize(context, bind_data);
+	result->next_offset = 0;
+	bind_data.bytes_read = 0;
+	bind_data.file_size = result->file_size;
+	return move(result);
+}
+
+static bool ReadCSVParallelStateNext(ClientContext &context, const FunctionData *bind_data_p,
+                                     FunctionOperatorData *state_p, ParallelState *parallel_state_p) {
+	auto &bind_data = (ReadCSVData &)*bind_data_p;
+	auto &parallel_state = (ReadCSVParallelState &)*parallel_state_p;
+	auto &data = (ReadCSVOperatorData &)*state_p;
+
+	idx_t range_start;
+	idx_t range_end;
+	{
+		lock_guard<mutex> parallel_lock(parallel_state.lock);
+		if (parallel_state.next_offset >= parallel_state.file_size) {
+			return false;
+		}
+		range_start = parallel_state.next_offset;
+		range_end = MinValue<idx_t>(range_start + CSV_PARALLEL_RANGE_SIZE, parallel_state.file_size);
+		parallel_state.next_offset = range_end;
+	}
+	// set up a reader for the range; only the reader of the first range skips the leading rows and the header
+	auto options = bind_data.detected_options;
+	options.file_path = bind_data.files[0];
+	if (range_start > 0) {
+		options.skip_rows = 0;
+		options.header = false;
+	}
+	data.csv_reader = make_unique<BufferedCSVReader>(context, move(options), bind_data.sql_types);
+	data.csv_reader->SetRange(range_start, range_end);
+	data.file_index = bind_data.files.size();
+	return true;
+}
+
+static unique_ptr<FunctionOperatorData> ReadCSVParallelInit(ClientContext &context, const FunctionData *bind_data_p,
+                                                            ParallelState *parallel_state_p,
+                                                            const vector<column_t> &column_ids,
+                                                            TableFilterCollection *filters) {
+	auto result = make_unique<ReadCSVOperatorData>();
+	if (!ReadCSVParallelStateNext(context, bind_data_p, result.get(), parallel_state_p)) {
+		return nullptr;
+	}
+	return move(result);
+}
+
 static void ReadCSVAddNamedParameters(TableFunction &table_function) {
 	table_function.named_parameters["sep"] = LogicalType::VARCHAR;
 	table_function.named_parameters["delim"] = LogicalType::VARCHAR;
@@ -222,6 +315,7 @@ static void ReadCSVAddNamedParameters(TableFunction &table_function) {
 	table_function.named_parameters["compression"] = LogicalType::VARCHAR;
 	table_function.named_parameters["filename"] = LogicalType::BOOLEAN;
 	table_function.named_parameters["skip"] = LogicalType::BIGINT;
+	table_function.named_parameters["parallel"] = LogicalType::BOOLEAN;
 }
 
 int CSVReaderProgress(ClientContext &context, const FunctionData *bind_data_p) {
@@ -233,10 +327,18 @@ int CSVReaderProgress(ClientContext &context, const FunctionData *bind_data_p) {
 	return percentage;
 }
 
+static void ReadCSVSetParallelFunctions(TableFunction &table_function) {
+	table_function.max_threads = ReadCSVMaxThreads;
+	table_function.init_parallel_state = ReadCSVInitParallelState;
+	table_function.parallel_init = ReadCSVParallelInit;
+	table_function.parallel_state_next = ReadCSVParallelStateNext;
+}
+
 TableFunction ReadCSVTableFunction::GetFunction() {
 	TableFunction read_csv("read_csv", {LogicalType::VARCHAR}, ReadCSVFunction, ReadCSVBind, ReadCSVInit);
 	read_csv.table_scan_progress = CSVReaderProgress;
 	ReadCSVAddNamedParameters(read_csv);
+	ReadCSVSetParallelFunctions(read_csv);
 	return read_csv;
 }
 
@@ -246,6 +348,7 @@ void ReadCSVTableFunction::RegisterFunction(BuiltinFunctions &set) {
 	TableFunction read_csv_auto("read_csv_auto", {LogicalType::VARCHAR}, ReadCSVFunction, ReadCSVAutoBind, ReadCSVInit);
 	read_csv_auto.table_scan_progress = CSVReaderProgress;
 	ReadCSVAddNamedParameters(read_csv_auto);
+	ReadCSVSetParallelFunctions(read_csv_auto);
 	set.AddFunction(read_csv_auto);
 }
 
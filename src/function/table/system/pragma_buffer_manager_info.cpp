@@ -0,0 +1,81 @@
+#include "duckdb/function/table/system_functions.hpp"
+
+#include "duckdb/storage/buffer_manager.hpp"
+
+namespace duckdb {
+
+struct PragmaBufferManagerInfoData : public FunctionOperatorData {
+	PragmaBufferManagerInfoData() : finished(false) {
+	}
+
+	bool finished;
+};
+
+static unique_ptr<FunctionData> PragmaBufferManagerInfoBind(ClientContext &context, vector<Value> &inputs,
+                                                            unordered_map<string, Value> &named_parameters,
+                                                            vector<LogicalType> &input_table_types,
+                                                            vector<string> &input_table_names,
+                                                            vector<LogicalType> &return_types, vector<string> &names) {
+	names.emplace_back("memory_usage");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("memory_limit");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("cache_hits");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("cache_misses");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("hit_ratio");
+	return_types.push_back(LogicalType::DOUBLE);
+
+	names.emplace_back("evicted_blocks");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("temporary_writes");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("temporary_reads");
+	return_types.push_back(LogicalType::BIGINT);
+
+	return nullptr;
+}
+
+unique_ptr<FunctionOperatorData> PragmaBufferManagerInfoInit(ClientContext &context, const FunctionData *bind_data,
+                                                             const vector<column_t> &column_ids,
+                                                             TableFilterCollection *filters) {
+	return make_unique<PragmaBufferManagerInfoData>();
+}
+
+void PragmaBufferManagerInfoFunction(ClientContext &context, const FunctionData *bind_data,
+                                     FunctionOperatorData *operator_state, DataChunk *input, DataChunk &output) {
+	auto &data = (PragmaBufferManagerInfoData &)*operator_state;
+	if (data.finished) {
+		return;
+	}
+	auto &buffer_manager = BufferManager::GetBufferManager(context);
+	auto stats = buffer_manager.GetStatistics();
+	auto total_references = stats.cache_hits + stats.cache_misses;
+
+	output.SetCardinality(1);
+	output.data[0].SetValue(0, Value::BIGINT(buffer_manager.GetUsedMemory()));
+	output.data[1].SetValue(0, Value::BIGINT(buffer_manager.GetMaxMemory()));
+	output.data[2].SetValue(0, Value::BIGINT(stats.cache_hits));
+	output.data[3].SetValue(0, Value::BIGINT(stats.cache_misses));
+	output.data[4].SetValue(0, total_references == 0 ? Value::DOUBLE(0)
+	                                                 : Value::DOUBLE(double(stats.cache_hits) / total_references));
+	output.data[5].SetValue(0, Value::BIGINT(stats.evicted_blocks));
+	output.data[6].SetValue(0, Value::BIGINT(stats.temporary_writes));
+	output.data[7].SetValue(0, Value::BIGINT(stats.temporary_reads));
+
+	data.finished = true;
+}
+
+void PragmaBufferManagerInfo::RegisterFunction(BuiltinFunctions &set) {
+	set.AddFunction(TableFunction("pragma_buffer_manager_info", {}, PragmaBufferManagerInfoFunction,
+	                              PragmaBufferManagerInfoBind, PragmaBufferManagerInfoInit));
+}
+
+} // namespace duckdb
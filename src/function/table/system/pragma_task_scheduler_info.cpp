@@ -0,0 +1,77 @@
+#include "duckdb/function/table/system_functions.hpp"
+
+#include "duckdb/parallel/task_scheduler.hpp"
+
+namespace duckdb {
+
+struct PragmaTaskSchedulerInfoData : public FunctionOperatorData {
+	PragmaTaskSchedulerInfoData() : finished(false) {
+	}
+
+	bool finished;
+};
+
+static unique_ptr<FunctionData> PragmaTaskSchedulerInfoBind(ClientContext &context, vector<Value> &inputs,
+                                                            unordered_map<string, Value> &named_parameters,
+                                                            vector<LogicalType> &input_table_types,
+                                                            vector<string> &input_table_names,
+                                                            vector<LogicalType> &return_types, vector<string> &names) {
+	names.emplace_back("threads");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("scheduled_tasks");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("executed_tasks");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("stolen_tasks");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("total_queue_wait_us");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("average_queue_wait_us");
+	return_types.push_back(LogicalType::DOUBLE);
+
+	names.emplace_back("max_queue_wait_us");
+	return_types.push_back(LogicalType::BIGINT);
+
+	return nullptr;
+}
+
+unique_ptr<FunctionOperatorData> PragmaTaskSchedulerInfoInit(ClientContext &context, const FunctionData *bind_data,
+                                                             const vector<column_t> &column_ids,
+                                                             TableFilterCollection *filters) {
+	return make_unique<PragmaTaskSchedulerInfoData>();
+}
+
+void PragmaTaskSchedulerInfoFunction(ClientContext &context, const FunctionData *bind_data,
+                                     FunctionOperatorData *operator_state, DataChunk *input, DataChunk &output) {
+	auto &data = (PragmaTaskSchedulerInfoData &)*operator_state;
+	if (data.finished) {
+		return;
+	}
+	auto &scheduler = TaskScheduler::GetScheduler(context);
+	auto stats = scheduler.GetStatistics();
+
+	output.SetCardinality(1);
+	output.data[0].SetValue(0, Value::BIGINT(scheduler.NumberOfThreads()));
+	output.data[1].SetValue(0, Value::BIGINT(stats.scheduled_tasks));
+	output.data[2].SetValue(0, Value::BIGINT(stats.executed_tasks));
+	output.data[3].SetValue(0, Value::BIGINT(stats.stolen_tasks));
+	output.data[4].SetValue(0, Value::BIGINT(stats.total_queue_wait_us));
+	output.data[5].SetValue(0, stats.executed_tasks == 0
+	                               ? Value::DOUBLE(0)
+	                               : Value::DOUBLE(double(stats.total_queue_wait_us) / stats.executed_tasks));
+	output.data[6].SetValue(0, Value::BIGINT(stats.max_queue_wait_us));
+
+	data.finished = true;
+}
+
+void PragmaTaskSchedulerInfo::RegisterFunction(BuiltinFunctions &set) {
+	set.AddFunction(TableFunction("pragma_task_scheduler_info", {}, PragmaTaskSchedulerInfoFunction,
+	                              PragmaTaskSchedulerInfoBind, PragmaTaskSchedulerInfoInit));
+}
+
+} // namespace duckdb
@@ -24,9 +24,14 @@ bool TableScanParallelStateNext(ClientContext &context, const FunctionData *bind
                                 FunctionOperatorData *operator_state, ParallelState *parallel_state_p);
 
 struct TableScanOperatorData : public FunctionOperatorData {
+	TableScanOperatorData() : batch_index(0) {
+	}
+
 	//! The current position in the scan
 	TableScanState scan_state;
 	vector<column_t> column_ids;
+	//! The batch index of the part of the table that is currently scanned (parallel scans only)
+	idx_t batch_index;
 };
 
 static unique_ptr<FunctionOperatorData> TableScanInit(ClientContext &context, const FunctionData *bind_data_p,
@@ -75,8 +80,13 @@ static void TableScanFunc(ClientContext &context, const FunctionData *bind_data_
 }
 
 struct ParallelTableFunctionScanState : public ParallelState {
+	ParallelTableFunctionScanState() : batch_index(0) {
+	}
+
 	ParallelTableScanState state;
 	mutex lock;
+	//! The batch index of the next part of the table that is handed out
+	idx_t batch_index;
 };
 
 idx_t TableScanMaxThreads(ClientContext &context, const FunctionData *bind_data_p) {
@@ -98,8 +108,18 @@ bool TableScanParallelStateNext(ClientContext &context, const FunctionData *bind
 	auto &state = (TableScanOperatorData &)*operator_state;
 
 	lock_guard<mutex> parallel_lock(parallel_state.lock);
-	return bind_data.table->storage->NextParallelScan(context, parallel_state.state, state.scan_state,
-	                                                  state.column_ids);
+	if (!bind_data.table->storage->NextParallelScan(context, parallel_state.state, state.scan_state,
+	                                               state.column_ids)) {
+		return false;
+	}
+	state.batch_index = parallel_state.batch_index++;
+	return true;
+}
+
+idx_t TableScanGetBatchIndex(ClientContext &context, const FunctionData *bind_data_p,
+                             FunctionOperatorData *operator_state, ParallelState *parallel_state_p) {
+	auto &state = (TableScanOperatorData &)*operator_state;
+	return state.batch_index;
 }
 
 int TableScanProgress(ClientContext &context, const FunctionData *bind_data_p) {
@@ -322,6 +342,7 @@ void TableScanPushdownComplexFilter(ClientContext &context, LogicalGet &get, Fun
 				get.function.init_parallel_state = nullptr;
 				get.function.parallel_state_next = nullptr;
 				get.function.table_scan_progress = nullptr;
+				get.function.get_batch_index = nullptr;
 				get.function.filter_pushdown = false;
 			} else {
 				bind_data.result_ids.clear();
@@ -351,6 +372,7 @@ TableFunction TableScanFunction::GetFunction() {
 	scan_function.parallel_init = TableScanParallelInit;
 	scan_function.parallel_state_next = TableScanParallelStateNext;
 	scan_function.table_scan_progress = TableScanProgress;
+	scan_function.get_batch_index = TableScanGetBatchIndex;
 	scan_function.projection_pushdown = true;
 	scan_function.filter_pushdown = true;
 	return scan_function;
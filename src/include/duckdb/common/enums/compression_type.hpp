@@ -0,0 +1,27 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/common/enums/compression_type.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/constants.hpp"
+
+namespace duckdb {
+
+enum class CompressionType : uint8_t {
+	COMPRESSION_AUTO = 0,
+	COMPRESSION_UNCOMPRESSED = 1,
+	COMPRESSION_CONSTANT = 2,
+	COMPRESSION_RLE = 3,
+	COMPRESSION_BITPACKING = 4,
+	COMPRESSION_DICTIONARY = 5
+};
+
+string CompressionTypeToString(CompressionType type);
+CompressionType CompressionTypeFromString(const string &str);
+
+} // namespace duckdb
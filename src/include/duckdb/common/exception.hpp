@@ -84,8 +84,12 @@ public:
 
 public:
 	const char *what() const noexcept override;
+	//! The message of the exception without the "<type> Error: " prefix
+	const string &RawMessage() const;
 
 	string ExceptionTypeToString(ExceptionType type);
+	//! Throws an exception of the given type, e.g. to rethrow an exception that was caught in another thread
+	[[noreturn]] static void ThrowAsTypeWithMessage(ExceptionType type, const string &message);
 
 	template <typename... Args>
 	static string ConstructMessage(const string &msg, Args... params) {
@@ -104,6 +108,7 @@ public:
 
 private:
 	string exception_message_;
+	string raw_message_;
 };
 
 //===--------------------------------------------------------------------===//
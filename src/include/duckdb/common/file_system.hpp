@@ -77,6 +77,17 @@ public:
 	string path;
 };
 
+//! A read that has been issued ahead of time, see FileSystem::ReadAsync. Destroying a read that has not been waited on
+//! cancels it, or waits for it if it is already running.
+class AsyncRead {
+public:
+	virtual ~AsyncRead() {
+	}
+
+	//! Waits until the read has completed, throws if it failed
+	virtual void Wait() = 0;
+};
+
 enum class FileLockType : uint8_t { NO_LOCK = 0, READ_LOCK = 1, WRITE_LOCK = 2 };
 
 class FileFlags {
@@ -111,6 +122,10 @@ public:
 	//! Read exactly nr_bytes from the specified location in the file. Fails if nr_bytes could not be read. This is
 	//! equivalent to calling SetFilePointer(location) followed by calling Read().
 	virtual void Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location);
+	//! Issue a read of exactly nr_bytes from the specified location, which completes in the background. The handle and
+	//! the buffer need to stay valid until the read has been waited on or destroyed. The read is not guaranteed to
+	//! start before it is waited on: by default, it is only executed then.
+	virtual unique_ptr<AsyncRead> ReadAsync(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location);
 	//! Write exactly nr_bytes to the specified location in the file. Fails if nr_bytes could not be read. This is
 	//! equivalent to calling SetFilePointer(location) followed by calling Write().
 	virtual void Write(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location);
@@ -207,6 +222,10 @@ public:
 		handle.file_system.Read(handle, buffer, nr_bytes, location);
 	};
 
+	unique_ptr<AsyncRead> ReadAsync(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) override {
+		return handle.file_system.ReadAsync(handle, buffer, nr_bytes, location);
+	}
+
 	virtual void Write(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) override {
 		handle.file_system.Write(handle, buffer, nr_bytes, location);
 	}
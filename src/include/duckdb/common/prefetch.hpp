@@ -0,0 +1,23 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/common/prefetch.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+namespace duckdb {
+
+//! Hint the CPU to load the cache line holding the given address, so a later read of the address does not stall.
+//! Used by hash table probes that first compute a batch of addresses and only then access them.
+inline void PrefetchAddress(const void *address) {
+#if defined(__GNUC__) || defined(__clang__)
+	__builtin_prefetch(address);
+#else
+	(void)address;
+#endif
+}
+
+} // namespace duckdb
@@ -0,0 +1,77 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/common/types/spillable_chunk_collection.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/types/data_chunk.hpp"
+
+namespace duckdb {
+class BlockHandle;
+class BufferManager;
+
+struct SpillableChunkScanState {
+	SpillableChunkScanState() : block_index(0), offset(0) {
+	}
+
+	//! The block that is currently being scanned
+	idx_t block_index;
+	//! The offset within the current block
+	idx_t offset;
+};
+
+//! A SpillableChunkCollection stores a set of DataChunks in serialized form inside blocks that are managed by the
+//! BufferManager
+/*!
+    Unlike the ChunkCollection, the blocks of a SpillableChunkCollection are only pinned while they are being written
+   to or read from. This allows the BufferManager to offload them to the temporary directory when the memory limit is
+   reached, which makes this collection suitable for holding intermediates of operators that can run out-of-core.
+*/
+class SpillableChunkCollection {
+public:
+	explicit SpillableChunkCollection(BufferManager &buffer_manager);
+
+	//! Append a chunk to the collection. This method is thread-safe.
+	void Append(DataChunk &chunk);
+	//! Scan the next chunk from the collection into the result chunk, returns false if the collection is exhausted.
+	//! The result chunk is (re-)initialized with the types of the stored chunk.
+	bool Scan(SpillableChunkScanState &state, DataChunk &result);
+	//! Remove all chunks from the collection and release the blocks
+	void Reset();
+
+	//! The amount of rows stored in the collection
+	idx_t Count() const {
+		return count;
+	}
+	//! The size of the serialized chunks in bytes
+	idx_t SizeInBytes() const {
+		return size_in_bytes;
+	}
+
+private:
+	struct SpillableBlock {
+		shared_ptr<BlockHandle> block;
+		//! The capacity of the block in bytes
+		idx_t capacity;
+		//! The amount of bytes written to the block
+		idx_t size;
+	};
+
+	mutex lock;
+	//! BufferManager
+	BufferManager &buffer_manager;
+	//! The blocks holding the serialized chunks
+	vector<SpillableBlock> blocks;
+	//! The amount of rows stored in the collection
+	idx_t count;
+	//! The size of the serialized chunks in bytes
+	idx_t size_in_bytes;
+};
+
+} // namespace duckdb
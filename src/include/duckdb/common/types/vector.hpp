@@ -244,6 +244,26 @@ struct DictionaryVector {
 		D_ASSERT(vector.GetVectorType() == VectorType::DICTIONARY_VECTOR);
 		return ((VectorChildBuffer &)*vector.auxiliary).data;
 	}
+	//! Returns the amount of entries in the dictionary of the vector, or 0 if it is not known
+	static inline idx_t DictionarySize(const Vector &vector) {
+		D_ASSERT(vector.GetVectorType() == VectorType::DICTIONARY_VECTOR);
+		return ((const DictionaryBuffer &)*vector.buffer).GetDictionarySize();
+	}
+	//! Sets the amount of entries in the dictionary of the vector. Every entry has to be referenced by the vector.
+	static inline void SetDictionarySize(Vector &vector, idx_t size) {
+		D_ASSERT(vector.GetVectorType() == VectorType::DICTIONARY_VECTOR);
+		((DictionaryBuffer &)*vector.buffer).SetDictionarySize(size);
+	}
+	//! Whether or not the vector is a dictionary of a known size that is smaller than "count", in which case
+	//! operations can be performed once per dictionary entry instead of once per row
+	static inline bool IsSmallDictionary(const Vector &vector, idx_t count) {
+		if (vector.GetVectorType() != VectorType::DICTIONARY_VECTOR) {
+			return false;
+		}
+		auto dictionary_size = DictionarySize(vector);
+		return dictionary_size > 0 && dictionary_size < count &&
+		       Child(vector).GetVectorType() == VectorType::FLAT_VECTOR;
+	}
 };
 
 struct FlatVector {
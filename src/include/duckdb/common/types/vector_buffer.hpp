@@ -95,9 +95,18 @@ public:
 	void SetSelVector(const SelectionVector &vector) {
 		this->sel_vector.Initialize(vector);
 	}
+	idx_t GetDictionarySize() const {
+		return dictionary_size;
+	}
+	void SetDictionarySize(idx_t size) {
+		dictionary_size = size;
+	}
 
 private:
 	SelectionVector sel_vector;
+	//! The amount of entries in the dictionary, or 0 if it is not known. If it is known, every entry of the dictionary
+	//! is referenced by the selection vector.
+	idx_t dictionary_size = 0;
 };
 
 class VectorStringBuffer : public VectorBuffer {
@@ -138,21 +138,46 @@ private:
 			    ldata, result_data, count, FlatVector::Validity(input), FlatVector::Validity(result), fun);
 			break;
 		}
+		case VectorType::DICTIONARY_VECTOR: {
+			if (DictionaryVector::IsSmallDictionary(input, count)) {
+				// evaluate the function once per dictionary entry, and emit a dictionary vector of the results
+				auto dictionary_size = DictionaryVector::DictionarySize(input);
+				auto &child = DictionaryVector::Child(input);
+				Vector dictionary_result(result.GetType(), dictionary_size);
+				ExecuteFlat<INPUT_TYPE, RESULT_TYPE, OPWRAPPER, OP, FUNC>(
+				    FlatVector::GetData<INPUT_TYPE>(child), FlatVector::GetData<RESULT_TYPE>(dictionary_result),
+				    dictionary_size, FlatVector::Validity(child), FlatVector::Validity(dictionary_result), fun);
+				if (result.GetType().InternalType() == PhysicalType::VARCHAR) {
+					// the function may have added strings to the heap of the result vector: keep it alive
+					StringVector::AddHeapReference(dictionary_result, result);
+				}
+				result.Slice(dictionary_result, DictionaryVector::SelVector(input), count);
+				DictionaryVector::SetDictionarySize(result, dictionary_size);
+				break;
+			}
+			ExecuteGeneric<INPUT_TYPE, RESULT_TYPE, OPWRAPPER, OP, FUNC>(input, result, count, fun);
+			break;
+		}
 		default: {
-			VectorData vdata;
-			input.Orrify(count, vdata);
-
-			result.SetVectorType(VectorType::FLAT_VECTOR);
-			auto result_data = FlatVector::GetData<RESULT_TYPE>(result);
-			auto ldata = (INPUT_TYPE *)vdata.data;
-
-			ExecuteLoop<INPUT_TYPE, RESULT_TYPE, OPWRAPPER, OP, FUNC>(
-			    ldata, result_data, count, vdata.sel, vdata.validity, FlatVector::Validity(result), fun);
+			ExecuteGeneric<INPUT_TYPE, RESULT_TYPE, OPWRAPPER, OP, FUNC>(input, result, count, fun);
 			break;
 		}
 		}
 	}
 
+	template <class INPUT_TYPE, class RESULT_TYPE, class OPWRAPPER, class OP, class FUNC>
+	static inline void ExecuteGeneric(Vector &input, Vector &result, idx_t count, FUNC fun) {
+		VectorData vdata;
+		input.Orrify(count, vdata);
+
+		result.SetVectorType(VectorType::FLAT_VECTOR);
+		auto result_data = FlatVector::GetData<RESULT_TYPE>(result);
+		auto ldata = (INPUT_TYPE *)vdata.data;
+
+		ExecuteLoop<INPUT_TYPE, RESULT_TYPE, OPWRAPPER, OP, FUNC>(ldata, result_data, count, vdata.sel, vdata.validity,
+		                                                          FlatVector::Validity(result), fun);
+	}
+
 public:
 	template <class INPUT_TYPE, class RESULT_TYPE, class OP, class OPWRAPPER = UnaryOperatorWrapper>
 	static void Execute(Vector &input, Vector &result, idx_t count) {
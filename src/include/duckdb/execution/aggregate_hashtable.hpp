@@ -93,6 +93,8 @@ public:
 	idx_t Size() {
 		return entries;
 	}
+	//! The amount of memory held by the payload and the hashes of the HT
+	idx_t SizeInBytes();
 
 	idx_t MaxCapacity();
 
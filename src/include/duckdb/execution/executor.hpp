@@ -20,6 +20,7 @@ class ClientContext;
 class DataChunk;
 class PhysicalOperator;
 class PhysicalOperatorState;
+class PhysicalSink;
 class ThreadContext;
 class Task;
 
@@ -36,7 +37,9 @@ public:
 	ClientContext &context;
 
 public:
-	void Initialize(PhysicalOperator *physical_plan);
+	//! Initialize and run the pipelines of the plan. If parallel_result is set and the plan allows it, the final
+	//! pipeline is executed in parallel as well, and its result is collected before it is fetched.
+	void Initialize(PhysicalOperator *physical_plan, bool parallel_result = false);
 	void BuildPipelines(PhysicalOperator *op, Pipeline *parent);
 
 	void Reset();
@@ -58,6 +61,8 @@ public:
 private:
 	PhysicalOperator *physical_plan;
 	unique_ptr<PhysicalOperatorState> physical_state;
+	//! The collector of the result of the final pipeline (if it is executed in parallel)
+	unique_ptr<PhysicalSink> result_collector;
 
 	mutex executor_lock;
 	//! The pipelines of the current query
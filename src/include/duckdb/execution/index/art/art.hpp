@@ -9,6 +9,7 @@
 #pragma once
 
 #include "duckdb/common/common.hpp"
+#include "duckdb/common/unordered_map.hpp"
 #include "duckdb/common/types/data_chunk.hpp"
 #include "duckdb/common/types/vector.hpp"
 #include "duckdb/parser/parsed_expression.hpp"
@@ -24,6 +25,9 @@
 #include "duckdb/execution/index/art/node256.hpp"
 
 namespace duckdb {
+class BlockHandle;
+class BufferHandle;
+
 struct IteratorEntry {
 	IteratorEntry() {
 	}
@@ -62,6 +66,16 @@ struct ARTIndexScanState : public IndexScanState {
 	idx_t result_index = 0;
 };
 
+struct ARTBuildEntry {
+	unique_ptr<Key> key;
+	row_t row_id;
+};
+
+//! The keys of a part of the table, sorted by key and row id once all keys have been added
+struct ARTBuildState : public IndexBuildState {
+	vector<ARTBuildEntry> entries;
+};
+
 class ART : public Index {
 public:
 	ART(const vector<column_t> &column_ids, const vector<unique_ptr<Expression>> &unbound_expressions,
@@ -72,6 +86,16 @@ public:
 	unique_ptr<Node> tree;
 	//! True if machine is little endian
 	bool is_little_endian;
+	//! The database the tree was loaded from (if any), used to load swizzled nodes
+	DatabaseInstance *db;
+	//! The (approximate) amount of memory used by the nodes that were loaded from disk since the last time the tree
+	//! was swizzled
+	idx_t loaded_memory;
+	//! The blocks the nodes of the tree were written to, with the handles of the blocks that were read since the tree
+	//! was loaded. Unmodified subtrees keep pointing to the blocks of an earlier checkpoint.
+	unordered_map<block_id_t, shared_ptr<BlockHandle>> blocks;
+	//! The amount of blocks that were written the last time all nodes of the tree were written
+	idx_t compacted_blocks;
 
 public:
 	//! Initialize a scan on the index with the given expression and column ids
@@ -97,6 +121,23 @@ public:
 	//! Insert data into the index.
 	bool Insert(IndexLock &lock, DataChunk &data, Vector &row_ids) override;
 
+	//! Bulk construction: the keys of every part of the table are generated and sorted separately, after which the
+	//! sorted runs are merged and the tree is constructed bottom-up
+	unique_ptr<IndexBuildState> InitializeBuild() override;
+	void BuildAppend(IndexBuildState &state, DataChunk &input, Vector &row_ids) override;
+	void FinishBuild(IndexBuildState &state) override;
+	bool Build(IndexLock &lock, vector<unique_ptr<IndexBuildState>> &states) override;
+
+	//! Write the modified nodes of the tree to blocks of the index, and the root and the blocks of the index to the
+	//! writer. Returns the pointer to the written information, or an invalid pointer if the tree is empty.
+	BlockPointer Serialize(MetaBlockWriter &writer) override;
+	//! Load the tree that was serialized at the given pointer. The nodes are only loaded once they are accessed.
+	void Deserialize(DatabaseInstance &db, BlockPointer pointer);
+	//! Mark the blocks of the index as modified, so they can be reclaimed
+	void CommitDrop() override;
+	//! Pin a block of the index, the handle of the block is kept so the block is only read once
+	unique_ptr<BufferHandle> PinBlock(block_id_t block_id);
+
 	bool SearchEqual(ARTIndexScanState *state, idx_t max_count, vector<row_t> &result_ids);
 	//! Search Equal used for Joins that do not need to fetch data
 	void SearchEqualJoinNoFetch(Value &equal_value, idx_t &result_size);
@@ -106,9 +147,15 @@ private:
 
 private:
 	//! Insert a row id into a leaf node
+	//! Swizzle the unmodified nodes of the tree if the loaded nodes no longer fit in the memory limit, and load the
+	//! root of the tree. Must be called with the lock held, before any node of the tree is accessed.
+	void InitializeTree();
+
 	bool InsertToLeaf(Leaf &leaf, row_t row_id);
 	//! Insert the leaf value into the tree
 	bool Insert(unique_ptr<Node> &node, unique_ptr<Key> key, unsigned depth, row_t row_id);
+	//! Construct the subtree of the sorted entries in the range [start, end), which share their first depth bytes
+	bool Construct(vector<ARTBuildEntry> &entries, idx_t start, idx_t end, idx_t depth, unique_ptr<Node> &node);
 
 	//! Erase element from leaf (if leaf has more than one value) or eliminate the leaf itself
 	void Erase(unique_ptr<Node> &node, Key &key, unsigned depth, row_t row_id);
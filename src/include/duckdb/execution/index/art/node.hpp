@@ -10,11 +10,13 @@
 
 #include "duckdb/execution/index/art/art_key.hpp"
 #include "duckdb/common/common.hpp"
+#include "duckdb/storage/block.hpp"
 
 namespace duckdb {
-enum class NodeType : uint8_t { N4 = 0, N16 = 1, N48 = 2, N256 = 3, NLeaf = 4 };
+enum class NodeType : uint8_t { N4 = 0, N16 = 1, N48 = 2, N256 = 3, NLeaf = 4, NSwizzled = 5 };
 
 class ART;
+class MetaBlockWriter;
 
 class Node {
 public:
@@ -33,6 +35,9 @@ public:
 	NodeType type;
 	//! compressed path (prefix)
 	unique_ptr<uint8_t[]> prefix;
+	//! The location of the node in the last checkpoint, or an invalid pointer if the node was created or modified
+	//! after that checkpoint. Only nodes with a valid persistent pointer can be swizzled.
+	BlockPointer persistent_pointer;
 
 public:
 	//! Get the position of a child corresponding exactly to the specific byte, returns INVALID_INDEX if not exists
@@ -52,8 +57,13 @@ public:
 		return INVALID_INDEX;
 	}
 	//! Get the child at the specified position in the node. pos should be between [0, count). Throws an assertion if
-	//! the element is not found.
-	virtual unique_ptr<Node> *GetChild(idx_t pos);
+	//! the element is not found. A swizzled child is loaded from disk.
+	virtual unique_ptr<Node> *GetChild(ART &art, idx_t pos);
+
+	//! Mark the node as modified since the last checkpoint, which prevents it from being swizzled
+	void SetModified() {
+		persistent_pointer.block_id = INVALID_BLOCK;
+	}
 
 	//! Compare the key with the prefix of the node, return the number matching bytes
 	static uint32_t PrefixMismatch(ART &art, Node *node, Key &key, uint64_t depth);
@@ -62,6 +72,17 @@ public:
 	//! Erase entry from node
 	static void Erase(ART &art, unique_ptr<Node> &node, idx_t pos);
 
+	//! Serialize the node and (before it) its children, returns the pointer to the serialized node. Unless rewrite is
+	//! set, unmodified subtrees are not written again: the pointer to their location on disk is used instead.
+	BlockPointer Serialize(ART &art, MetaBlockWriter &writer, bool rewrite);
+	//! Deserialize the node stored at the pointer. The children of the node are swizzled, i.e. they are only loaded
+	//! when they are accessed through GetChild.
+	static unique_ptr<Node> Deserialize(ART &art, BlockPointer pointer);
+	//! Load the node if it is swizzled
+	static unique_ptr<Node> *Unswizzle(ART &art, unique_ptr<Node> &node);
+	//! Replace all unmodified subtrees of the node by their location on disk, releasing their memory
+	static void Swizzle(ART &art, unique_ptr<Node> &node);
+
 protected:
 	//! Copies the prefix from the source to the destination node
 	static void CopyPrefix(ART &art, Node *src, Node *dst);
@@ -8,14 +8,19 @@
 
 #pragma once
 
+#include "duckdb/common/atomic.hpp"
 #include "duckdb/common/common.hpp"
 #include "duckdb/common/types/data_chunk.hpp"
 #include "duckdb/common/types/row_layout.hpp"
+#include "duckdb/common/types/spillable_chunk_collection.hpp"
 #include "duckdb/common/types/vector.hpp"
 #include "duckdb/execution/aggregate_hashtable.hpp"
+#include "duckdb/execution/partitionable_hashtable.hpp"
 #include "duckdb/planner/operator/logical_comparison_join.hpp"
 #include "duckdb/storage/storage_info.hpp"
 
+#include <condition_variable>
+
 namespace duckdb {
 class BufferManager;
 class BufferHandle;
@@ -42,6 +47,10 @@ struct JoinHTScanState {
    [POINTER]
    [POINTER]
    The pointers are either NULL
+   When the build side does not fit in memory, the JoinHashTable switches to
+   an external mode. The build and probe side are then radix-partitioned on
+   their hashes into spillable collections, and the partitions are loaded
+   and probed one at a time.
 */
 class JoinHashTable {
 public:
@@ -119,6 +128,10 @@ private:
 
 	idx_t AppendToBlock(HTDataBlock &block, BufferHandle &handle, vector<BlockAppendEntry> &append_entries,
 	                    idx_t remaining);
+	//! Serialize the given rows into the blocks of the HT. If check_memory is set and the build side no longer fits in
+	//! memory the HT is partitioned instead and false is returned.
+	bool AppendRows(DataChunk &keys, unique_ptr<VectorData[]> &key_data, DataChunk &payload, Vector &hashes,
+	                const SelectionVector &sel, idx_t added_count, bool check_memory);
 
 	void Hash(DataChunk &keys, const SelectionVector &sel, idx_t count, Vector &hashes);
 
@@ -132,13 +145,37 @@ public:
 	//! Finalize the build of the HT, constructing the actual hash table and making the HT ready for probing. Finalize
 	//! must be called before any call to Probe, and after Finalize is called Build should no longer be ever called.
 	void Finalize();
+	//! Finalize the HT in parallel: InitializePointerTable allocates the pointer table, after which InsertBlocks can be
+	//! called concurrently for disjoint ranges of blocks. Cannot be used for an external HT.
+	void InitializePointerTable();
+	void InsertBlocks(idx_t block_idx_start, idx_t block_idx_end, bool parallel);
+	//! The amount of blocks holding the entries of the HT
+	idx_t BlockCount() {
+		return blocks.size();
+	}
 	//! Probe the HT with the given input chunk, resulting in the given result
 	unique_ptr<ScanStructure> Probe(DataChunk &keys);
 	//! Scan the HT to construct the final full outer join result after
 	void ScanFullOuter(DataChunk &result, JoinHTScanState &state);
 
+	//! The total amount of entries in the HT, including the entries of partitions that are not loaded
 	idx_t size() {
-		return count;
+		return total_count;
+	}
+	//! Whether or not the build side did not fit in memory and the HT has been partitioned
+	bool IsExternal() {
+		return external;
+	}
+	//! External HT only: append the rows of the probe side that do not belong to the loaded partition to their
+	//! partition. The rows that do belong to the loaded partition are written to the selection vector and their count
+	//! is returned.
+	idx_t PartitionProbeSide(DataChunk &keys, DataChunk &payload, SelectionVector &sel);
+	//! External HT only: load the next partition into memory, returns false if all partitions have been processed
+	bool LoadNextPartition();
+	//! External HT only: the rows of the probe side that were partitioned into the loaded partition
+	SpillableChunkCollection &GetProbePartition() {
+		D_ASSERT(external);
+		return *probe_partitions[current_partition];
 	}
 
 	//! The stringheap of the JoinHashTable
@@ -198,14 +235,45 @@ private:
 	void ApplyBitmask(Vector &hashes, idx_t count);
 	void ApplyBitmask(Vector &hashes, const SelectionVector &sel, idx_t count, Vector &pointers);
 	//! Insert the given set of locations into the HT with the given set of
-	//! hashes. Caller should hold lock in parallel HT.
-	void InsertHashes(Vector &hashes, idx_t count, data_ptr_t key_locations[]);
+	//! hashes. If parallel is set, the locations are inserted with atomic compare-and-swap operations.
+	void InsertHashes(Vector &hashes, idx_t count, data_ptr_t key_locations[], bool parallel);
 
 	idx_t PrepareKeys(DataChunk &keys, unique_ptr<VectorData[]> &key_data, const SelectionVector *&current_sel,
 	                  SelectionVector &sel, bool build_side);
 
+	//! Construct the pointer table from the entries that are stored in the blocks
+	void BuildPointerTable();
+	//! Whether or not the entries of the HT no longer fit in the memory budget after adding the given amount of rows
+	bool ExceedsMemoryBudget(idx_t added_count);
+	//! The memory needed by the HT with the given amount of entries
+	idx_t SizeInBytes(idx_t entry_count);
+	//! Switch to an external HT: move all entries of the HT into the build partitions. The lock on ht_lock is
+	//! released while waiting for the threads that are still appending to the blocks.
+	void PartitionBuildSide(unique_lock<mutex> &append_lock);
+	//! Append the rows (keys, payload and hash) to their partitions
+	void AppendToPartitions(DataChunk &rows, Vector &hashes, const SelectionVector &sel, idx_t row_count,
+	                        vector<unique_ptr<SpillableChunkCollection>> &partitions);
+	//! Release the entries of the currently loaded partition and load the given partition
+	void LoadPartition(idx_t partition_idx);
+
 	//! The amount of entries stored in the HT currently
 	idx_t count;
+	//! The total amount of entries in the HT, set after finalization
+	idx_t total_count;
+	//! The amount of threads that are currently appending to the blocks of the HT, protected by ht_lock
+	idx_t active_builders;
+	//! Signaled when the last thread that is appending to the blocks of the HT is done
+	std::condition_variable builders_done;
+	//! Whether or not the HT has been partitioned because the build side does not fit in memory
+	bool external;
+	//! The radix partitioning of an external HT
+	unique_ptr<RadixPartitionInfo> partition_info;
+	//! The partitioned entries of the build side (keys, payload and hash) of an external HT
+	vector<unique_ptr<SpillableChunkCollection>> build_partitions;
+	//! The partitioned rows of the probe side (payload and keys) of an external HT
+	vector<unique_ptr<SpillableChunkCollection>> probe_partitions;
+	//! The partition of an external HT that is currently loaded
+	idx_t current_partition;
 	//! The blocks holding the main data of the hash table
 	vector<HTDataBlock> blocks;
 	//! Pinned handles, these are pinned during finalization only
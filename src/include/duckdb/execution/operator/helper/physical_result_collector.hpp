@@ -0,0 +1,43 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/execution/operator/helper/physical_result_collector.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/execution/physical_sink.hpp"
+
+namespace duckdb {
+
+//! PhysicalResultCollector collects the result of the final pipeline of a query, so that the final pipeline can be
+//! executed in parallel. The chunks are collected per batch of the source, and are returned in the order of the
+//! batches, so the result is in the same order as the result of a sequential execution.
+class PhysicalResultCollector : public PhysicalSink {
+public:
+	explicit PhysicalResultCollector(PhysicalOperator &plan);
+
+	//! The plan whose result is collected
+	PhysicalOperator &plan;
+
+public:
+	//! Whether or not the result of the plan can be produced in parallel by a result collector
+	static bool CanCollectInParallel(ClientContext &context, PhysicalOperator &plan);
+
+	void Sink(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate,
+	          DataChunk &input) const override;
+	void Combine(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate) override;
+	unique_ptr<GlobalOperatorState> GetGlobalState(ClientContext &context) override;
+	unique_ptr<LocalSinkState> GetLocalSinkState(ExecutionContext &context) override;
+	bool Finalize(Pipeline &pipeline, ClientContext &context, unique_ptr<GlobalOperatorState> gstate) override;
+	bool RequiresBatchIndex() const override {
+		return true;
+	}
+
+	void GetChunkInternal(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state) const override;
+	unique_ptr<PhysicalOperatorState> GetOperatorState() override;
+};
+
+} // namespace duckdb
@@ -12,6 +12,7 @@
 #include "duckdb/execution/join_hashtable.hpp"
 #include "duckdb/execution/operator/join/physical_comparison_join.hpp"
 #include "duckdb/execution/physical_operator.hpp"
+#include "duckdb/planner/filter/join_key_filter.hpp"
 #include "duckdb/planner/operator/logical_join.hpp"
 
 namespace duckdb {
@@ -34,6 +35,11 @@ public:
 	vector<LogicalType> build_types;
 	//! Duplicate eliminated types; only used for delim_joins (i.e. correlated subqueries)
 	vector<LogicalType> delim_types;
+	//! Filters on the join keys that have been pushed into the table scan on the probe side, they are filled while
+	//! the hash table is built (owned by the table scan)
+	vector<JoinKeyFilter *> join_key_filters;
+	//! The index of the condition that each of the join key filters belongs to
+	vector<idx_t> join_key_filter_conditions;
 
 public:
 	unique_ptr<GlobalOperatorState> GetGlobalState(ClientContext &context) override;
@@ -48,8 +54,13 @@ public:
 
 	void FinalizeOperatorState(PhysicalOperatorState &state, ExecutionContext &context) override;
 
+	//! Whether or not the build side did not fit in memory and the hash table has been partitioned. The probe of an
+	//! external hash join is performed one partition at a time, and can therefore not be parallelized.
+	bool IsExternal() const;
+
 private:
 	void ProbeHashTable(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state_p) const;
+	void ProbeExternalHashTable(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state_p) const;
 };
 
 } // namespace duckdb
@@ -13,6 +13,7 @@
 #include "duckdb/function/scalar/strftime.hpp"
 #include "duckdb/common/types/chunk_collection.hpp"
 #include "duckdb/common/enums/file_compression_type.hpp"
+#include "duckdb/common/limits.hpp"
 
 #include <map>
 #include <sstream>
@@ -93,6 +94,9 @@ struct BufferedCSVReaderOptions {
 	idx_t buffer_size = STANDARD_VECTOR_SIZE * 100;
 	//! Consider all columns to be of type varchar
 	bool all_varchar = false;
+	//! Whether or not the file can be split into byte ranges that are read by multiple threads. Off by default: a
+	//! range cannot find the start of its first row if the file has newlines inside quoted values.
+	bool parallel = false;
 	//! The date format to use (if any is specified)
 	std::map<LogicalTypeId, StrpTimeFormat> date_format = {{LogicalTypeId::DATE, {}}, {LogicalTypeId::TIMESTAMP, {}}};
 	//! Whether or not a type format is specified
@@ -164,6 +168,10 @@ public:
 	bool bom_checked = false;
 
 	idx_t bytes_in_chunk = 0;
+	//! The byte offset of the start of the buffer within the file (only tracked for plain file sources)
+	idx_t buffer_offset = 0;
+	//! The byte offset at which the reader stops: rows that start at or after this offset are not read
+	idx_t range_end = NumericLimits<idx_t>::Maximum();
 	double bytes_per_line_avg = 0;
 
 	vector<unique_ptr<char[]>> cached_buffers;
@@ -177,6 +185,9 @@ public:
 public:
 	//! Extract a single DataChunk from the CSV file and stores it in insert_chunk
 	void ParseCSV(DataChunk &insert_chunk);
+	//! Restrict the reader to the rows that start within the byte range [range_start, range_end) of the file. If the
+	//! range does not start at the beginning of the file, the reader seeks to the first row that starts in the range.
+	void SetRange(idx_t range_start, idx_t range_end);
 
 private:
 	//! Initialize Parser
@@ -221,6 +232,10 @@ private:
 	void Flush(DataChunk &insert_chunk);
 	//! Reads a new buffer from the CSV file if the current one has been exhausted
 	bool ReadBuffer(idx_t &start);
+	//! Whether or not the reader has reached the end of its byte range; only checked at the start of a row
+	inline bool RangeExhausted() {
+		return buffer_offset + position >= range_end;
+	}
 
 	unique_ptr<FileHandle> OpenCSV(const BufferedCSVReaderOptions &options);
 };
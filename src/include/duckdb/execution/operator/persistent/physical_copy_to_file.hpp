@@ -18,15 +18,25 @@ namespace duckdb {
 class PhysicalCopyToFile : public PhysicalSink {
 public:
 	PhysicalCopyToFile(vector<LogicalType> types, CopyFunction function, unique_ptr<FunctionData> bind_data,
-	                   idx_t estimated_cardinality)
+	                   bool preserve_order, idx_t estimated_cardinality)
 	    : PhysicalSink(PhysicalOperatorType::COPY_TO_FILE, move(types), estimated_cardinality), function(function),
-	      bind_data(move(bind_data)) {
+	      bind_data(move(bind_data)), preserve_order(preserve_order) {
 	}
 
 	CopyFunction function;
 	unique_ptr<FunctionData> bind_data;
+	//! Whether or not the rows have to be written to the file in the order in which they are produced
+	bool preserve_order;
 
 public:
+	//! Whether or not the copy function can serialize batches of rows in parallel
+	bool SupportsParallelWrite() const {
+		return function.copy_to_prepare_batch && function.copy_to_flush_batch;
+	}
+	bool RequiresBatchIndex() const override {
+		return preserve_order && SupportsParallelWrite();
+	}
+
 	void GetChunkInternal(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state) const override;
 
 	void Sink(ExecutionContext &context, GlobalOperatorState &gstate, LocalSinkState &lstate,
@@ -34,6 +44,8 @@ public:
 	void Combine(ExecutionContext &context, GlobalOperatorState &gstate, LocalSinkState &lstate) override;
 	bool Finalize(Pipeline &pipeline, ClientContext &context, unique_ptr<GlobalOperatorState> gstate) override;
 	unique_ptr<LocalSinkState> GetLocalSinkState(ExecutionContext &context) override;
+	void InitializeLocalSinkState(ExecutionContext &context, GlobalOperatorState &gstate,
+	                              LocalSinkState &lstate) const override;
 	unique_ptr<GlobalOperatorState> GetGlobalState(ClientContext &context) override;
 };
 } // namespace duckdb
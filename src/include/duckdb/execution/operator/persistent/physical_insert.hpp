@@ -16,21 +16,32 @@ namespace duckdb {
 class PhysicalInsert : public PhysicalSink {
 public:
 	PhysicalInsert(vector<LogicalType> types, TableCatalogEntry *table, vector<idx_t> column_index_map,
-	               vector<unique_ptr<Expression>> bound_defaults, idx_t estimated_cardinality)
+	               vector<unique_ptr<Expression>> bound_defaults, idx_t estimated_cardinality, bool parallel)
 	    : PhysicalSink(PhysicalOperatorType::INSERT, move(types), estimated_cardinality),
-	      column_index_map(std::move(column_index_map)), table(table), bound_defaults(move(bound_defaults)) {
+	      column_index_map(std::move(column_index_map)), table(table), bound_defaults(move(bound_defaults)),
+	      parallel(parallel) {
 	}
 
 	vector<idx_t> column_index_map;
 	TableCatalogEntry *table;
 	vector<unique_ptr<Expression>> bound_defaults;
+	//! Whether or not the insert can be executed in parallel, i.e. every thread builds its own row groups. The row
+	//! groups are appended in the order of the batches of the source: the rows keep the order of a table (or Parquet)
+	//! scan, for other sources they are appended in the order in which the threads produce them.
+	bool parallel;
 
 public:
 	unique_ptr<GlobalOperatorState> GetGlobalState(ClientContext &context) override;
 	void Combine(ExecutionContext &context, GlobalOperatorState &gstate, LocalSinkState &lstate) override;
 	unique_ptr<LocalSinkState> GetLocalSinkState(ExecutionContext &context) override;
+	void InitializeLocalSinkState(ExecutionContext &context, GlobalOperatorState &gstate,
+	                              LocalSinkState &lstate) const override;
 	void Sink(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate,
 	          DataChunk &input) const override;
+	bool Finalize(Pipeline &pipeline, ClientContext &context, unique_ptr<GlobalOperatorState> gstate) override;
+	bool RequiresBatchIndex() const override {
+		return parallel;
+	}
 
 	void GetChunkInternal(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state) const override;
 };
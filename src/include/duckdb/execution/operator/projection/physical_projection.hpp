@@ -25,6 +25,12 @@ public:
 public:
 	void GetChunkInternal(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state) const override;
 
+	bool IsStreaming() const override {
+		return true;
+	}
+	void ExecuteInternal(ExecutionContext &context, DataChunk &input, DataChunk &chunk,
+	                     PhysicalOperatorState *state) const override;
+
 	unique_ptr<PhysicalOperatorState> GetOperatorState() override;
 	void FinalizeOperatorState(PhysicalOperatorState &state, ExecutionContext &context) override;
 
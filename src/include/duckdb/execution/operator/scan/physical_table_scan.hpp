@@ -39,6 +39,11 @@ public:
 
 	void GetChunkInternal(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state) const override;
 	unique_ptr<PhysicalOperatorState> GetOperatorState() override;
+
+	//! Whether or not the scan can hand out the batch index of the data it scans in parallel
+	bool SupportsBatchIndex() const;
+	//! Returns the batch index of the chunk that was last returned by the scan
+	idx_t GetBatchIndex(ExecutionContext &context, PhysicalOperatorState *state) const;
 };
 
 } // namespace duckdb
@@ -26,9 +26,18 @@ public:
 
 public:
 	unique_ptr<GlobalOperatorState> GetGlobalState(ClientContext &context) override;
+	unique_ptr<LocalSinkState> GetLocalSinkState(ExecutionContext &context) override;
 
+	void InitializeLocalSinkState(ExecutionContext &context, GlobalOperatorState &gstate,
+	                              LocalSinkState &lstate) const override;
 	void Sink(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate,
 	          DataChunk &input) const override;
+	void Combine(ExecutionContext &context, GlobalOperatorState &gstate, LocalSinkState &lstate) override;
+	bool Finalize(Pipeline &pipeline, ClientContext &context, unique_ptr<GlobalOperatorState> gstate) override;
+	//! The row groups are appended in the order of the batches of the source
+	bool RequiresBatchIndex() const override {
+		return true;
+	}
 
 	void GetChunkInternal(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state) const override;
 };
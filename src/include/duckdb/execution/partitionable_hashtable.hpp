@@ -9,6 +9,7 @@
 #pragma once
 
 #include "duckdb/execution/aggregate_hashtable.hpp"
+#include "duckdb/common/types/spillable_chunk_collection.hpp"
 
 namespace duckdb {
 
@@ -35,6 +36,18 @@ public:
 	HashTableList GetPartition(idx_t partition);
 	HashTableList GetUnpartitioned();
 
+	//! Stop growing the hash tables: the groups and payload of all subsequent chunks are appended to one spillable
+	//! collection per partition instead, which are aggregated when the partition is finalized
+	void Spill();
+	bool IsSpilling();
+	//! Returns the spilled input of the partition, or nullptr if nothing was spilled. The rows of the returned
+	//! collection consist of the group columns followed by the payload columns.
+	unique_ptr<SpillableChunkCollection> GetSpilledPartition(idx_t partition);
+	//! The amount of memory held by the hash tables
+	idx_t SizeInBytes();
+	//! The size of the spilled input in bytes
+	idx_t SpilledSizeInBytes();
+
 	void Finalize();
 
 private:
@@ -53,6 +66,10 @@ private:
 	HashTableList unpartitioned_hts;
 	unordered_map<hash_t, HashTableList> radix_partitioned_hts;
 
+	bool is_spilling;
+	vector<unique_ptr<SpillableChunkCollection>> spilled_partitions;
+	DataChunk spill_chunk;
+
 private:
 	idx_t ListAddChunk(HashTableList &list, DataChunk &groups, Vector &group_hashes, DataChunk &payload);
 };
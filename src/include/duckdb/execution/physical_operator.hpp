@@ -48,6 +48,10 @@ public:
    GetChunk again on its child nodes. Every node in the operator chain has a
    state that is updated as GetChunk is called: PhysicalOperatorState (different
    operators subclass this state and add different properties).
+
+   Streaming operators (e.g. filters and projections) can also be executed
+   push-based: pipelines pull chunks from their source and push them through
+   the chain of streaming operators into the sink by calling Execute.
 */
 class PhysicalOperator {
 public:
@@ -95,6 +99,17 @@ public:
 
 	void GetChunk(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state) const;
 
+	//! Whether or not this is a streaming operator, i.e. an operator that transforms every chunk of its child into at
+	//! most one output chunk, and that can therefore be executed push-based with Execute
+	virtual bool IsStreaming() const {
+		return false;
+	}
+	//! Pushes a chunk produced by children[0] through a streaming operator and stores the result in chunk
+	virtual void ExecuteInternal(ExecutionContext &context, DataChunk &input, DataChunk &chunk,
+	                             PhysicalOperatorState *state) const;
+
+	void Execute(ExecutionContext &context, DataChunk &input, DataChunk &chunk, PhysicalOperatorState *state) const;
+
 	//! Create a new empty instance of the operator state
 	virtual unique_ptr<PhysicalOperatorState> GetOperatorState() {
 		return make_unique<PhysicalOperatorState>(*this, children.size() == 0 ? nullptr : children[0].get());
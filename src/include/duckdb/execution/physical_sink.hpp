@@ -22,8 +22,14 @@ public:
 
 class LocalSinkState {
 public:
+	LocalSinkState() : batch_index(0) {
+	}
 	virtual ~LocalSinkState() {
 	}
+
+	//! The index of the batch of the source that the input of the current Sink call belongs to. Only set for sinks
+	//! that require the batch index.
+	idx_t batch_index;
 };
 
 class PhysicalSink : public PhysicalOperator {
@@ -54,10 +60,21 @@ public:
 	virtual unique_ptr<LocalSinkState> GetLocalSinkState(ExecutionContext &context) {
 		return make_unique<LocalSinkState>();
 	}
+	//! Called by every thread that executes the pipeline once its local state has been created, before any of its
+	//! input is sunk
+	virtual void InitializeLocalSinkState(ExecutionContext &context, GlobalOperatorState &gstate,
+	                                      LocalSinkState &lstate) const {
+	}
 	virtual unique_ptr<GlobalOperatorState> GetGlobalState(ClientContext &context) {
 		return make_unique<GlobalOperatorState>();
 	}
 
+	//! Whether or not the sink requires the batch index of its input, batches are produced by a single thread and their
+	//! indexes follow the order of the source (e.g. the row groups of a table)
+	virtual bool RequiresBatchIndex() const {
+		return false;
+	}
+
 	bool IsSink() const override {
 		return true;
 	}
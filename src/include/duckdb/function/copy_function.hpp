@@ -13,6 +13,7 @@
 #include "duckdb/parser/parsed_data/copy_info.hpp"
 
 namespace duckdb {
+class ChunkCollection;
 class ExecutionContext;
 
 struct LocalFunctionData {
@@ -25,6 +26,12 @@ struct GlobalFunctionData {
 	}
 };
 
+//! A batch of rows that has been serialized by the copy function, but has not been written to the file yet
+struct PreparedBatchData {
+	virtual ~PreparedBatchData() {
+	}
+};
+
 typedef unique_ptr<FunctionData> (*copy_to_bind_t)(ClientContext &context, CopyInfo &info, vector<string> &names,
                                                    vector<LogicalType> &sql_types);
 typedef unique_ptr<LocalFunctionData> (*copy_to_initialize_local_t)(ClientContext &context, FunctionData &bind_data);
@@ -34,6 +41,13 @@ typedef void (*copy_to_sink_t)(ClientContext &context, FunctionData &bind_data,
 typedef void (*copy_to_combine_t)(ClientContext &context, FunctionData &bind_data, GlobalFunctionData &gstate,
                                   LocalFunctionData &lstate);
 typedef void (*copy_to_finalize_t)(ClientContext &context, FunctionData &bind_data, GlobalFunctionData &gstate);
+//! Serializes (and compresses) a batch of rows in memory. Can be called concurrently from multiple threads.
+typedef unique_ptr<PreparedBatchData> (*copy_to_prepare_batch_t)(ClientContext &context, FunctionData &bind_data,
+                                                                 GlobalFunctionData &gstate,
+                                                                 ChunkCollection &collection);
+//! Appends a prepared batch to the file. Batches are flushed one at a time, in the order in which they were produced.
+typedef void (*copy_to_flush_batch_t)(ClientContext &context, FunctionData &bind_data, GlobalFunctionData &gstate,
+                                      PreparedBatchData &batch);
 
 typedef unique_ptr<FunctionData> (*copy_from_bind_t)(ClientContext &context, CopyInfo &info,
                                                      vector<string> &expected_names,
@@ -43,7 +57,8 @@ class CopyFunction : public Function {
 public:
 	explicit CopyFunction(string name)
 	    : Function(name), copy_to_bind(nullptr), copy_to_initialize_local(nullptr), copy_to_initialize_global(nullptr),
-	      copy_to_sink(nullptr), copy_to_combine(nullptr), copy_to_finalize(nullptr), copy_from_bind(nullptr) {
+	      copy_to_sink(nullptr), copy_to_combine(nullptr), copy_to_finalize(nullptr), copy_to_prepare_batch(nullptr),
+	      copy_to_flush_batch(nullptr), copy_from_bind(nullptr) {
 	}
 
 	copy_to_bind_t copy_to_bind;
@@ -52,6 +67,9 @@ public:
 	copy_to_sink_t copy_to_sink;
 	copy_to_combine_t copy_to_combine;
 	copy_to_finalize_t copy_to_finalize;
+	//! If set, the rows are serialized in parallel with copy_to_prepare_batch instead of being passed to copy_to_sink
+	copy_to_prepare_batch_t copy_to_prepare_batch;
+	copy_to_flush_batch_t copy_to_flush_batch;
 
 	copy_from_bind_t copy_from_bind;
 	TableFunction copy_from_function;
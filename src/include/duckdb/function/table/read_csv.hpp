@@ -39,8 +39,6 @@ struct WriteCSVData : public BaseCSVData {
 	string newline = "\n";
 	//! Whether or not we are writing a simple CSV (delimiter, quote and escape are all 1 byte in length)
 	bool is_simple;
-	//! The size of the CSV file (in bytes) that we buffer before we flush it to disk
-	idx_t flush_size = 4096 * 8;
 };
 
 struct ReadCSVData : public BaseCSVData {
@@ -51,6 +49,8 @@ struct ReadCSVData : public BaseCSVData {
 	//! The initial reader (if any): this is used when automatic detection is used during binding.
 	//! In this case, the CSV reader is already created and might as well be re-used.
 	unique_ptr<BufferedCSVReader> initial_reader;
+	//! The reader options with the dialect that was detected during binding (if any), used for parallel reads
+	BufferedCSVReaderOptions detected_options;
 	//! Total File Size
 	atomic<idx_t> file_size;
 	//! How many bytes were read up to this point
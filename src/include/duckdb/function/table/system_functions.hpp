@@ -48,6 +48,14 @@ struct PragmaDatabaseSize {
 	static void RegisterFunction(BuiltinFunctions &set);
 };
 
+struct PragmaTaskSchedulerInfo {
+	static void RegisterFunction(BuiltinFunctions &set);
+};
+
+struct PragmaBufferManagerInfo {
+	static void RegisterFunction(BuiltinFunctions &set);
+};
+
 struct DuckDBSchemasFun {
 	static void RegisterFunction(BuiltinFunctions &set);
 };
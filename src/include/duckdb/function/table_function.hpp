@@ -61,6 +61,8 @@ typedef unique_ptr<FunctionOperatorData> (*table_function_init_parallel_t)(Clien
 typedef bool (*table_function_parallel_state_next_t)(ClientContext &context, const FunctionData *bind_data,
                                                      FunctionOperatorData *state, ParallelState *parallel_state);
 typedef int (*table_function_progress_t)(ClientContext &context, const FunctionData *bind_data);
+typedef idx_t (*table_function_get_batch_index_t)(ClientContext &context, const FunctionData *bind_data,
+                                                  FunctionOperatorData *operator_state, ParallelState *parallel_state);
 typedef void (*table_function_dependency_t)(unordered_set<CatalogEntry *> &dependencies, const FunctionData *bind_data);
 typedef unique_ptr<NodeStatistics> (*table_function_cardinality_t)(ClientContext &context,
                                                                    const FunctionData *bind_data);
@@ -86,7 +88,7 @@ public:
 	      statistics(statistics), cleanup(cleanup), dependency(dependency), cardinality(cardinality),
 	      pushdown_complex_filter(pushdown_complex_filter), to_string(to_string), max_threads(max_threads),
 	      init_parallel_state(init_parallel_state), parallel_function(parallel_function), parallel_init(parallel_init),
-	      parallel_state_next(parallel_state_next), table_scan_progress(query_progress),
+	      parallel_state_next(parallel_state_next), table_scan_progress(query_progress), get_batch_index(nullptr),
 	      projection_pushdown(projection_pushdown), filter_pushdown(filter_pushdown) {
 	}
 	TableFunction(const vector<LogicalType> &arguments, table_function_t function, table_function_bind_t bind = nullptr,
@@ -104,7 +106,7 @@ public:
 	                    pushdown_complex_filter, to_string, max_threads, init_parallel_state, parallel_function,
 	                    parallel_init, parallel_state_next, projection_pushdown, filter_pushdown, query_progress) {
 	}
-	TableFunction() : SimpleNamedParameterFunction("", {}) {
+	TableFunction() : SimpleNamedParameterFunction("", {}), get_batch_index(nullptr) {
 	}
 
 	//! Bind function
@@ -147,6 +149,9 @@ public:
 	table_function_parallel_state_next_t parallel_state_next;
 	//! (Optional) return how much of the table we have scanned up to this point (% of the data)
 	table_function_progress_t table_scan_progress;
+	//! (Optional) return the index of the batch that is currently being scanned in a parallel scan. Batches are handed
+	//! out in the order of the source, so the batch index can be used to restore the order of the scanned data.
+	table_function_get_batch_index_t get_batch_index;
 	//! Whether or not the table function supports projection pushdown. If not supported a projection will be added
 	//! that filters out unused columns.
 	bool projection_pushdown;
@@ -18,6 +18,7 @@
 #include "duckdb/function/replacement_scan.hpp"
 #include "duckdb/common/set.hpp"
 #include "duckdb/common/enums/optimizer_type.hpp"
+#include "duckdb/common/enums/compression_type.hpp"
 
 namespace duckdb {
 class ClientContext;
@@ -96,6 +97,8 @@ public:
 	bool initialize_default_database = true;
 	//! The set of disabled optimizers (default empty)
 	set<OptimizerType> disabled_optimizers;
+	//! Force a specific compression method to be used when checkpointing (if available)
+	CompressionType force_compression = CompressionType::COMPRESSION_AUTO;
 
 public:
 	DUCKDB_API static DBConfig &GetConfig(ClientContext &context);
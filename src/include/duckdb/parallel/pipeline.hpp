@@ -77,6 +77,10 @@ public:
 private:
 	//! The child from which to pull chunks
 	PhysicalOperator *child;
+	//! The chain of streaming operators at the top of the child, these are executed push-based (from the sink down)
+	vector<PhysicalOperator *> operators;
+	//! The operator below the streaming operators from which chunks are pulled
+	PhysicalOperator *source;
 	//! The global sink state
 	unique_ptr<GlobalOperatorState> sink_state;
 	//! The sink (i.e. destination) for data; this is e.g. a hash table to-be-built
@@ -101,6 +105,9 @@ private:
 
 private:
 	bool GetProgress(ClientContext &context, PhysicalOperator *op, int &current_percentage);
+	void InitializeOperators();
+	//! Pushes a chunk from the source through the streaming operators, returns false if no tuples remain
+	bool ExecuteOperators(ExecutionContext &context, vector<PhysicalOperatorState *> &states, DataChunk &result);
 	void ScheduleSequentialTask();
 	bool LaunchScanTasks(PhysicalOperator *op, idx_t max_threads, unique_ptr<ParallelState> parallel_state);
 	bool ScheduleOperator(PhysicalOperator *op);
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include "duckdb/common/chrono.hpp"
+
 namespace duckdb {
 
 class Task {
@@ -17,6 +19,9 @@ public:
 
 	//! Execute the task
 	virtual void Execute() = 0;
+
+	//! The time at which the task was handed to the scheduler, used to measure how long it waited in the queue
+	time_point<std::chrono::steady_clock> schedule_time;
 };
 
 } // namespace duckdb
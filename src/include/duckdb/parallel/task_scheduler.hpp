@@ -23,6 +23,20 @@ class TaskScheduler;
 
 struct SchedulerThread;
 
+//! Counters on the tasks that passed through the task scheduler
+struct TaskSchedulerStatistics {
+	//! The amount of tasks that were scheduled
+	idx_t scheduled_tasks;
+	//! The amount of tasks that were taken from a queue to be executed
+	idx_t executed_tasks;
+	//! The amount of tasks that were stolen from the queue of another thread
+	idx_t stolen_tasks;
+	//! The total time the executed tasks spent waiting in a queue (in microseconds)
+	idx_t total_queue_wait_us;
+	//! The longest time a single task spent waiting in a queue (in microseconds)
+	idx_t max_queue_wait_us;
+};
+
 struct ProducerToken {
 	ProducerToken(TaskScheduler &scheduler, unique_ptr<QueueProducerToken> token);
 	~ProducerToken();
@@ -33,10 +47,13 @@ struct ProducerToken {
 };
 
 //! The TaskScheduler is responsible for managing tasks and threads
+/*!
+    Every background thread has its own task queue. Tasks that are scheduled from within a background thread are placed
+   in the queue of that thread, tasks scheduled by other threads are placed in a shared queue. The producer of a task
+   can fetch it from either queue. Threads that run out of work take tasks from the shared queue first, and then steal
+   from the queues of the other threads. Idle threads sleep until they are woken up by a newly scheduled task.
+*/
 class TaskScheduler {
-	// timeout for semaphore wait, default 50ms
-	constexpr static int64_t TASK_TIMEOUT_USECS = 50000;
-
 public:
 	TaskScheduler();
 	~TaskScheduler();
@@ -57,8 +74,15 @@ public:
 	//! Returns the number of threads
 	int32_t NumberOfThreads();
 
+	//! Returns the counters of the task scheduler
+	TaskSchedulerStatistics GetStatistics();
+
 private:
 	void SetThreadsInternal(int32_t n);
+	//! Update the counters for a task that was taken from one of the queues
+	void RecordQueueWait(Task &task);
+	//! Execute a task that was taken from one of the queues
+	void ExecuteTask(unique_ptr<Task> task);
 
 	//! The task queue
 	unique_ptr<ConcurrentQueue> queue;
@@ -66,6 +90,12 @@ private:
 	vector<unique_ptr<SchedulerThread>> threads;
 	//! Markers used by the various threads, if the markers are set to "false" the thread execution is stopped
 	vector<unique_ptr<atomic<bool>>> markers;
+
+	atomic<idx_t> scheduled_tasks;
+	atomic<idx_t> executed_tasks;
+	atomic<idx_t> stolen_tasks;
+	atomic<idx_t> total_queue_wait_us;
+	atomic<idx_t> max_queue_wait_us;
 };
 
 } // namespace duckdb
@@ -0,0 +1,74 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/planner/filter/join_key_filter.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/types/selection_vector.hpp"
+#include "duckdb/common/types/validity_mask.hpp"
+#include "duckdb/planner/filter/constant_filter.hpp"
+
+namespace duckdb {
+class Vector;
+
+//! The JoinKeyFilter is pushed into the table scan on the probe side of a hash join. While the hash table is built it
+//! collects the range and a bloom filter of the build keys. Once it is published, rows of the probe side that cannot
+//! find a join partner are discarded by the scan, and row groups and segments outside of the range are skipped.
+class JoinKeyFilter : public TableFilter {
+public:
+	explicit JoinKeyFilter(LogicalType key_type);
+
+	//! The type of the join keys
+	LogicalType key_type;
+
+public:
+	//! Whether or not join key filters can be created for join keys of the given type
+	static bool SupportsType(const LogicalType &type);
+
+	//! Prepares the filter for a (new) build of the hash table. The filter does not discard any rows until it is
+	//! published.
+	void Initialize(idx_t estimated_key_count);
+	//! Adds a chunk of build keys to the filter. Can be called concurrently from multiple threads.
+	void AddKeys(Vector &keys, idx_t count);
+	//! Enables the filter after all build keys have been added
+	void Publish();
+
+	//! Removes the rows from the selection vector that cannot match any of the build keys
+	void Select(Vector &vector, SelectionVector &sel, idx_t &approved_tuple_count, ValidityMask &mask) const;
+
+	//! Whether or not the bloom filter contains the given hash
+	bool BloomContains(hash_t hash) const;
+
+	FilterPropagateResult CheckStatistics(BaseStatistics &stats) override;
+	string ToString(const string &column_name) override;
+
+private:
+	//! Lock protecting the range of the build keys
+	mutex lock;
+	//! Whether or not all build keys have been added
+	bool published;
+	//! Whether or not any (non-NULL) build key has been added
+	bool has_keys;
+	//! The range of the build keys
+	int64_t min;
+	int64_t max;
+	//! The total amount of (non-NULL) build keys, including duplicates
+	atomic<idx_t> key_count;
+	//! The bloom filter of the build keys
+	unique_ptr<atomic<uint64_t>[]> bloom;
+	//! The log2 of the amount of bits in the bloom filter
+	idx_t bloom_shift;
+	//! Whether or not the bloom filter is selective enough to be used for filtering
+	bool use_bloom;
+	//! The range of the build keys as comparison filters (only set when published)
+	unique_ptr<ConstantFilter> lower_bound;
+	unique_ptr<ConstantFilter> upper_bound;
+};
+
+} // namespace duckdb
@@ -16,10 +16,13 @@ namespace duckdb {
 class LogicalCopyToFile : public LogicalOperator {
 public:
 	LogicalCopyToFile(CopyFunction function, unique_ptr<FunctionData> bind_data)
-	    : LogicalOperator(LogicalOperatorType::LOGICAL_COPY_TO_FILE), function(function), bind_data(move(bind_data)) {
+	    : LogicalOperator(LogicalOperatorType::LOGICAL_COPY_TO_FILE), function(function), bind_data(move(bind_data)),
+	      preserve_order(true) {
 	}
 	CopyFunction function;
 	unique_ptr<FunctionData> bind_data;
+	//! Whether or not the rows have to be written to the file in the order in which they are produced
+	bool preserve_order;
 
 protected:
 	void ResolveTypes() override {
@@ -21,7 +21,8 @@ enum class TableFilterType : uint8_t {
 	IS_NULL = 1,
 	IS_NOT_NULL = 2,
 	CONJUNCTION_OR = 3,
-	CONJUNCTION_AND = 4
+	CONJUNCTION_AND = 4,
+	JOIN_KEY = 5 // the build keys of a hash join (range and bloom filter)
 };
 
 //! TableFilter represents a filter pushed down into the table scan.
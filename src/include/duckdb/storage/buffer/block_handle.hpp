@@ -64,6 +64,9 @@ private:
 	const bool can_destroy;
 	//! The memory usage of the block
 	idx_t memory_usage;
+	//! The amount of times the block was pinned since it was loaded; blocks that are referenced more than once are
+	//! kept in memory in favor of blocks that were only touched by a single scan
+	idx_t access_count;
 };
 
 } // namespace duckdb
@@ -23,6 +23,21 @@ namespace duckdb {
 class DatabaseInstance;
 class TemporaryDirectoryHandle;
 struct EvictionQueue;
+struct ReadAheadQueue;
+
+//! Counters on the blocks that passed through the buffer manager
+struct BufferManagerStatistics {
+	//! The amount of times a block of the database file was pinned while it was already in memory
+	idx_t cache_hits;
+	//! The amount of times a block of the database file had to be read from disk when it was pinned
+	idx_t cache_misses;
+	//! The amount of blocks that were evicted to make room for other blocks
+	idx_t evicted_blocks;
+	//! The amount of temporary blocks that were written to the temporary directory
+	idx_t temporary_writes;
+	//! The amount of temporary blocks that were read back from the temporary directory
+	idx_t temporary_reads;
+};
 
 //! The buffer manager is in charge of handling memory management for the database. It hands out memory buffers that can
 //! be used by the database internally.
@@ -51,6 +66,9 @@ public:
 
 	unique_ptr<BufferHandle> Pin(shared_ptr<BlockHandle> &handle);
 	void Unpin(shared_ptr<BlockHandle> &handle);
+	//! Asynchronously load the given blocks into memory, so that pinning them later does not have to wait for the
+	//! disk. Only blocks of the base file are read ahead, and only if they fit in memory without evicting other blocks.
+	void Prefetch(const vector<shared_ptr<BlockHandle>> &handles);
 
 	void UnregisterBlock(block_id_t block_id, bool can_destroy);
 
@@ -74,7 +92,16 @@ public:
 
 	void SetTemporaryDirectory(string new_dir);
 
+	//! Returns the counters of the buffer manager
+	BufferManagerStatistics GetStatistics();
+
 private:
+	//! Pin a block; pins issued by the read-ahead threads do not count as references to the block
+	unique_ptr<BufferHandle> Pin(shared_ptr<BlockHandle> &handle, bool prefetch);
+	//! Count a pin of the given block, which is either already loaded or about to be loaded from disk
+	void RecordAccess(BlockHandle &handle, bool loaded);
+	//! Add an unpinned block to the eviction queue that matches its priority
+	void AddToEvictionQueue(shared_ptr<BlockHandle> &handle);
 	//! Evict blocks until the currently used memory + extra_memory fit, returns false if this was not possible
 	//! (i.e. not enough blocks could be evicted)
 	bool EvictBlocks(idx_t extra_memory, idx_t memory_limit);
@@ -90,6 +117,11 @@ private:
 
 	void RequireTemporaryDirectory();
 
+	//! Load a block that was requested by Prefetch, executed by the read-ahead threads
+	void LoadPrefetchedBlock(shared_ptr<BlockHandle> handle);
+	//! Run read-ahead requests until the buffer manager is destroyed
+	void ExecuteReadAhead();
+
 private:
 	//! The database instance
 	DatabaseInstance &db;
@@ -109,7 +141,15 @@ private:
 	unordered_map<block_id_t, weak_ptr<BlockHandle>> blocks;
 	//! Eviction queue
 	unique_ptr<EvictionQueue> queue;
+	//! Queue of blocks that should be read ahead, and the threads reading them
+	unique_ptr<ReadAheadQueue> read_ahead;
 	//! The temporary id used for managed buffers
 	atomic<block_id_t> temporary_id;
+
+	atomic<idx_t> cache_hits;
+	atomic<idx_t> cache_misses;
+	atomic<idx_t> evicted_blocks;
+	atomic<idx_t> temporary_writes;
+	atomic<idx_t> temporary_reads;
 };
 } // namespace duckdb
@@ -0,0 +1,104 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/storage/compression/bitpacking_segment.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/storage/uncompressed_segment.hpp"
+
+namespace duckdb {
+class Compressor;
+class DatabaseInstance;
+struct ColumnCheckpointState;
+
+//! Primitives for packing unsigned integers of a fixed bit width into (and out of) an array of 64-bit words
+struct BitpackingPrimitives {
+	//! Returns the minimum amount of bits required to store the given value
+	static uint8_t MinimumBitWidth(uint64_t value) {
+		uint8_t width = 0;
+		while (value > 0) {
+			value >>= 1;
+			width++;
+		}
+		return width;
+	}
+
+	//! Returns the amount of bytes required to store "count" values of "width" bits, rounded up to whole words
+	static idx_t PackedSize(idx_t count, uint8_t width) {
+		return (count * width + 63) / 64 * sizeof(uint64_t);
+	}
+
+	//! Packs a value at the specified index. The target memory must be zero-initialized.
+	static void PackValue(data_ptr_t target, idx_t index, uint8_t width, uint64_t value) {
+		if (width == 0) {
+			return;
+		}
+		auto words = (uint64_t *)target;
+		idx_t bit_position = index * width;
+		idx_t word_idx = bit_position / 64;
+		idx_t shift = bit_position % 64;
+		words[word_idx] |= value << shift;
+		if (shift + width > 64) {
+			words[word_idx + 1] |= value >> (64 - shift);
+		}
+	}
+
+	//! Unpacks the value at the specified index
+	static uint64_t UnpackValue(const_data_ptr_t source, idx_t index, uint8_t width) {
+		if (width == 0) {
+			return 0;
+		}
+		auto words = (const uint64_t *)source;
+		idx_t bit_position = index * width;
+		idx_t word_idx = bit_position / 64;
+		idx_t shift = bit_position % 64;
+		uint64_t result = words[word_idx] >> shift;
+		if (shift + width > 64) {
+			result |= words[word_idx + 1] << (64 - shift);
+		}
+		if (width < 64) {
+			result &= (uint64_t(1) << width) - 1;
+		}
+		return result;
+	}
+};
+
+//! The BitpackingSegment is a read-only segment that stores integers in groups of BITPACKING_GROUP_SIZE values. Every
+//! group stores a frame of reference (the minimum value of the group) and the offsets from that reference, bit-packed
+//! using the minimum bit width required for the group. The packed groups are stored at the start of the block, the
+//! per-group metadata is stored at the end of the block (growing backwards).
+class BitpackingSegment : public UncompressedSegment {
+public:
+	BitpackingSegment(DatabaseInstance &db, PhysicalType type, idx_t row_start, block_id_t block_id);
+
+	//! The amount of values stored in a single group
+	static constexpr const idx_t BITPACKING_GROUP_SIZE = 1024;
+
+public:
+	void InitializeScan(ColumnScanState &state) override;
+
+	void Scan(ColumnScanState &state, idx_t start, idx_t scan_count, Vector &result) override;
+	void ScanPartial(ColumnScanState &state, idx_t start, idx_t scan_count, Vector &result,
+	                 idx_t result_offset) override;
+
+	void FetchRow(ColumnFetchState &state, row_t row_id, Vector &result, idx_t result_idx) override;
+
+	idx_t Append(SegmentStatistics &stats, VectorData &data, idx_t offset, idx_t count) override;
+
+public:
+	//! Creates a compressor that writes bitpacked segments, or nullptr if the type is not supported
+	static unique_ptr<Compressor> CreateCompressor(ColumnCheckpointState &checkpoint_state, PhysicalType type);
+
+public:
+	typedef void (*scan_function_t)(data_ptr_t base, idx_t start, idx_t scan_count, Vector &result,
+	                                idx_t result_offset);
+
+private:
+	scan_function_t scan_function;
+};
+
+} // namespace duckdb
@@ -0,0 +1,74 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/storage/compression/compressor.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/enums/compression_type.hpp"
+#include "duckdb/common/types/vector.hpp"
+#include "duckdb/storage/block.hpp"
+#include "duckdb/storage/buffer/buffer_handle.hpp"
+#include "duckdb/storage/statistics/segment_statistics.hpp"
+
+namespace duckdb {
+class BlockHandle;
+class DatabaseInstance;
+class UncompressedSegment;
+struct ColumnCheckpointState;
+
+//! The Compressor is used to write the data of a column to disk in a compressed form at checkpoint time. The data is
+//! passed through the compressor twice: first to analyze whether or not (and how well) the data can be compressed, and
+//! then (if the compression method is selected) to actually compress the data into one or more blocks.
+class Compressor {
+public:
+	Compressor(ColumnCheckpointState &checkpoint_state, CompressionType type);
+	virtual ~Compressor();
+
+	//! The checkpoint state that compressed segments are flushed to
+	ColumnCheckpointState &checkpoint_state;
+	//! The compression method
+	CompressionType type;
+
+public:
+	//! Analyze a vector of data. Returns false if the data cannot be compressed using this compression method.
+	virtual bool Analyze(Vector &input, idx_t count) = 0;
+	//! Returns the estimated size (in bytes) of the analyzed data after compression
+	virtual idx_t EstimatedSize() = 0;
+	//! Compress a vector of data, flushing any full segments to the checkpoint state
+	virtual void Compress(Vector &input, idx_t count) = 0;
+	//! Flush any remaining data to the checkpoint state
+	virtual void Finalize() = 0;
+
+public:
+	//! Returns the set of compressors that can be used to compress data of the given type
+	static vector<unique_ptr<Compressor>> GetCompressors(ColumnCheckpointState &checkpoint_state, PhysicalType type,
+	                                                     CompressionType force_compression);
+	//! Returns the size (in bytes) the given data takes up when stored without compression
+	static idx_t UncompressedSize(Vector &input, idx_t count);
+	//! Creates a segment that reads data of the given compression method from the specified block
+	static unique_ptr<UncompressedSegment> CreateSegment(DatabaseInstance &db, CompressionType compression,
+	                                                     PhysicalType type, idx_t row_start, block_id_t block_id);
+
+protected:
+	//! The block of the segment that is currently being written (if any)
+	shared_ptr<BlockHandle> block;
+	//! The pinned handle of the current block
+	unique_ptr<BufferHandle> handle;
+	//! The statistics of the current segment
+	unique_ptr<SegmentStatistics> segment_stats;
+	//! The amount of tuples written to the current segment
+	idx_t tuple_count;
+
+protected:
+	//! Allocate a new, zero-initialized, block to write compressed data to
+	void CreateEmptySegment();
+	//! Write the current segment to disk
+	void FlushSegment();
+};
+
+} // namespace duckdb
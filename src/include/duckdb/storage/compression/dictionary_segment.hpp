@@ -0,0 +1,49 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/storage/compression/dictionary_segment.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/storage/uncompressed_segment.hpp"
+
+namespace duckdb {
+class Compressor;
+class DatabaseInstance;
+struct ColumnCheckpointState;
+
+//! The DictionarySegment is a read-only segment that stores strings as bit-packed indices into a dictionary of the
+//! distinct strings in the segment. The block starts with a header, followed by the packed indices, the offsets of the
+//! dictionary entries and finally the dictionary strings themselves. Index 0 is reserved for NULL values.
+class DictionarySegment : public UncompressedSegment {
+public:
+	DictionarySegment(DatabaseInstance &db, PhysicalType type, idx_t row_start, block_id_t block_id);
+
+	//! The size of the header at the start of the block
+	static constexpr const idx_t DICTIONARY_HEADER_SIZE = 4 * sizeof(uint32_t);
+	//! Strings larger than this are not stored in dictionary segments
+	static constexpr const idx_t DICTIONARY_STRING_LIMIT = 4096;
+
+public:
+	void InitializeScan(ColumnScanState &state) override;
+
+	void Scan(ColumnScanState &state, idx_t start, idx_t scan_count, Vector &result) override;
+	void ScanPartial(ColumnScanState &state, idx_t start, idx_t scan_count, Vector &result,
+	                 idx_t result_offset) override;
+
+	void FetchRow(ColumnFetchState &state, row_t row_id, Vector &result, idx_t result_idx) override;
+
+	idx_t Append(SegmentStatistics &stats, VectorData &data, idx_t offset, idx_t count) override;
+
+public:
+	//! Creates a compressor that writes dictionary segments, or nullptr if the type is not supported
+	static unique_ptr<Compressor> CreateCompressor(ColumnCheckpointState &checkpoint_state, PhysicalType type);
+
+private:
+	void ScanInternal(data_ptr_t base, idx_t start, idx_t scan_count, Vector &result, idx_t result_offset);
+};
+
+} // namespace duckdb
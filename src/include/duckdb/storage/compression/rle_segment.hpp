@@ -0,0 +1,55 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/storage/compression/rle_segment.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/storage/uncompressed_segment.hpp"
+
+namespace duckdb {
+class Compressor;
+class DatabaseInstance;
+struct ColumnCheckpointState;
+
+//! The RLESegment is a read-only segment that stores runs of identical values. The block holds the amount of runs,
+//! followed by the value of every run and the (exclusive) end row of every run.
+class RLESegment : public UncompressedSegment {
+public:
+	RLESegment(DatabaseInstance &db, PhysicalType type, idx_t row_start, block_id_t block_id);
+
+	//! The minimum average run length within a vector for the vector to be scanned as a dictionary vector
+	static constexpr const idx_t DICTIONARY_RUN_LENGTH = 4;
+
+public:
+	void InitializeScan(ColumnScanState &state) override;
+
+	void Scan(ColumnScanState &state, idx_t start, idx_t scan_count, Vector &result) override;
+	void ScanPartial(ColumnScanState &state, idx_t start, idx_t scan_count, Vector &result,
+	                 idx_t result_offset) override;
+
+	void FetchRow(ColumnFetchState &state, row_t row_id, Vector &result, idx_t result_idx) override;
+
+	idx_t Append(SegmentStatistics &stats, VectorData &data, idx_t offset, idx_t count) override;
+
+public:
+	//! Creates a compressor that writes RLE segments, or nullptr if the type is not supported
+	static unique_ptr<Compressor> CreateCompressor(ColumnCheckpointState &checkpoint_state, PhysicalType type);
+
+	//! Returns the offset of the run ends within the block
+	static idx_t GetRunEndOffset(idx_t run_count, idx_t type_size);
+
+public:
+	typedef void (*scan_function_t)(data_ptr_t base, idx_t start, idx_t scan_count, Vector &result,
+	                                idx_t result_offset);
+	typedef bool (*scan_compressed_function_t)(data_ptr_t base, idx_t start, idx_t scan_count, Vector &result);
+
+private:
+	scan_function_t scan_function;
+	scan_compressed_function_t scan_compressed_function;
+};
+
+} // namespace duckdb
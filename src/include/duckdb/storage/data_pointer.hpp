@@ -9,6 +9,7 @@
 #pragma once
 
 #include "duckdb/common/common.hpp"
+#include "duckdb/common/enums/compression_type.hpp"
 #include "duckdb/storage/statistics/base_statistics.hpp"
 #include "duckdb/storage/storage_info.hpp"
 #include "duckdb/storage/block.hpp"
@@ -20,6 +21,8 @@ struct DataPointer {
 	uint64_t row_start;
 	uint64_t tuple_count;
 	BlockPointer block_pointer;
+	//! The compression method used to store the segment
+	CompressionType compression_type;
 	//! Type-specific statistics of the segment
 	unique_ptr<BaseStatistics> statistics;
 };
@@ -154,6 +154,27 @@ public:
 
 	//! Append a DataChunk to the table. Throws an exception if the columns don't match the tables' columns.
 	void Append(TableCatalogEntry &table, ClientContext &context, DataChunk &chunk);
+	//! Verify the constraints of a DataChunk and append it to a thread-local collection instead of the transaction-local
+	//! storage. The collection can later be added to the table using MergeLocalCollection.
+	void LocalAppend(TableCatalogEntry &table, ClientContext &context, DataChunk &chunk,
+	                 ChunkCollection &local_collection);
+	//! Merge a thread-local collection into the table and reset it. Collections holding at least one full row group
+	//! are appended to the row groups of the base table directly, smaller collections are added to the
+	//! transaction-local storage (which requires the caller to serialize calls made within the same transaction).
+	//! Only supported for tables without indexes.
+	void MergeLocalCollection(ClientContext &context, ChunkCollection &local_collection);
+	//! Registers a thread of a parallel append that preserves the order of the batches of its input. Like
+	//! LocalAppend/MergeLocalCollection, only supported for tables without indexes.
+	void InitializeBatchAppend(BatchAppendState &state, LocalBatchAppendState &lstate);
+	//! Verify the constraints of a DataChunk of the given batch and append it to the current batch of the thread. The
+	//! batch indexes of a thread have to be increasing: the rows of the current batch are handed over to be merged into
+	//! the table once the thread moves on to the next batch (or gathered a full row group).
+	void LocalBatchAppend(TableCatalogEntry &table, ClientContext &context, DataChunk &chunk, idx_t batch_index,
+	                      BatchAppendState &state, LocalBatchAppendState &lstate);
+	//! Hands over the last batch of a thread that has finished appending
+	void FinishBatchAppend(ClientContext &context, BatchAppendState &state, LocalBatchAppendState &lstate);
+	//! Merges the remaining batches into the table once all threads have finished appending
+	void FinalizeBatchAppend(ClientContext &context, BatchAppendState &state);
 	//! Delete the entries with the specified row identifier from the table
 	idx_t Delete(TableCatalogEntry &table, ClientContext &context, Vector &row_ids, idx_t count);
 	//! Update the entries with the specified row identifier from the table
@@ -222,6 +243,12 @@ private:
 	void VerifyAppendConstraints(TableCatalogEntry &table, DataChunk &chunk);
 	//! Verify constraints with a chunk from the Update containing only the specified column_ids
 	void VerifyUpdateConstraints(TableCatalogEntry &table, DataChunk &chunk, const vector<column_t> &column_ids);
+	//! Hands over the rows of the current batch of a thread of an ordered parallel append, and moves the thread on to
+	//! the next batch
+	void HandOverBatch(ClientContext &context, BatchAppendState &state, LocalBatchAppendState &lstate, idx_t next_batch,
+	                   bool finished);
+	//! Merges the handed over rows that are next in line into the table
+	void MergeBatches(ClientContext &context, BatchAppendState &state, bool force);
 
 	void InitializeScanWithOffset(TableScanState &state, const vector<column_t> &column_ids, idx_t start_row,
 	                              idx_t end_row);
@@ -13,16 +13,24 @@
 #include "duckdb/common/types/data_chunk.hpp"
 #include "duckdb/parser/parsed_expression.hpp"
 #include "duckdb/planner/expression.hpp"
+#include "duckdb/storage/block.hpp"
 #include "duckdb/storage/table/scan_state.hpp"
 #include "duckdb/execution/expression_executor.hpp"
 
 namespace duckdb {
 
 class ClientContext;
+class MetaBlockWriter;
 class Transaction;
 
 struct IndexLock;
 
+//! The entries of a part of the table that are collected to construct an index in bulk
+struct IndexBuildState {
+	virtual ~IndexBuildState() {
+	}
+};
+
 //! The index is an abstract base class that serves as the basis for indexes
 class Index {
 public:
@@ -78,6 +86,30 @@ public:
 	//! Insert data into the index. Does not lock the index.
 	virtual bool Insert(IndexLock &lock, DataChunk &input, Vector &row_identifiers) = 0;
 
+	//! Initialize a state that collects the entries of a part of the table, which are then used to construct the
+	//! (empty) index in bulk. Returns nullptr if the index can only be constructed through Insert.
+	virtual unique_ptr<IndexBuildState> InitializeBuild() {
+		return nullptr;
+	}
+	//! Add the (resolved) entries of a chunk to the build state. Can be called concurrently for different states.
+	virtual void BuildAppend(IndexBuildState &state, DataChunk &input, Vector &row_identifiers) {
+	}
+	//! Called after all entries of a build state have been added. Can be called concurrently for different states.
+	virtual void FinishBuild(IndexBuildState &state) {
+	}
+	//! Construct the index from the entries of all build states. Returns false if the entries violate the unique
+	//! constraint of the index.
+	virtual bool Build(IndexLock &lock, vector<unique_ptr<IndexBuildState>> &states) {
+		throw InternalException("Index does not support bulk construction");
+	}
+
+	//! Serialize the index to the writer, returns the pointer to the serialized root. Returns an invalid pointer if
+	//! the index has no persistent representation and has to be rebuilt from the table on load.
+	virtual BlockPointer Serialize(MetaBlockWriter &writer);
+	//! Called when the table of the index is dropped
+	virtual void CommitDrop() {
+	}
+
 	//! Returns true if the index is affected by updates on the specified column ids, and false otherwise
 	bool IndexIsUpdated(const vector<column_t> &column_ids) const;
 
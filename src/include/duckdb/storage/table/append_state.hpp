@@ -12,6 +12,12 @@
 #include "duckdb/storage/storage_lock.hpp"
 #include "duckdb/storage/buffer/buffer_handle.hpp"
 #include "duckdb/common/vector.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/pair.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/types/chunk_collection.hpp"
+
+#include <map>
 
 namespace duckdb {
 class DataTable;
@@ -60,4 +66,33 @@ struct TableAppendState {
 	idx_t remaining_append_count;
 };
 
+//! The thread-local state of a parallel append that preserves the order of the batches of its input
+struct LocalBatchAppendState {
+	//! The index of this thread in the set of active threads
+	idx_t thread_index = 0;
+	//! The batch that the thread is currently appending
+	idx_t current_batch = 0;
+	//! The rows of the current batch
+	unique_ptr<ChunkCollection> collection;
+};
+
+//! The shared state of a parallel append that preserves the order of the batches of its input: the threads hand over
+//! the rows of their batches, and the rows are merged into the table in order of their batch index
+struct BatchAppendState {
+	//! Lock protecting the batches and the active batches
+	mutex lock;
+	//! Lock held by the thread that is merging batches into the table
+	mutex merge_lock;
+	//! The handed over rows that have not been merged yet, ordered by (batch index, sequence number)
+	std::map<pair<idx_t, idx_t>, unique_ptr<ChunkCollection>> batches;
+	//! The sequence number of the next handed over collection
+	idx_t batch_sequence = 0;
+	//! The batch index that every active thread is currently appending
+	unordered_map<idx_t, idx_t> active_batches;
+	//! The amount of threads that have started appending
+	idx_t thread_count = 0;
+	//! The rows of the merged batches that do not fill a row group yet (protected by the merge lock)
+	ChunkCollection pending;
+};
+
 } // namespace duckdb
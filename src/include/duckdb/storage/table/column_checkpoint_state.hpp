@@ -18,6 +18,7 @@ class ColumnData;
 class DatabaseInstance;
 class RowGroup;
 class TableDataWriter;
+class BufferHandle;
 
 struct ColumnCheckpointState {
 	ColumnCheckpointState(RowGroup &row_group, ColumnData &column_data, TableDataWriter &writer);
@@ -42,6 +43,9 @@ public:
 	virtual void FlushSegment();
 	virtual void AppendData(Vector &data, idx_t count);
 	virtual void FlushToDisk();
+
+	//! Write the block of a (compressed) segment to disk, and append a persistent segment pointing to it to the new tree
+	void WriteSegment(CompressionType compression, BufferHandle &handle, idx_t tuple_count, SegmentStatistics &stats);
 };
 
 } // namespace duckdb
@@ -19,6 +19,8 @@
 #include "duckdb/storage/table/column_checkpoint_state.hpp"
 #include "duckdb/common/mutex.hpp"
 
+#include <functional>
+
 namespace duckdb {
 class ColumnData;
 class DatabaseInstance;
@@ -124,6 +126,12 @@ protected:
 	template <bool SCAN_COMMITTED, bool ALLOW_UPDATES>
 	idx_t ScanVector(Transaction *transaction, idx_t vector_index, ColumnScanState &state, Vector &result);
 
+	//! Write a set of segments that are not persisted (or were changed) to disk, compressing them if possible
+	void CheckpointSegments(ColumnCheckpointState &checkpoint_state, vector<unique_ptr<SegmentBase>> &segments);
+	//! Scan the committed data of a set of segments that is written during a checkpoint
+	void ScanCheckpointSegments(ColumnCheckpointState &checkpoint_state, vector<unique_ptr<SegmentBase>> &segments,
+	                            const std::function<void(Vector &, idx_t)> &callback);
+
 protected:
 	//! The segments holding the data of this column segment
 	SegmentTree data;
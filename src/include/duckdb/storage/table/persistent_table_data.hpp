@@ -12,6 +12,7 @@
 #include "duckdb/common/vector.hpp"
 #include "duckdb/storage/table/segment_tree.hpp"
 #include "duckdb/storage/data_pointer.hpp"
+#include "duckdb/storage/block.hpp"
 
 namespace duckdb {
 class BaseStatistics;
@@ -23,6 +24,8 @@ public:
 
 	vector<RowGroupPointer> row_groups;
 	vector<unique_ptr<BaseStatistics>> column_stats;
+	//! The root pointers of the persisted UNIQUE and PRIMARY KEY indexes, in the order of the constraints
+	vector<BlockPointer> indexes;
 };
 
 } // namespace duckdb
@@ -98,6 +98,9 @@ public:
 
 	//! For a specific row, returns true if it should be used for the transaction and false otherwise.
 	bool Fetch(Transaction &transaction, idx_t row);
+	//! Returns whether or not any row of the row group was inserted by a committed transaction, row groups without any
+	//! are left behind by appends that were aborted (only valid while there are no active transactions)
+	bool HasCommittedInserts();
 	//! Fetch a specific row from the row_group and insert it into the result at the specified index
 	void FetchRow(Transaction &transaction, ColumnFetchState &state, const vector<column_t> &column_ids, row_t row_id,
 	              DataChunk &result, idx_t result_idx);
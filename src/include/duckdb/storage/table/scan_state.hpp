@@ -46,6 +46,8 @@ struct ColumnScanState {
 	bool initialized = false;
 	//! If this segment has already been checked for skipping puorposes
 	bool segment_checked = false;
+	//! Whether or not compressed segments can emit constant or dictionary vectors instead of flat vectors
+	bool scan_compressed = false;
 
 public:
 	//! Move the scan state forward by "count" rows (including all child states)
@@ -82,7 +84,7 @@ private:
 
 class RowGroupScanState {
 public:
-	RowGroupScanState(TableScanState &parent_p) : parent(parent_p), vector_index(0), max_row(0) {
+	RowGroupScanState(TableScanState &parent_p) : parent(parent_p), row_group(nullptr), vector_index(0), max_row(0) {
 	}
 
 	//! The parent scan state
@@ -41,6 +41,8 @@ public:
 	SegmentBase *GetSegment(idx_t row_number);
 	//! Append a column segment to the tree
 	void AppendSegment(unique_ptr<SegmentBase> segment);
+	//! Removes the segment with the given index from the tree (does not lock the segment tree!)
+	void EraseSegment(idx_t segment_index);
 
 	//! Replace this tree with another tree, taking over its nodes in-place
 	void Replace(SegmentTree &other);
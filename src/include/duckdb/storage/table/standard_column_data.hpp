@@ -58,6 +58,9 @@ public:
 private:
 	template <bool SCAN_COMMITTED, bool ALLOW_UPDATES>
 	void TemplatedScan(Transaction *transaction, ColumnScanState &state, Vector &result);
+	//! Merges the separately scanned validity of a constant or dictionary vector into the result, flattening the
+	//! result only if the validity contains NULL values
+	static void MergeValidity(Vector &validity_vector, Vector &result, idx_t count);
 };
 
 } // namespace duckdb
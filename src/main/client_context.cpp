@@ -229,7 +229,7 @@ unique_ptr<QueryResult> ClientContext::ExecutePreparedStatement(ClientContextLoc
 		progress_bar->Start();
 	}
 	// store the physical plan in the context for calls to Fetch()
-	executor.Initialize(statement.plan.get());
+	executor.Initialize(statement.plan.get(), !create_stream_result);
 
 	auto types = executor.GetTypes();
 
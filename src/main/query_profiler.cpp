@@ -234,7 +234,10 @@ void QueryProfiler::Flush(OperatorProfiler &profiler) {
 	lock_guard<mutex> guard(flush_lock);
 	for (auto &node : profiler.timings) {
 		auto entry = tree_map.find(node.first);
-		D_ASSERT(entry != tree_map.end());
+		if (entry == tree_map.end()) {
+			// operators that are added by the executor (e.g. the result collector) are not part of the profiled plan
+			continue;
+		}
 
 		entry->second->info.time += node.second.time;
 		entry->second->info.elements += node.second.elements;
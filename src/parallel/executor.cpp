@@ -1,6 +1,7 @@
 #include "duckdb/execution/executor.hpp"
 
 #include "duckdb/execution/operator/helper/physical_execute.hpp"
+#include "duckdb/execution/operator/helper/physical_result_collector.hpp"
 #include "duckdb/execution/operator/join/physical_delim_join.hpp"
 #include "duckdb/execution/operator/scan/physical_chunk_scan.hpp"
 #include "duckdb/execution/operator/set/physical_recursive_cte.hpp"
@@ -21,19 +22,32 @@ Executor::Executor(ClientContext &context) : context(context) {
 Executor::~Executor() {
 }
 
-void Executor::Initialize(PhysicalOperator *plan) {
+void Executor::Initialize(PhysicalOperator *plan, bool parallel_result) {
 	Reset();
 
 	auto &scheduler = TaskScheduler::GetScheduler(context);
 	{
 		lock_guard<mutex> elock(executor_lock);
 		physical_plan = plan;
-		physical_state = physical_plan->GetOperatorState();
 
 		context.profiler->Initialize(physical_plan);
 		this->producer = scheduler.CreateProducer();
 
-		BuildPipelines(physical_plan, nullptr);
+		if (parallel_result && !physical_plan->IsSink() &&
+		    PhysicalResultCollector::CanCollectInParallel(context, *physical_plan)) {
+			// collect the result of the final pipeline in parallel, the result is fetched from the collector
+			result_collector = make_unique<PhysicalResultCollector>(*physical_plan);
+			auto pipeline = make_shared<Pipeline>(*this, *producer);
+			pipeline->sink = result_collector.get();
+			pipeline->sink_state = result_collector->GetGlobalState(context);
+			pipeline->child = physical_plan;
+			BuildPipelines(physical_plan, pipeline.get());
+			pipelines.push_back(move(pipeline));
+			physical_state = result_collector->GetOperatorState();
+		} else {
+			physical_state = physical_plan->GetOperatorState();
+			BuildPipelines(physical_plan, nullptr);
+		}
 
 		this->total_pipelines = pipelines.size();
 
@@ -92,6 +106,7 @@ void Executor::Reset() {
 	recursive_cte = nullptr;
 	physical_plan = nullptr;
 	physical_state = nullptr;
+	result_collector = nullptr;
 	completed_pipelines = 0;
 	total_pipelines = 0;
 	exceptions.clear();
@@ -293,9 +308,10 @@ unique_ptr<DataChunk> Executor::FetchChunk() {
 
 	auto chunk = make_unique<DataChunk>();
 	// run the plan to get the next chunks
-	physical_plan->InitializeChunk(*chunk);
-	physical_plan->GetChunk(econtext, *chunk, physical_state.get());
-	physical_plan->FinalizeOperatorState(*physical_state, econtext);
+	auto root = result_collector ? result_collector.get() : physical_plan;
+	root->InitializeChunk(*chunk);
+	root->GetChunk(econtext, *chunk, physical_state.get());
+	root->FinalizeOperatorState(*physical_state, econtext);
 	context.profiler->Flush(thread.profiler);
 	return chunk;
 }
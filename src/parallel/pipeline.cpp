@@ -14,6 +14,8 @@
 #include "duckdb/execution/operator/order/physical_order.hpp"
 #include "duckdb/execution/operator/aggregate/physical_hash_aggregate.hpp"
 #include "duckdb/execution/operator/join/physical_hash_join.hpp"
+#include "duckdb/execution/operator/persistent/physical_insert.hpp"
+#include "duckdb/execution/operator/persistent/physical_copy_to_file.hpp"
 
 namespace duckdb {
 
@@ -33,8 +35,8 @@ public:
 };
 
 Pipeline::Pipeline(Executor &executor_p, ProducerToken &token_p)
-    : executor(executor_p), token(token_p), finished_tasks(0), total_tasks(0), finished_dependencies(0),
-      finished(false), recursive_cte(nullptr) {
+    : executor(executor_p), token(token_p), finished_tasks(0), total_tasks(0), source(nullptr),
+      finished_dependencies(0), finished(false), recursive_cte(nullptr) {
 }
 
 bool Pipeline::GetProgress(ClientContext &context, PhysicalOperator *op, int &current_percentage) {
@@ -91,11 +93,33 @@ void Pipeline::Execute(TaskContext &task) {
 	try {
 		auto state = child->GetOperatorState();
 		auto lstate = sink->GetLocalSinkState(context);
+		sink->InitializeLocalSinkState(context, *sink_state, *lstate);
+		// the states of the streaming operators, the input of every streaming operator is stored in its child chunk
+		vector<PhysicalOperatorState *> states;
+		auto source_state = state.get();
+		for (idx_t i = 0; i < operators.size(); i++) {
+			states.push_back(source_state);
+			source_state = source_state->child_state.get();
+		}
 		// incrementally process the pipeline
 		DataChunk intermediate;
 		child->InitializeChunk(intermediate);
 		while (true) {
-			child->GetChunk(context, intermediate, state.get());
+			if (operators.empty()) {
+				child->GetChunk(context, intermediate, state.get());
+			} else {
+				// pull a chunk from the source and push it through the streaming operators
+				auto &source_chunk = states.back()->child_chunk;
+				source->GetChunk(context, source_chunk, source_state);
+				if (source_chunk.size() == 0) {
+					intermediate.Reset();
+				} else if (!ExecuteOperators(context, states, intermediate)) {
+					continue;
+				}
+			}
+			if (sink->RequiresBatchIndex() && source->type == PhysicalOperatorType::TABLE_SCAN) {
+				lstate->batch_index = ((PhysicalTableScan &)*source).GetBatchIndex(context, source_state);
+			}
 			thread.profiler.StartOperator(sink);
 			if (intermediate.size() == 0) {
 				sink->Combine(context, *sink_state, *lstate);
@@ -113,6 +137,29 @@ void Pipeline::Execute(TaskContext &task) {
 	executor.Flush(thread);
 }
 
+bool Pipeline::ExecuteOperators(ExecutionContext &context, vector<PhysicalOperatorState *> &states,
+                                DataChunk &result) {
+	for (idx_t i = operators.size(); i > 0; i--) {
+		auto op_idx = i - 1;
+		auto &input = states[op_idx]->child_chunk;
+		auto &output = op_idx == 0 ? result : states[op_idx - 1]->child_chunk;
+		operators[op_idx]->Execute(context, input, output, states[op_idx]);
+		if (output.size() == 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void Pipeline::InitializeOperators() {
+	operators.clear();
+	source = child;
+	while (source->IsStreaming()) {
+		operators.push_back(source);
+		source = source->children[0].get();
+	}
+}
+
 void Pipeline::FinishTask() {
 	D_ASSERT(finished_tasks < total_tasks);
 	idx_t current_tasks = total_tasks;
@@ -180,6 +227,10 @@ bool Pipeline::ScheduleOperator(PhysicalOperator *op) {
 		if (IsRightOuterJoin(join.join_type)) {
 			return false;
 		}
+		// the probe of an external hash join loads the partitions of the hash table one at a time
+		if (join.IsExternal()) {
+			return false;
+		}
 		return ScheduleOperator(op->children[0].get());
 	}
 	case PhysicalOperatorType::TABLE_SCAN: {
@@ -240,6 +291,7 @@ void Pipeline::Schedule() {
 	D_ASSERT(finished_tasks == 0);
 	D_ASSERT(total_tasks == 0);
 	D_ASSERT(finished_dependencies == dependencies.size());
+	InitializeOperators();
 	// check if we can parallelize this task based on the sink
 	switch (sink->type) {
 	case PhysicalOperatorType::SIMPLE_AGGREGATE: {
@@ -255,6 +307,18 @@ void Pipeline::Schedule() {
 		}
 		break;
 	}
+	case PhysicalOperatorType::INSERT: {
+		auto &insert = (PhysicalInsert &)*sink;
+		if (!insert.parallel) {
+			// the insert has to go through the transaction-local storage: switch to sequential mode
+			break;
+		}
+		if (ScheduleOperator(sink->children[0].get())) {
+			// all parallel tasks have been scheduled: return
+			return;
+		}
+		break;
+	}
 	case PhysicalOperatorType::CREATE_TABLE_AS:
 	case PhysicalOperatorType::ORDER_BY:
 	case PhysicalOperatorType::RESERVOIR_SAMPLE:
@@ -287,6 +351,35 @@ void Pipeline::Schedule() {
 		}
 		break;
 	}
+	case PhysicalOperatorType::COPY_TO_FILE: {
+		auto &copy = (PhysicalCopyToFile &)*sink;
+		if (!copy.SupportsParallelWrite()) {
+			// the copy function writes the rows as they come in: switch to sequential mode
+			break;
+		}
+		bool batch_source = source->type == PhysicalOperatorType::TABLE_SCAN &&
+		                    ((PhysicalTableScan &)*source).SupportsBatchIndex();
+		if (copy.preserve_order && !batch_source) {
+			// the order of the rows can only be restored for batches of a parallel table scan
+			break;
+		}
+		if (ScheduleOperator(sink->children[0].get())) {
+			// all parallel tasks have been scheduled: return
+			return;
+		}
+		break;
+	}
+	case PhysicalOperatorType::RESULT_COLLECTOR: {
+		// the result collector restores the order of the batches of a parallel table scan
+		if (source->type != PhysicalOperatorType::TABLE_SCAN || !((PhysicalTableScan &)*source).SupportsBatchIndex()) {
+			break;
+		}
+		if (ScheduleOperator(child)) {
+			// all parallel tasks have been scheduled: return
+			return;
+		}
+		break;
+	}
 	case PhysicalOperatorType::WINDOW: {
 		// schedule child op
 		if (ScheduleOperator(sink->children[0].get())) {
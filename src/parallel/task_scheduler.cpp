@@ -8,6 +8,10 @@
 #include "concurrentqueue.h"
 #include "lightweightsemaphore.h"
 #include "duckdb/common/thread.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <iterator>
 #else
 #include <queue>
 #endif
@@ -27,33 +31,215 @@ struct SchedulerThread {
 typedef duckdb_moodycamel::ConcurrentQueue<unique_ptr<Task>> concurrent_queue_t;
 typedef duckdb_moodycamel::LightweightSemaphore lightweight_semaphore_t;
 
+//! A task in the queue of a background thread, together with the id of the producer it was scheduled for
+struct WorkerTask {
+	WorkerTask(idx_t producer_id, unique_ptr<Task> task) : producer_id(producer_id), task(move(task)) {
+	}
+
+	idx_t producer_id;
+	unique_ptr<Task> task;
+};
+
+//! The task queue of a single background thread
+struct WorkerQueue {
+	WorkerQueue(ConcurrentQueue &owner, atomic<bool> *marker) : owner(owner), marker(marker), sleeping(false) {
+	}
+
+	//! The queue of the scheduler that the thread belongs to
+	ConcurrentQueue &owner;
+	//! The marker of the thread owning the queue
+	atomic<bool> *marker;
+	//! The tasks scheduled by the thread; the owner takes tasks from the front, other threads steal from the back
+	std::deque<WorkerTask> tasks;
+	//! Lock protecting the tasks of this queue only
+	mutex lock;
+	//! Whether or not the thread is registered as sleeping, cleared by the thread that wakes it up
+	atomic<bool> sleeping;
+	//! The semaphore the thread sleeps on while it is idle
+	lightweight_semaphore_t semaphore;
+};
+
+typedef vector<shared_ptr<WorkerQueue>> worker_list_t;
+
+//! The queue of the background thread that is currently running (if any). A thread only ever runs tasks of the
+//! scheduler that launched it, but it can schedule tasks on other schedulers: check the owner before using it.
+static thread_local WorkerQueue *current_worker = nullptr;
+
 struct ConcurrentQueue {
+	ConcurrentQueue() : next_producer_id(0), idle_count(0), workers(make_shared<worker_list_t>()) {
+	}
+
+	//! The shared queue, which holds the tasks scheduled from outside of the background threads
 	concurrent_queue_t q;
-	lightweight_semaphore_t semaphore;
+	//! The id that is given to the next producer token
+	atomic<idx_t> next_producer_id;
+	//! The amount of background threads that are registered as sleeping
+	atomic<idx_t> idle_count;
 
 	void Enqueue(ProducerToken &token, unique_ptr<Task> task);
+	//! Take a task of the producer from the shared queue, or from the queue of a background thread
 	bool DequeueFromProducer(ProducerToken &token, unique_ptr<Task> &task);
+	//! Take a task from the queue of the worker or from the shared queue, or steal one from another background thread
+	bool DequeueFromWorker(WorkerQueue &worker, unique_ptr<Task> &task, bool &stolen);
+
+	//! Returns the queue of the current thread if it is a background thread of this scheduler
+	WorkerQueue *GetCurrentWorker() {
+		return current_worker && &current_worker->owner == this ? current_worker : nullptr;
+	}
+	//! Returns the task queues of the background threads. A published list is never modified, so it can be read
+	//! without holding a lock; the queues are kept alive by the list.
+	shared_ptr<const worker_list_t> GetWorkers() {
+		return std::atomic_load(&workers);
+	}
+	void AddWorker(shared_ptr<WorkerQueue> worker);
+	void RemoveWorker(WorkerQueue &worker);
+
+	//! Wake up a single sleeping background thread (if any)
+	void WakeUpWorker();
+	//! Wake up the given background thread if it is registered as sleeping, returns true if it was
+	bool WakeUpWorker(WorkerQueue &worker);
+	//! Unregister the given background thread as sleeping, returns true if it was registered
+	bool ClearSleeping(WorkerQueue &worker);
+
+private:
+	//! Steal a task from the queue of another background thread
+	bool Steal(WorkerQueue &thief, unique_ptr<Task> &task);
+
+	//! Lock serializing the registration of background threads; the list itself is replaced, not modified
+	mutex workers_lock;
+	shared_ptr<const worker_list_t> workers;
 };
 
 struct QueueProducerToken {
-	explicit QueueProducerToken(ConcurrentQueue &queue) : queue_token(queue.q) {
+	explicit QueueProducerToken(ConcurrentQueue &queue) : queue_token(queue.q), producer_id(queue.next_producer_id++) {
 	}
 
 	duckdb_moodycamel::ProducerToken queue_token;
+	//! The id of the producer, which identifies its tasks in the queues of the background threads. Ids are never
+	//! reused, unlike the address of a token.
+	idx_t producer_id;
 };
 
 void ConcurrentQueue::Enqueue(ProducerToken &token, unique_ptr<Task> task) {
-	lock_guard<mutex> producer_lock(token.producer_lock);
-	if (q.enqueue(token.token->queue_token, move(task))) {
-		semaphore.signal();
+	auto worker = GetCurrentWorker();
+	if (worker) {
+		// scheduled from a background thread: keep the task local to this thread
+		lock_guard<mutex> local_lock(worker->lock);
+		worker->tasks.emplace_back(token.token->producer_id, move(task));
 	} else {
-		throw InternalException("Could not schedule task!");
+		lock_guard<mutex> producer_lock(token.producer_lock);
+		if (!q.enqueue(token.token->queue_token, move(task))) {
+			throw InternalException("Could not schedule task!");
+		}
 	}
+	WakeUpWorker();
 }
 
 bool ConcurrentQueue::DequeueFromProducer(ProducerToken &token, unique_ptr<Task> &task) {
-	lock_guard<mutex> producer_lock(token.producer_lock);
-	return q.try_dequeue_from_producer(token.token->queue_token, task);
+	{
+		lock_guard<mutex> producer_lock(token.producer_lock);
+		if (q.try_dequeue_from_producer(token.token->queue_token, task)) {
+			return true;
+		}
+	}
+	// tasks scheduled from within a background thread are in the queue of that thread: take them from the back, as
+	// the other threads do when they steal
+	auto producer_id = token.token->producer_id;
+	auto worker_list = GetWorkers();
+	for (auto &worker : *worker_list) {
+		lock_guard<mutex> victim_lock(worker->lock);
+		for (auto entry = worker->tasks.rbegin(); entry != worker->tasks.rend(); entry++) {
+			if (entry->producer_id == producer_id) {
+				task = move(entry->task);
+				worker->tasks.erase(std::next(entry).base());
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+bool ConcurrentQueue::DequeueFromWorker(WorkerQueue &worker, unique_ptr<Task> &task, bool &stolen) {
+	stolen = false;
+	{
+		lock_guard<mutex> local_lock(worker.lock);
+		if (!worker.tasks.empty()) {
+			task = move(worker.tasks.front().task);
+			worker.tasks.pop_front();
+			return true;
+		}
+	}
+	if (q.try_dequeue(task)) {
+		return true;
+	}
+	stolen = Steal(worker, task);
+	return stolen;
+}
+
+void ConcurrentQueue::AddWorker(shared_ptr<WorkerQueue> worker) {
+	lock_guard<mutex> guard(workers_lock);
+	auto new_workers = make_shared<worker_list_t>(*workers);
+	new_workers->push_back(move(worker));
+	std::atomic_store(&workers, shared_ptr<const worker_list_t>(move(new_workers)));
+}
+
+void ConcurrentQueue::RemoveWorker(WorkerQueue &worker) {
+	lock_guard<mutex> guard(workers_lock);
+	auto new_workers = make_shared<worker_list_t>();
+	for (auto &entry : *workers) {
+		if (entry.get() != &worker) {
+			new_workers->push_back(entry);
+		}
+	}
+	std::atomic_store(&workers, shared_ptr<const worker_list_t>(move(new_workers)));
+}
+
+void ConcurrentQueue::WakeUpWorker() {
+	// a thread registers as sleeping before it looks for tasks one final time: either it finds the task that was just
+	// scheduled, or we see that it is sleeping
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (idle_count == 0) {
+		return;
+	}
+	auto worker_list = GetWorkers();
+	for (auto &worker : *worker_list) {
+		if (WakeUpWorker(*worker)) {
+			return;
+		}
+	}
+}
+
+bool ConcurrentQueue::WakeUpWorker(WorkerQueue &worker) {
+	if (!ClearSleeping(worker)) {
+		return false;
+	}
+	worker.semaphore.signal();
+	return true;
+}
+
+bool ConcurrentQueue::ClearSleeping(WorkerQueue &worker) {
+	bool expected = true;
+	if (!worker.sleeping.compare_exchange_strong(expected, false)) {
+		return false;
+	}
+	idle_count--;
+	return true;
+}
+
+bool ConcurrentQueue::Steal(WorkerQueue &thief, unique_ptr<Task> &task) {
+	auto worker_list = GetWorkers();
+	for (auto &worker : *worker_list) {
+		if (worker.get() == &thief) {
+			continue;
+		}
+		lock_guard<mutex> victim_lock(worker->lock);
+		if (!worker->tasks.empty()) {
+			task = move(worker->tasks.back().task);
+			worker->tasks.pop_back();
+			return true;
+		}
+	}
+	return false;
 }
 
 #else
@@ -93,7 +279,9 @@ ProducerToken::ProducerToken(TaskScheduler &scheduler, unique_ptr<QueueProducerT
 ProducerToken::~ProducerToken() {
 }
 
-TaskScheduler::TaskScheduler() : queue(make_unique<ConcurrentQueue>()) {
+TaskScheduler::TaskScheduler()
+    : queue(make_unique<ConcurrentQueue>()), scheduled_tasks(0), executed_tasks(0), stolen_tasks(0),
+      total_queue_wait_us(0), max_queue_wait_us(0) {
 }
 
 TaskScheduler::~TaskScheduler() {
@@ -113,30 +301,103 @@ unique_ptr<ProducerToken> TaskScheduler::CreateProducer() {
 
 void TaskScheduler::ScheduleTask(ProducerToken &token, unique_ptr<Task> task) {
 	// Enqueue a task for the given producer token and signal any sleeping threads
+	task->schedule_time = std::chrono::steady_clock::now();
+	scheduled_tasks++;
 	queue->Enqueue(token, move(task));
 }
 
 bool TaskScheduler::GetTaskFromProducer(ProducerToken &token, unique_ptr<Task> &task) {
-	return queue->DequeueFromProducer(token, task);
+	if (!queue->DequeueFromProducer(token, task)) {
+		return false;
+	}
+	RecordQueueWait(*task);
+	return true;
+}
+
+void TaskScheduler::RecordQueueWait(Task &task) {
+	auto wait_time =
+	    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - task.schedule_time)
+	        .count();
+	idx_t wait_us = wait_time > 0 ? idx_t(wait_time) : 0;
+	total_queue_wait_us += wait_us;
+	idx_t current_max = max_queue_wait_us;
+	while (wait_us > current_max && !max_queue_wait_us.compare_exchange_weak(current_max, wait_us)) {
+	}
+	executed_tasks++;
+}
+
+void TaskScheduler::ExecuteTask(unique_ptr<Task> task) {
+	RecordQueueWait(*task);
+	task->Execute();
 }
 
 void TaskScheduler::ExecuteForever(atomic<bool> *marker) {
 #ifndef DUCKDB_NO_THREADS
+	// the thread keeps its own reference: the queue outlives its removal from the list of workers
+	auto worker_ptr = make_shared<WorkerQueue>(*queue, marker);
+	auto &worker = *worker_ptr;
+	current_worker = &worker;
+	queue->AddWorker(worker_ptr);
 	unique_ptr<Task> task;
+	bool stolen;
 	// loop until the marker is set to false
 	while (*marker) {
-		// wait for a signal with a timeout; the timeout allows us to periodically check
-		queue->semaphore.wait(TASK_TIMEOUT_USECS);
-		if (queue->q.try_dequeue(task)) {
-			task->Execute();
-			task.reset();
+		// first look for tasks in the local queue, then in the shared queue, and finally steal from other threads
+		if (queue->DequeueFromWorker(worker, task, stolen)) {
+			if (stolen) {
+				stolen_tasks++;
+			}
+			ExecuteTask(move(task));
+			continue;
+		}
+		// no tasks available: go to sleep until a task is scheduled
+		// tasks might have been scheduled right before we registered as sleeping, without waking us up: look for them
+		// once more before going to sleep
+		worker.sleeping = true;
+		queue->idle_count++;
+		if (queue->DequeueFromWorker(worker, task, stolen)) {
+			// if another thread woke us up in the meantime, its signal only causes a spurious wake-up later on
+			queue->ClearSleeping(worker);
+			if (stolen) {
+				stolen_tasks++;
+			}
+			ExecuteTask(move(task));
+		} else {
+			worker.semaphore.wait();
+			// a spurious wake-up or the signal of a stopped thread leaves the thread registered as sleeping
+			queue->ClearSleeping(worker);
+		}
+	}
+	// the thread is stopped: unregister the queue and run any tasks that are left in it
+	queue->RemoveWorker(worker);
+	current_worker = nullptr;
+	while (true) {
+		{
+			// threads that obtained the list of queues before we unregistered can still steal from our queue
+			lock_guard<mutex> local_lock(worker.lock);
+			if (worker.tasks.empty()) {
+				break;
+			}
+			task = move(worker.tasks.front().task);
+			worker.tasks.pop_front();
 		}
+		ExecuteTask(move(task));
 	}
 #else
 	throw NotImplementedException("DuckDB was compiled without threads! Background thread loop is not allowed.");
 #endif
 }
 
+TaskSchedulerStatistics TaskScheduler::GetStatistics() {
+	TaskSchedulerStatistics result;
+	result.scheduled_tasks = scheduled_tasks;
+	result.executed_tasks = executed_tasks;
+	result.stolen_tasks = stolen_tasks;
+	result.total_queue_wait_us = total_queue_wait_us;
+	result.max_queue_wait_us = max_queue_wait_us;
+	return result;
+}
+
 #ifndef DUCKDB_NO_THREADS
 static void ThreadExecuteTasks(TaskScheduler *scheduler, atomic<bool> *marker) {
 	scheduler->ExecuteForever(marker);
@@ -183,6 +444,14 @@ void TaskScheduler::SetThreadsInternal(int32_t n) {
 		for (idx_t i = new_thread_count; i < threads.size(); i++) {
 			*markers[i] = false;
 		}
+		// wake up the stopped threads, in case they are sleeping; a thread that is about to go to sleep consumes the
+		// signal once it does
+		auto worker_list = queue->GetWorkers();
+		for (auto &worker : *worker_list) {
+			if (!*worker->marker && !queue->WakeUpWorker(*worker)) {
+				worker->semaphore.signal();
+			}
+		}
 		// now join the threads to ensure they are fully stopped before erasing them
 		for (idx_t i = new_thread_count; i < threads.size(); i++) {
 			threads[i]->internal_thread->join();
@@ -8,6 +8,7 @@
 #include "duckdb/catalog/catalog_entry/copy_function_catalog_entry.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/main/database.hpp"
+#include "duckdb/common/string_util.hpp"
 
 #include "duckdb/parser/expression/columnref_expression.hpp"
 #include "duckdb/parser/expression/star_expression.hpp"
@@ -38,10 +39,25 @@ BoundStatement Binder::BindCopyTo(CopyStatement &stmt) {
 		throw NotImplementedException("COPY TO is not supported for FORMAT \"%s\"", stmt.info->format);
 	}
 
+	// the PRESERVE_ORDER option is handled by the copy operator itself
+	bool preserve_order = true;
+	for (auto entry = stmt.info->options.begin(); entry != stmt.info->options.end(); entry++) {
+		if (StringUtil::Lower(entry->first) != "preserve_order") {
+			continue;
+		}
+		if (entry->second.size() > 1) {
+			throw BinderException("Expected a single argument as a boolean value (e.g. TRUE or 1)");
+		}
+		preserve_order = entry->second.empty() || entry->second[0].CastAs(LogicalType::BOOLEAN).value_.boolean;
+		stmt.info->options.erase(entry);
+		break;
+	}
+
 	auto function_data =
 	    copy_function->function.copy_to_bind(context, *stmt.info, select_node.names, select_node.types);
 	// now create the copy information
 	auto copy = make_unique<LogicalCopyToFile>(copy_function->function, move(function_data));
+	copy->preserve_order = preserve_order;
 	copy->AddChild(move(select_node.plan));
 
 	result.plan = move(copy);
@@ -0,0 +1,218 @@
+#include "duckdb/planner/filter/join_key_filter.hpp"
+
+#include "duckdb/common/types/hash.hpp"
+#include "duckdb/common/types/vector.hpp"
+
+namespace duckdb {
+
+//! The amount of bits in the bloom filter per expected build key
+static constexpr const idx_t JOIN_KEY_BLOOM_BITS_PER_KEY = 16;
+//! The minimum amount of bits per (actual) build key for the bloom filter to be used, below this the bloom filter
+//! lets through too many false positives to be worth probing
+static constexpr const idx_t JOIN_KEY_BLOOM_MIN_BITS_PER_KEY = 8;
+//! The size of the bloom filter in bits is between 2^13 (1KB) and 2^26 (8MB)
+static constexpr const idx_t JOIN_KEY_BLOOM_MIN_SHIFT = 13;
+static constexpr const idx_t JOIN_KEY_BLOOM_MAX_SHIFT = 26;
+
+JoinKeyFilter::JoinKeyFilter(LogicalType key_type_p)
+    : TableFilter(TableFilterType::JOIN_KEY), key_type(move(key_type_p)), published(false), has_keys(false), min(0),
+      max(0), key_count(0), bloom_shift(0), use_bloom(false) {
+}
+
+bool JoinKeyFilter::SupportsType(const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::TINYINT:
+	case LogicalTypeId::SMALLINT:
+	case LogicalTypeId::INTEGER:
+	case LogicalTypeId::BIGINT:
+		return true;
+	default:
+		return false;
+	}
+}
+
+void JoinKeyFilter::Initialize(idx_t estimated_key_count) {
+	lock_guard<mutex> guard(lock);
+	published = false;
+	has_keys = false;
+	min = 0;
+	max = 0;
+	key_count = 0;
+	use_bloom = false;
+	lower_bound.reset();
+	upper_bound.reset();
+
+	bloom_shift = JOIN_KEY_BLOOM_MIN_SHIFT;
+	while (bloom_shift < JOIN_KEY_BLOOM_MAX_SHIFT &&
+	       (idx_t(1) << bloom_shift) < estimated_key_count * JOIN_KEY_BLOOM_BITS_PER_KEY) {
+		bloom_shift++;
+	}
+	idx_t word_count = (idx_t(1) << bloom_shift) / 64;
+	bloom = unique_ptr<atomic<uint64_t>[]>(new atomic<uint64_t>[word_count]);
+	for (idx_t i = 0; i < word_count; i++) {
+		bloom[i] = 0;
+	}
+}
+
+template <class T>
+static idx_t TemplatedAddKeys(VectorData &vdata, idx_t count, atomic<uint64_t> bloom[], idx_t bloom_shift,
+                              int64_t &min, int64_t &max) {
+	auto data = (T *)vdata.data;
+	idx_t valid_count = 0;
+	for (idx_t i = 0; i < count; i++) {
+		auto idx = vdata.sel->get_index(i);
+		if (!vdata.validity.RowIsValid(idx)) {
+			continue;
+		}
+		int64_t key = data[idx];
+		if (valid_count == 0) {
+			min = key;
+			max = key;
+		} else {
+			min = MinValue<int64_t>(min, key);
+			max = MaxValue<int64_t>(max, key);
+		}
+		valid_count++;
+		// the bit positions are taken from the upper bits of the (multiplicative) hash
+		auto hash = Hash<T>(data[idx]);
+		auto first_bit = hash >> (64 - bloom_shift);
+		auto second_bit = (hash >> (64 - 2 * bloom_shift)) & ((idx_t(1) << bloom_shift) - 1);
+		bloom[first_bit / 64].fetch_or(uint64_t(1) << (first_bit % 64), std::memory_order_relaxed);
+		bloom[second_bit / 64].fetch_or(uint64_t(1) << (second_bit % 64), std::memory_order_relaxed);
+	}
+	return valid_count;
+}
+
+void JoinKeyFilter::AddKeys(Vector &keys, idx_t count) {
+	D_ASSERT(keys.GetType() == key_type);
+	D_ASSERT(!published);
+	VectorData vdata;
+	keys.Orrify(count, vdata);
+
+	int64_t chunk_min, chunk_max;
+	idx_t valid_count;
+	switch (key_type.InternalType()) {
+	case PhysicalType::INT8:
+		valid_count = TemplatedAddKeys<int8_t>(vdata, count, bloom.get(), bloom_shift, chunk_min, chunk_max);
+		break;
+	case PhysicalType::INT16:
+		valid_count = TemplatedAddKeys<int16_t>(vdata, count, bloom.get(), bloom_shift, chunk_min, chunk_max);
+		break;
+	case PhysicalType::INT32:
+		valid_count = TemplatedAddKeys<int32_t>(vdata, count, bloom.get(), bloom_shift, chunk_min, chunk_max);
+		break;
+	case PhysicalType::INT64:
+		valid_count = TemplatedAddKeys<int64_t>(vdata, count, bloom.get(), bloom_shift, chunk_min, chunk_max);
+		break;
+	default:
+		throw InternalException("Unsupported type for JoinKeyFilter");
+	}
+	if (valid_count == 0) {
+		return;
+	}
+	key_count += valid_count;
+
+	lock_guard<mutex> guard(lock);
+	if (!has_keys) {
+		min = chunk_min;
+		max = chunk_max;
+		has_keys = true;
+	} else {
+		min = MinValue<int64_t>(min, chunk_min);
+		max = MaxValue<int64_t>(max, chunk_max);
+	}
+}
+
+void JoinKeyFilter::Publish() {
+	lock_guard<mutex> guard(lock);
+	if (has_keys) {
+		lower_bound =
+		    make_unique<ConstantFilter>(ExpressionType::COMPARE_GREATERTHANOREQUALTO, Value::Numeric(key_type, min));
+		upper_bound =
+		    make_unique<ConstantFilter>(ExpressionType::COMPARE_LESSTHANOREQUALTO, Value::Numeric(key_type, max));
+		// a saturated bloom filter costs more to probe than it filters out
+		use_bloom = key_count * JOIN_KEY_BLOOM_MIN_BITS_PER_KEY <= (idx_t(1) << bloom_shift);
+	}
+	published = true;
+}
+
+bool JoinKeyFilter::BloomContains(hash_t hash) const {
+	auto first_bit = hash >> (64 - bloom_shift);
+	auto second_bit = (hash >> (64 - 2 * bloom_shift)) & ((idx_t(1) << bloom_shift) - 1);
+	return (bloom[first_bit / 64].load(std::memory_order_relaxed) & (uint64_t(1) << (first_bit % 64))) &&
+	       (bloom[second_bit / 64].load(std::memory_order_relaxed) & (uint64_t(1) << (second_bit % 64)));
+}
+
+template <class T>
+static idx_t TemplatedSelect(const JoinKeyFilter &filter, T *data, SelectionVector &sel, idx_t approved_tuple_count,
+                             ValidityMask &mask, T min, T max, bool use_bloom, SelectionVector &result_sel) {
+	idx_t result_count = 0;
+	for (idx_t i = 0; i < approved_tuple_count; i++) {
+		auto idx = sel.get_index(i);
+		if (!mask.RowIsValid(idx) || data[idx] < min || data[idx] > max) {
+			continue;
+		}
+		if (use_bloom && !filter.BloomContains(Hash<T>(data[idx]))) {
+			continue;
+		}
+		result_sel.set_index(result_count++, idx);
+	}
+	return result_count;
+}
+
+void JoinKeyFilter::Select(Vector &vector, SelectionVector &sel, idx_t &approved_tuple_count,
+                           ValidityMask &mask) const {
+	if (!published) {
+		return;
+	}
+	if (!has_keys) {
+		// the build side is empty (or only has NULL keys): no row can find a join partner
+		approved_tuple_count = 0;
+		return;
+	}
+	D_ASSERT(vector.GetVectorType() == VectorType::FLAT_VECTOR);
+	SelectionVector result_sel(approved_tuple_count);
+	switch (key_type.InternalType()) {
+	case PhysicalType::INT8:
+		approved_tuple_count = TemplatedSelect<int8_t>(*this, FlatVector::GetData<int8_t>(vector), sel,
+		                                               approved_tuple_count, mask, min, max, use_bloom, result_sel);
+		break;
+	case PhysicalType::INT16:
+		approved_tuple_count = TemplatedSelect<int16_t>(*this, FlatVector::GetData<int16_t>(vector), sel,
+		                                                approved_tuple_count, mask, min, max, use_bloom, result_sel);
+		break;
+	case PhysicalType::INT32:
+		approved_tuple_count = TemplatedSelect<int32_t>(*this, FlatVector::GetData<int32_t>(vector), sel,
+		                                                approved_tuple_count, mask, min, max, use_bloom, result_sel);
+		break;
+	case PhysicalType::INT64:
+		approved_tuple_count = TemplatedSelect<int64_t>(*this, FlatVector::GetData<int64_t>(vector), sel,
+		                                                approved_tuple_count, mask, min, max, use_bloom, result_sel);
+		break;
+	default:
+		throw InternalException("Unsupported type for JoinKeyFilter");
+	}
+	sel.Initialize(result_sel);
+}
+
+FilterPropagateResult JoinKeyFilter::CheckStatistics(BaseStatistics &stats) {
+	if (!published) {
+		return FilterPropagateResult::NO_PRUNING_POSSIBLE;
+	}
+	if (!has_keys) {
+		return FilterPropagateResult::FILTER_ALWAYS_FALSE;
+	}
+	auto lower_result = lower_bound->CheckStatistics(stats);
+	auto upper_result = upper_bound->CheckStatistics(stats);
+	if (lower_result == FilterPropagateResult::FILTER_ALWAYS_FALSE ||
+	    upper_result == FilterPropagateResult::FILTER_ALWAYS_FALSE) {
+		return FilterPropagateResult::FILTER_ALWAYS_FALSE;
+	}
+	return FilterPropagateResult::NO_PRUNING_POSSIBLE;
+}
+
+string JoinKeyFilter::ToString(const string &column_name) {
+	return column_name + " IN JOIN KEYS";
+}
+
+} // namespace duckdb
@@ -5,10 +5,18 @@
 #include "duckdb/parallel/concurrentqueue.hpp"
 #include "duckdb/storage/storage_manager.hpp"
 
+#ifndef DUCKDB_NO_THREADS
+#include "duckdb/common/thread.hpp"
+
+#include <condition_variable>
+#endif
+#include <deque>
+
 namespace duckdb {
 
 BlockHandle::BlockHandle(DatabaseInstance &db, block_id_t block_id_p)
-    : db(db), readers(0), block_id(block_id_p), buffer(nullptr), eviction_timestamp(0), can_destroy(false) {
+    : db(db), readers(0), block_id(block_id_p), buffer(nullptr), eviction_timestamp(0), can_destroy(false),
+      access_count(0) {
 	eviction_timestamp = 0;
 	state = BlockState::BLOCK_UNLOADED;
 	memory_usage = Storage::BLOCK_ALLOC_SIZE;
@@ -16,7 +24,7 @@ BlockHandle::BlockHandle(DatabaseInstance &db, block_id_t block_id_p)
 
 BlockHandle::BlockHandle(DatabaseInstance &db, block_id_t block_id_p, unique_ptr<FileBuffer> buffer_p,
                          bool can_destroy_p, idx_t alloc_size)
-    : db(db), readers(0), block_id(block_id_p), eviction_timestamp(0), can_destroy(can_destroy_p) {
+    : db(db), readers(0), block_id(block_id_p), eviction_timestamp(0), can_destroy(can_destroy_p), access_count(0) {
 	D_ASSERT(alloc_size >= Storage::BLOCK_SIZE);
 	buffer = move(buffer_p);
 	state = BlockState::BLOCK_LOADED;
@@ -74,6 +82,7 @@ void BlockHandle::Unload() {
 	}
 	buffer.reset();
 	buffer_manager.current_memory -= memory_usage;
+	access_count = 0;
 }
 
 bool BlockHandle::CanUnload() {
@@ -115,8 +124,33 @@ struct BufferEvictionNode {
 
 typedef duckdb_moodycamel::ConcurrentQueue<unique_ptr<BufferEvictionNode>> eviction_queue_t;
 
+//! Unpinned blocks are placed in one of several queues, blocks are evicted from the first queue that has any
+//! (1) COLD: blocks that were referenced only once since they were loaded, e.g. the blocks read by a large scan
+//! (2) HOT: blocks that were referenced multiple times since they were loaded
+//! (3) TEMPORARY: temporary blocks, that have to be written to the temporary directory when they are evicted
+//! This prevents a single scan over a large table from pushing the frequently used blocks out of memory
+enum class EvictionQueueType : uint8_t { COLD = 0, HOT = 1, TEMPORARY = 2 };
+static constexpr idx_t EVICTION_QUEUE_COUNT = 3;
+
 struct EvictionQueue {
-	eviction_queue_t q;
+	eviction_queue_t q[EVICTION_QUEUE_COUNT];
+};
+
+//! The maximum amount of outstanding read-ahead requests; further requests are dropped
+static constexpr idx_t READ_AHEAD_QUEUE_SIZE = 256;
+//! The amount of threads issuing read-ahead requests
+static constexpr idx_t READ_AHEAD_THREADS = 4;
+
+struct ReadAheadQueue {
+	mutex lock;
+	//! The blocks that should be loaded; these are not kept alive by the queue
+	std::deque<weak_ptr<BlockHandle>> requests;
+	//! Set when the buffer manager is destroyed
+	bool shutdown = false;
+#ifndef DUCKDB_NO_THREADS
+	std::condition_variable cv;
+	vector<unique_ptr<thread>> threads;
+#endif
 };
 
 class TemporaryDirectoryHandle {
@@ -148,10 +182,22 @@ void BufferManager::SetTemporaryDirectory(string new_dir) {
 
 BufferManager::BufferManager(DatabaseInstance &db, string tmp, idx_t maximum_memory)
     : db(db), current_memory(0), maximum_memory(maximum_memory), temp_directory(move(tmp)),
-      queue(make_unique<EvictionQueue>()), temporary_id(MAXIMUM_BLOCK) {
+      queue(make_unique<EvictionQueue>()), read_ahead(make_unique<ReadAheadQueue>()), temporary_id(MAXIMUM_BLOCK),
+      cache_hits(0), cache_misses(0), evicted_blocks(0), temporary_writes(0), temporary_reads(0) {
 }
 
 BufferManager::~BufferManager() {
+#ifndef DUCKDB_NO_THREADS
+	// stop the read-ahead threads
+	{
+		lock_guard<mutex> guard(read_ahead->lock);
+		read_ahead->shutdown = true;
+	}
+	read_ahead->cv.notify_all();
+	for (auto &read_ahead_thread : read_ahead->threads) {
+		read_ahead_thread->join();
+	}
+#endif
 }
 
 shared_ptr<BlockHandle> BufferManager::RegisterBlock(block_id_t block_id) {
@@ -214,6 +260,24 @@ void BufferManager::ReAllocate(shared_ptr<BlockHandle> &handle, idx_t alloc_size
 }
 
 unique_ptr<BufferHandle> BufferManager::Pin(shared_ptr<BlockHandle> &handle) {
+	return Pin(handle, false);
+}
+
+void BufferManager::RecordAccess(BlockHandle &handle, bool loaded) {
+	if (handle.readers == 0) {
+		// pins of a block that is already pinned belong to the same reference
+		handle.access_count++;
+	}
+	if (handle.block_id < MAXIMUM_BLOCK) {
+		if (loaded) {
+			cache_hits++;
+		} else {
+			cache_misses++;
+		}
+	}
+}
+
+unique_ptr<BufferHandle> BufferManager::Pin(shared_ptr<BlockHandle> &handle, bool prefetch) {
 	idx_t required_memory;
 	{
 		// lock the block
@@ -221,6 +285,9 @@ unique_ptr<BufferHandle> BufferManager::Pin(shared_ptr<BlockHandle> &handle) {
 		// check if the block is already loaded
 		if (handle->state == BlockState::BLOCK_LOADED) {
 			// the block is loaded, increment the reader count and return a pointer to the handle
+			if (!prefetch) {
+				RecordAccess(*handle, true);
+			}
 			handle->readers++;
 			return handle->Load(handle);
 		}
@@ -235,11 +302,17 @@ unique_ptr<BufferHandle> BufferManager::Pin(shared_ptr<BlockHandle> &handle) {
 	// check if the block is already loaded
 	if (handle->state == BlockState::BLOCK_LOADED) {
 		// the block is loaded, increment the reader count and return a pointer to the handle
+		if (!prefetch) {
+			RecordAccess(*handle, true);
+		}
 		handle->readers++;
 		return handle->Load(handle);
 	}
 	// now we can actually load the current block
 	D_ASSERT(handle->readers == 0);
+	if (!prefetch) {
+		RecordAccess(*handle, false);
+	}
 	handle->readers = 1;
 	return handle->Load(handle);
 }
@@ -249,9 +322,92 @@ void BufferManager::Unpin(shared_ptr<BlockHandle> &handle) {
 	D_ASSERT(handle->readers > 0);
 	handle->readers--;
 	if (handle->readers == 0) {
-		handle->eviction_timestamp++;
-		queue->q.enqueue(make_unique<BufferEvictionNode>(weak_ptr<BlockHandle>(handle), handle->eviction_timestamp));
-		// FIXME: do some house-keeping to prevent the queue from being flooded with many old blocks
+		AddToEvictionQueue(handle);
+	}
+}
+
+void BufferManager::AddToEvictionQueue(shared_ptr<BlockHandle> &handle) {
+	EvictionQueueType queue_type;
+	if (handle->block_id >= MAXIMUM_BLOCK && !handle->can_destroy) {
+		queue_type = EvictionQueueType::TEMPORARY;
+	} else if (handle->access_count > 1) {
+		queue_type = EvictionQueueType::HOT;
+	} else {
+		queue_type = EvictionQueueType::COLD;
+	}
+	handle->eviction_timestamp++;
+	queue->q[idx_t(queue_type)].enqueue(
+	    make_unique<BufferEvictionNode>(weak_ptr<BlockHandle>(handle), handle->eviction_timestamp));
+	// FIXME: do some house-keeping to prevent the queues from being flooded with many old blocks
+}
+
+void BufferManager::Prefetch(const vector<shared_ptr<BlockHandle>> &handles) {
+#ifndef DUCKDB_NO_THREADS
+	bool scheduled = false;
+	{
+		lock_guard<mutex> guard(read_ahead->lock);
+		for (auto &handle : handles) {
+			if (handle->block_id >= MAXIMUM_BLOCK) {
+				// in-memory or temporary buffer: nothing to read ahead
+				continue;
+			}
+			if (read_ahead->requests.size() >= READ_AHEAD_QUEUE_SIZE) {
+				break;
+			}
+			read_ahead->requests.push_back(weak_ptr<BlockHandle>(handle));
+			scheduled = true;
+		}
+		if (scheduled && read_ahead->threads.empty()) {
+			// launch the read-ahead threads the first time blocks are requested
+			for (idx_t i = 0; i < READ_AHEAD_THREADS; i++) {
+				read_ahead->threads.push_back(make_unique<thread>(&BufferManager::ExecuteReadAhead, this));
+			}
+		}
+	}
+	if (scheduled) {
+		read_ahead->cv.notify_all();
+	}
+#endif
+}
+
+void BufferManager::ExecuteReadAhead() {
+#ifndef DUCKDB_NO_THREADS
+	while (true) {
+		shared_ptr<BlockHandle> handle;
+		{
+			std::unique_lock<mutex> guard(read_ahead->lock);
+			read_ahead->cv.wait(guard, [&] { return read_ahead->shutdown || !read_ahead->requests.empty(); });
+			if (read_ahead->shutdown) {
+				return;
+			}
+			handle = read_ahead->requests.front().lock();
+			read_ahead->requests.pop_front();
+		}
+		if (handle) {
+			LoadPrefetchedBlock(move(handle));
+		}
+	}
+#endif
+}
+
+void BufferManager::LoadPrefetchedBlock(shared_ptr<BlockHandle> handle) {
+	{
+		lock_guard<mutex> lock(handle->lock);
+		if (handle->state == BlockState::BLOCK_LOADED) {
+			// already loaded (or being used): nothing to do
+			return;
+		}
+		if (current_memory + handle->memory_usage > maximum_memory) {
+			// reading ahead should not push other blocks out of memory
+			return;
+		}
+	}
+	try {
+		// load the block by pinning it; after unpinning it stays in memory until it is evicted
+		auto buffer_handle = Pin(handle, true);
+	} catch (std::exception &ex) {
+		// reading ahead is best-effort: the scan will report any errors once it pins the block itself
+		return;
 	}
 }
 
@@ -259,8 +415,15 @@ bool BufferManager::EvictBlocks(idx_t extra_memory, idx_t memory_limit) {
 	unique_ptr<BufferEvictionNode> node;
 	current_memory += extra_memory;
 	while (current_memory > memory_limit) {
-		// get a block to unpin from the queue
-		if (!queue->q.try_dequeue(node)) {
+		// get a block to unpin from the queues, in order of eviction priority
+		bool found_node = false;
+		for (idx_t queue_idx = 0; queue_idx < EVICTION_QUEUE_COUNT; queue_idx++) {
+			if (queue->q[queue_idx].try_dequeue(node)) {
+				found_node = true;
+				break;
+			}
+		}
+		if (!found_node) {
 			current_memory -= extra_memory;
 			return false;
 		}
@@ -282,10 +445,21 @@ bool BufferManager::EvictBlocks(idx_t extra_memory, idx_t memory_limit) {
 		// hooray, we can unload the block
 		// release the memory and mark the block as unloaded
 		handle->Unload();
+		evicted_blocks++;
 	}
 	return true;
 }
 
+BufferManagerStatistics BufferManager::GetStatistics() {
+	BufferManagerStatistics result;
+	result.cache_hits = cache_hits;
+	result.cache_misses = cache_misses;
+	result.evicted_blocks = evicted_blocks;
+	result.temporary_writes = temporary_writes;
+	result.temporary_reads = temporary_reads;
+	return result;
+}
+
 void BufferManager::UnregisterBlock(block_id_t block_id, bool can_destroy) {
 	if (block_id >= MAXIMUM_BLOCK) {
 		// in-memory buffer: destroy the buffer
@@ -349,6 +523,7 @@ void BufferManager::WriteTemporaryBuffer(ManagedBuffer &buffer) {
 	auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE);
 	handle->Write(&buffer.size, sizeof(idx_t), 0);
 	buffer.Write(*handle, sizeof(idx_t));
+	temporary_writes++;
 }
 
 unique_ptr<FileBuffer> BufferManager::ReadTemporaryBuffer(block_id_t id) {
@@ -364,6 +539,7 @@ unique_ptr<FileBuffer> BufferManager::ReadTemporaryBuffer(block_id_t id) {
 	// now allocate a buffer of this size and read the data into that buffer
 	auto buffer = make_unique<ManagedBuffer>(db, alloc_size, false, id);
 	buffer->Read(*handle, sizeof(idx_t));
+	temporary_reads++;
 	return move(buffer);
 }
 
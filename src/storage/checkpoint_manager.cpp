@@ -28,6 +28,8 @@
 
 #include "duckdb/storage/checkpoint/table_data_writer.hpp"
 #include "duckdb/storage/checkpoint/table_data_reader.hpp"
+#include "duckdb/storage/data_table.hpp"
+#include "duckdb/storage/index.hpp"
 #include "duckdb/main/config.hpp"
 
 namespace duckdb {
@@ -258,6 +260,28 @@ void CheckpointManager::WriteTable(TableCatalogEntry &table) {
 	//! write the block pointer for the table info
 	metadata_writer->Write<block_id_t>(pointer.block_id);
 	metadata_writer->Write<uint64_t>(pointer.offset);
+
+	// write the indexes of the UNIQUE and PRIMARY KEY constraints
+	// these are the first indexes of the table, in the order of the constraints
+	idx_t constraint_index_count = 0;
+	for (auto &constraint : table.bound_constraints) {
+		if (constraint->type == ConstraintType::UNIQUE) {
+			constraint_index_count++;
+		}
+	}
+	vector<BlockPointer> index_pointers;
+	table.storage->info->indexes.Scan([&](Index &index) {
+		if (index_pointers.size() >= constraint_index_count) {
+			return true;
+		}
+		index_pointers.push_back(index.Serialize(*tabledata_writer));
+		return false;
+	});
+	metadata_writer->Write<uint32_t>(index_pointers.size());
+	for (auto &index_pointer : index_pointers) {
+		metadata_writer->Write<block_id_t>(index_pointer.block_id);
+		metadata_writer->Write<uint32_t>(index_pointer.offset);
+	}
 }
 
 void CheckpointManager::ReadTable(ClientContext &context, MetaBlockReader &reader) {
@@ -275,6 +299,15 @@ void CheckpointManager::ReadTable(ClientContext &context, MetaBlockReader &reade
 	TableDataReader data_reader(table_data_reader, *bound_info);
 	data_reader.ReadTableData();
 
+	// read the pointers to the persisted indexes; these are loaded when the table is created
+	auto index_count = reader.Read<uint32_t>();
+	for (idx_t i = 0; i < index_count; i++) {
+		BlockPointer index_pointer;
+		index_pointer.block_id = reader.Read<block_id_t>();
+		index_pointer.offset = reader.Read<uint32_t>();
+		bound_info->data->indexes.push_back(index_pointer);
+	}
+
 	// finally create the table in the catalog
 	auto &catalog = Catalog::GetCatalog(db);
 	catalog.CreateTable(context, bound_info.get());
@@ -0,0 +1,314 @@
+#include "duckdb/storage/compression/bitpacking_segment.hpp"
+
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/compression/compressor.hpp"
+#include "duckdb/storage/statistics/numeric_statistics.hpp"
+
+#include <type_traits>
+
+namespace duckdb {
+
+constexpr const idx_t BitpackingSegment::BITPACKING_GROUP_SIZE;
+
+//! The metadata of a group: the offset of the packed data (uint32_t), the bit width (uint8_t, padded to 8 bytes) and
+//! the frame of reference (T)
+template <class T>
+struct BitpackingGroupMetadata {
+	static constexpr const idx_t WIDTH_OFFSET = sizeof(uint32_t);
+	static constexpr const idx_t REFERENCE_OFFSET = sizeof(uint64_t);
+	static constexpr const idx_t SIZE = sizeof(uint64_t) + sizeof(T);
+
+	static data_ptr_t GetPointer(data_ptr_t base, idx_t group_idx) {
+		return base + Storage::BLOCK_SIZE - (group_idx + 1) * SIZE;
+	}
+};
+
+static BitpackingSegment::scan_function_t GetBitpackingScanFunction(PhysicalType type);
+
+BitpackingSegment::BitpackingSegment(DatabaseInstance &db, PhysicalType type, idx_t row_start, block_id_t block_id)
+    : UncompressedSegment(db, type, row_start) {
+	D_ASSERT(block_id != INVALID_BLOCK);
+	scan_function = GetBitpackingScanFunction(type);
+
+	auto &buffer_manager = BufferManager::GetBufferManager(db);
+	this->block = buffer_manager.RegisterBlock(block_id);
+}
+
+//===--------------------------------------------------------------------===//
+// Scan
+//===--------------------------------------------------------------------===//
+template <class T>
+static void BitpackingScanFunction(data_ptr_t base, idx_t start, idx_t scan_count, Vector &result,
+                                   idx_t result_offset) {
+	typedef typename std::make_unsigned<T>::type UNSIGNED_T;
+	typedef BitpackingGroupMetadata<T> METADATA;
+
+	auto result_data = FlatVector::GetData<T>(result) + result_offset;
+	idx_t row = start;
+	idx_t end = start + scan_count;
+	while (row < end) {
+		idx_t group_idx = row / BitpackingSegment::BITPACKING_GROUP_SIZE;
+		idx_t group_start = group_idx * BitpackingSegment::BITPACKING_GROUP_SIZE;
+		idx_t group_end = MinValue<idx_t>(group_start + BitpackingSegment::BITPACKING_GROUP_SIZE, end);
+
+		auto metadata = METADATA::GetPointer(base, group_idx);
+		auto data_offset = Load<uint32_t>(metadata);
+		auto width = Load<uint8_t>(metadata + METADATA::WIDTH_OFFSET);
+		auto reference = (UNSIGNED_T)Load<T>(metadata + METADATA::REFERENCE_OFFSET);
+
+		auto packed_data = base + data_offset;
+		for (; row < group_end; row++) {
+			auto delta = BitpackingPrimitives::UnpackValue(packed_data, row - group_start, width);
+			result_data[row - start] = (T)(UNSIGNED_T)(reference + delta);
+		}
+	}
+}
+
+static BitpackingSegment::scan_function_t GetBitpackingScanFunction(PhysicalType type) {
+	switch (type) {
+	case PhysicalType::BOOL:
+	case PhysicalType::INT8:
+		return BitpackingScanFunction<int8_t>;
+	case PhysicalType::INT16:
+		return BitpackingScanFunction<int16_t>;
+	case PhysicalType::INT32:
+		return BitpackingScanFunction<int32_t>;
+	case PhysicalType::INT64:
+		return BitpackingScanFunction<int64_t>;
+	case PhysicalType::UINT8:
+		return BitpackingScanFunction<uint8_t>;
+	case PhysicalType::UINT16:
+		return BitpackingScanFunction<uint16_t>;
+	case PhysicalType::UINT32:
+		return BitpackingScanFunction<uint32_t>;
+	case PhysicalType::UINT64:
+		return BitpackingScanFunction<uint64_t>;
+	default:
+		throw NotImplementedException("Unimplemented type for bitpacking segment");
+	}
+}
+
+void BitpackingSegment::InitializeScan(ColumnScanState &state) {
+	auto &buffer_manager = BufferManager::GetBufferManager(db);
+	state.primary_handle = buffer_manager.Pin(block);
+}
+
+void BitpackingSegment::Scan(ColumnScanState &state, idx_t start, idx_t scan_count, Vector &result) {
+	ScanPartial(state, start, scan_count, result, 0);
+}
+
+void BitpackingSegment::ScanPartial(ColumnScanState &state, idx_t start, idx_t scan_count, Vector &result,
+                                    idx_t result_offset) {
+	D_ASSERT(RowRangeIsValid(start, scan_count));
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	scan_function(state.primary_handle->node->buffer, start, scan_count, result, result_offset);
+}
+
+//===--------------------------------------------------------------------===//
+// Fetch
+//===--------------------------------------------------------------------===//
+void BitpackingSegment::FetchRow(ColumnFetchState &state, row_t row_id, Vector &result, idx_t result_idx) {
+	auto &buffer_manager = BufferManager::GetBufferManager(db);
+	auto handle = buffer_manager.Pin(block);
+	scan_function(handle->node->buffer, row_id, 1, result, result_idx);
+}
+
+//===--------------------------------------------------------------------===//
+// Append
+//===--------------------------------------------------------------------===//
+idx_t BitpackingSegment::Append(SegmentStatistics &stats, VectorData &data, idx_t offset, idx_t count) {
+	throw InternalException("Cannot append to a bitpacking segment");
+}
+
+//===--------------------------------------------------------------------===//
+// Compress
+//===--------------------------------------------------------------------===//
+template <class T>
+struct BitpackingGroup {
+	typedef typename std::make_unsigned<T>::type UNSIGNED_T;
+
+	T values[BitpackingSegment::BITPACKING_GROUP_SIZE];
+	bool validity[BitpackingSegment::BITPACKING_GROUP_SIZE];
+	idx_t count = 0;
+	T min;
+	T max;
+	bool has_valid = false;
+
+	bool IsFull() const {
+		return count == BitpackingSegment::BITPACKING_GROUP_SIZE;
+	}
+
+	void Add(const T &value, bool is_valid) {
+		values[count] = value;
+		validity[count] = is_valid;
+		count++;
+		if (!is_valid) {
+			return;
+		}
+		if (!has_valid) {
+			min = value;
+			max = value;
+			has_valid = true;
+		} else {
+			NumericStatistics::UpdateValue<T>(value, min, max);
+		}
+	}
+
+	T GetReference() const {
+		return has_valid ? min : T(0);
+	}
+
+	uint8_t GetWidth() const {
+		if (!has_valid) {
+			return 0;
+		}
+		return BitpackingPrimitives::MinimumBitWidth(uint64_t(UNSIGNED_T(UNSIGNED_T(max) - UNSIGNED_T(min))));
+	}
+
+	idx_t GetPackedSize() const {
+		return BitpackingPrimitives::PackedSize(count, GetWidth());
+	}
+
+	void Reset() {
+		count = 0;
+		has_valid = false;
+	}
+};
+
+template <class T>
+class BitpackingCompressor : public Compressor {
+	typedef typename std::make_unsigned<T>::type UNSIGNED_T;
+	typedef BitpackingGroupMetadata<T> METADATA;
+
+public:
+	explicit BitpackingCompressor(ColumnCheckpointState &checkpoint_state)
+	    : Compressor(checkpoint_state, CompressionType::COMPRESSION_BITPACKING), analyze_size(0), data_offset(0),
+	      segment_group_count(0) {
+	}
+
+	//! The group that is currently being analyzed
+	BitpackingGroup<T> analyze_group;
+	//! The estimated compressed size of the groups analyzed so far
+	idx_t analyze_size;
+	//! The group that is currently being compressed
+	BitpackingGroup<T> group;
+	//! The offset in the current segment to write the next packed group to
+	idx_t data_offset;
+	//! The amount of groups written to the current segment
+	idx_t segment_group_count;
+
+public:
+	bool Analyze(Vector &input, idx_t count) override {
+		VectorData vdata;
+		input.Orrify(count, vdata);
+		auto data = (T *)vdata.data;
+		for (idx_t i = 0; i < count; i++) {
+			auto idx = vdata.sel->get_index(i);
+			analyze_group.Add(data[idx], vdata.validity.RowIsValid(idx));
+			if (analyze_group.IsFull()) {
+				analyze_size += analyze_group.GetPackedSize() + METADATA::SIZE;
+				analyze_group.Reset();
+			}
+		}
+		return true;
+	}
+
+	idx_t EstimatedSize() override {
+		idx_t result = analyze_size;
+		if (analyze_group.count > 0) {
+			result += analyze_group.GetPackedSize() + METADATA::SIZE;
+		}
+		return result;
+	}
+
+	void Compress(Vector &input, idx_t count) override {
+		VectorData vdata;
+		input.Orrify(count, vdata);
+		auto data = (T *)vdata.data;
+		for (idx_t i = 0; i < count; i++) {
+			auto idx = vdata.sel->get_index(i);
+			group.Add(data[idx], vdata.validity.RowIsValid(idx));
+			if (group.IsFull()) {
+				WriteGroup();
+			}
+		}
+	}
+
+	void Finalize() override {
+		if (group.count > 0) {
+			WriteGroup();
+		}
+		if (handle) {
+			FlushSegment();
+		}
+	}
+
+private:
+	void WriteGroup() {
+		auto width = group.GetWidth();
+		auto packed_size = BitpackingPrimitives::PackedSize(group.count, width);
+		if (!handle) {
+			CreateEmptySegment();
+		} else if (data_offset + packed_size + (segment_group_count + 1) * METADATA::SIZE > Storage::BLOCK_SIZE) {
+			// the group does not fit in the current segment anymore: flush it and start a new one
+			FlushSegment();
+			CreateEmptySegment();
+		}
+		auto base = handle->node->buffer;
+		auto reference = group.GetReference();
+
+		// write the metadata of the group
+		auto metadata = METADATA::GetPointer(base, segment_group_count);
+		Store<uint32_t>(data_offset, metadata);
+		Store<uint8_t>(width, metadata + METADATA::WIDTH_OFFSET);
+		Store<T>(reference, metadata + METADATA::REFERENCE_OFFSET);
+
+		// pack the offsets from the reference; NULL values are stored as the reference itself
+		auto packed_data = base + data_offset;
+		for (idx_t i = 0; i < group.count; i++) {
+			if (!group.validity[i]) {
+				continue;
+			}
+			NumericStatistics::Update<T>(*segment_stats, group.values[i]);
+			auto delta = UNSIGNED_T(UNSIGNED_T(group.values[i]) - UNSIGNED_T(reference));
+			BitpackingPrimitives::PackValue(packed_data, i, width, uint64_t(delta));
+		}
+		data_offset += packed_size;
+		segment_group_count++;
+		tuple_count += group.count;
+		group.Reset();
+	}
+
+	void FlushSegment() {
+		Compressor::FlushSegment();
+		data_offset = 0;
+		segment_group_count = 0;
+	}
+};
+
+unique_ptr<Compressor> BitpackingSegment::CreateCompressor(ColumnCheckpointState &checkpoint_state,
+                                                           PhysicalType type) {
+	switch (type) {
+	case PhysicalType::BOOL:
+	case PhysicalType::INT8:
+		return make_unique<BitpackingCompressor<int8_t>>(checkpoint_state);
+	case PhysicalType::INT16:
+		return make_unique<BitpackingCompressor<int16_t>>(checkpoint_state);
+	case PhysicalType::INT32:
+		return make_unique<BitpackingCompressor<int32_t>>(checkpoint_state);
+	case PhysicalType::INT64:
+		return make_unique<BitpackingCompressor<int64_t>>(checkpoint_state);
+	case PhysicalType::UINT8:
+		return make_unique<BitpackingCompressor<uint8_t>>(checkpoint_state);
+	case PhysicalType::UINT16:
+		return make_unique<BitpackingCompressor<uint16_t>>(checkpoint_state);
+	case PhysicalType::UINT32:
+		return make_unique<BitpackingCompressor<uint32_t>>(checkpoint_state);
+	case PhysicalType::UINT64:
+		return make_unique<BitpackingCompressor<uint64_t>>(checkpoint_state);
+	default:
+		return nullptr;
+	}
+}
+
+} // namespace duckdb
@@ -0,0 +1,94 @@
+#include "duckdb/storage/compression/compressor.hpp"
+
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/compression/bitpacking_segment.hpp"
+#include "duckdb/storage/compression/dictionary_segment.hpp"
+#include "duckdb/storage/compression/rle_segment.hpp"
+#include "duckdb/storage/table/column_checkpoint_state.hpp"
+#include "duckdb/storage/table/column_data.hpp"
+
+namespace duckdb {
+
+Compressor::Compressor(ColumnCheckpointState &checkpoint_state, CompressionType type)
+    : checkpoint_state(checkpoint_state), type(type), tuple_count(0) {
+}
+
+Compressor::~Compressor() {
+}
+
+vector<unique_ptr<Compressor>> Compressor::GetCompressors(ColumnCheckpointState &checkpoint_state, PhysicalType type,
+                                                          CompressionType force_compression) {
+	vector<unique_ptr<Compressor>> candidates;
+	candidates.push_back(RLESegment::CreateCompressor(checkpoint_state, type));
+	candidates.push_back(BitpackingSegment::CreateCompressor(checkpoint_state, type));
+	candidates.push_back(DictionarySegment::CreateCompressor(checkpoint_state, type));
+
+	vector<unique_ptr<Compressor>> result;
+	for (auto &candidate : candidates) {
+		if (!candidate) {
+			// compression method is not supported for this type
+			continue;
+		}
+		if (force_compression != CompressionType::COMPRESSION_AUTO && candidate->type != force_compression) {
+			// a different compression method is forced
+			continue;
+		}
+		result.push_back(move(candidate));
+	}
+	return result;
+}
+
+idx_t Compressor::UncompressedSize(Vector &input, idx_t count) {
+	if (input.GetType().InternalType() != PhysicalType::VARCHAR) {
+		return count * GetTypeIdSize(input.GetType().InternalType());
+	}
+	// strings are stored as a dictionary offset, followed by a length and the string data
+	VectorData vdata;
+	input.Orrify(count, vdata);
+	auto strings = (string_t *)vdata.data;
+	idx_t total_size = count * sizeof(int32_t);
+	for (idx_t i = 0; i < count; i++) {
+		auto idx = vdata.sel->get_index(i);
+		if (vdata.validity.RowIsValid(idx)) {
+			total_size += sizeof(uint16_t) + strings[idx].GetSize();
+		}
+	}
+	return total_size;
+}
+
+unique_ptr<UncompressedSegment> Compressor::CreateSegment(DatabaseInstance &db, CompressionType compression,
+                                                          PhysicalType type, idx_t row_start, block_id_t block_id) {
+	switch (compression) {
+	case CompressionType::COMPRESSION_RLE:
+		return make_unique<RLESegment>(db, type, row_start, block_id);
+	case CompressionType::COMPRESSION_BITPACKING:
+		return make_unique<BitpackingSegment>(db, type, row_start, block_id);
+	case CompressionType::COMPRESSION_DICTIONARY:
+		return make_unique<DictionarySegment>(db, type, row_start, block_id);
+	default:
+		throw InternalException("Unsupported compression type %s for compressed segment",
+		                        CompressionTypeToString(compression));
+	}
+}
+
+void Compressor::CreateEmptySegment() {
+	auto &buffer_manager = BufferManager::GetBufferManager(checkpoint_state.column_data.GetDatabase());
+	block = buffer_manager.RegisterMemory(Storage::BLOCK_SIZE, false);
+	handle = buffer_manager.Pin(block);
+	memset(handle->node->buffer, 0, Storage::BLOCK_SIZE);
+	segment_stats = make_unique<SegmentStatistics>(checkpoint_state.column_data.type);
+	tuple_count = 0;
+}
+
+void Compressor::FlushSegment() {
+	D_ASSERT(block && handle);
+	if (tuple_count > 0) {
+		checkpoint_state.WriteSegment(type, *handle, tuple_count, *segment_stats);
+	}
+	handle.reset();
+	block.reset();
+	segment_stats.reset();
+	tuple_count = 0;
+}
+
+} // namespace duckdb
@@ -0,0 +1,310 @@
+#include "duckdb/storage/compression/dictionary_segment.hpp"
+
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/compression/bitpacking_segment.hpp"
+#include "duckdb/storage/compression/compressor.hpp"
+#include "duckdb/storage/statistics/string_statistics.hpp"
+
+namespace duckdb {
+
+constexpr const idx_t DictionarySegment::DICTIONARY_HEADER_SIZE;
+constexpr const idx_t DictionarySegment::DICTIONARY_STRING_LIMIT;
+
+//! The header of a dictionary segment
+struct DictionaryHeader {
+	//! The amount of entries in the dictionary (including the NULL entry)
+	uint32_t dictionary_count;
+	//! The bit width of the packed indices
+	uint32_t index_width;
+	//! The offset of the dictionary entry offsets within the block
+	uint32_t offsets_offset;
+	//! The offset of the dictionary strings within the block
+	uint32_t strings_offset;
+
+	void Write(data_ptr_t base) {
+		Store<uint32_t>(dictionary_count, base);
+		Store<uint32_t>(index_width, base + sizeof(uint32_t));
+		Store<uint32_t>(offsets_offset, base + 2 * sizeof(uint32_t));
+		Store<uint32_t>(strings_offset, base + 3 * sizeof(uint32_t));
+	}
+
+	static DictionaryHeader Read(data_ptr_t base) {
+		DictionaryHeader header;
+		header.dictionary_count = Load<uint32_t>(base);
+		header.index_width = Load<uint32_t>(base + sizeof(uint32_t));
+		header.offsets_offset = Load<uint32_t>(base + 2 * sizeof(uint32_t));
+		header.strings_offset = Load<uint32_t>(base + 3 * sizeof(uint32_t));
+		return header;
+	}
+};
+
+DictionarySegment::DictionarySegment(DatabaseInstance &db, PhysicalType type, idx_t row_start, block_id_t block_id)
+    : UncompressedSegment(db, type, row_start) {
+	D_ASSERT(type == PhysicalType::VARCHAR);
+	D_ASSERT(block_id != INVALID_BLOCK);
+	auto &buffer_manager = BufferManager::GetBufferManager(db);
+	this->block = buffer_manager.RegisterBlock(block_id);
+}
+
+//===--------------------------------------------------------------------===//
+// Scan
+//===--------------------------------------------------------------------===//
+void DictionarySegment::InitializeScan(ColumnScanState &state) {
+	auto &buffer_manager = BufferManager::GetBufferManager(db);
+	state.primary_handle = buffer_manager.Pin(block);
+}
+
+void DictionarySegment::ScanInternal(data_ptr_t base, idx_t start, idx_t scan_count, Vector &result,
+                                     idx_t result_offset) {
+	auto header = DictionaryHeader::Read(base);
+	auto packed_indices = base + DICTIONARY_HEADER_SIZE;
+	auto offsets = (uint32_t *)(base + header.offsets_offset);
+	auto strings = (const char *)(base + header.strings_offset);
+
+	auto result_data = FlatVector::GetData<string_t>(result);
+	for (idx_t i = 0; i < scan_count; i++) {
+		auto index = BitpackingPrimitives::UnpackValue(packed_indices, start + i, header.index_width);
+		D_ASSERT(index < header.dictionary_count);
+		auto string_offset = offsets[index];
+		result_data[result_offset + i] = string_t(strings + string_offset, offsets[index + 1] - string_offset);
+	}
+}
+
+void DictionarySegment::Scan(ColumnScanState &state, idx_t start, idx_t scan_count, Vector &result) {
+	D_ASSERT(RowRangeIsValid(start, scan_count));
+	auto base = state.primary_handle->node->buffer;
+	auto header = DictionaryHeader::Read(base);
+	if (!state.scan_compressed || header.dictionary_count > scan_count) {
+		// the dictionary is bigger than the vector: emit a flat vector
+		ScanPartial(state, start, scan_count, result, 0);
+		return;
+	}
+	// emit a dictionary vector that holds only the dictionary entries that are referenced by this vector
+	auto packed_indices = base + DICTIONARY_HEADER_SIZE;
+	auto offsets = (uint32_t *)(base + header.offsets_offset);
+	auto strings = (const char *)(base + header.strings_offset);
+
+	// maps segment dictionary indices to (one-based) positions in the vector dictionary, 0 means not seen yet
+	sel_t entry_map[STANDARD_VECTOR_SIZE];
+	memset(entry_map, 0, header.dictionary_count * sizeof(sel_t));
+	Vector dictionary(LogicalType::VARCHAR, header.dictionary_count);
+	auto dictionary_data = FlatVector::GetData<string_t>(dictionary);
+	auto &dictionary_mask = FlatVector::Validity(dictionary);
+	SelectionVector sel(scan_count);
+	idx_t dictionary_size = 0;
+	for (idx_t i = 0; i < scan_count; i++) {
+		auto index = BitpackingPrimitives::UnpackValue(packed_indices, start + i, header.index_width);
+		D_ASSERT(index < header.dictionary_count);
+		if (entry_map[index] == 0) {
+			auto string_offset = offsets[index];
+			dictionary_data[dictionary_size] = string_t(strings + string_offset, offsets[index + 1] - string_offset);
+			if (index == 0) {
+				dictionary_mask.SetInvalid(dictionary_size);
+			}
+			entry_map[index] = ++dictionary_size;
+		}
+		sel.set_index(i, entry_map[index] - 1);
+	}
+	result.Slice(dictionary, sel, scan_count);
+	DictionaryVector::SetDictionarySize(result, dictionary_size);
+}
+
+void DictionarySegment::ScanPartial(ColumnScanState &state, idx_t start, idx_t scan_count, Vector &result,
+                                    idx_t result_offset) {
+	D_ASSERT(RowRangeIsValid(start, scan_count));
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	ScanInternal(state.primary_handle->node->buffer, start, scan_count, result, result_offset);
+}
+
+//===--------------------------------------------------------------------===//
+// Fetch
+//===--------------------------------------------------------------------===//
+void DictionarySegment::FetchRow(ColumnFetchState &state, row_t row_id, Vector &result, idx_t result_idx) {
+	// the fetched strings point into the block: keep it pinned for the duration of the fetch
+	auto primary_id = block->BlockId();
+	data_ptr_t base;
+	auto entry = state.handles.find(primary_id);
+	if (entry == state.handles.end()) {
+		auto &buffer_manager = BufferManager::GetBufferManager(db);
+		auto handle = buffer_manager.Pin(block);
+		base = handle->node->buffer;
+		state.handles[primary_id] = move(handle);
+	} else {
+		base = entry->second->node->buffer;
+	}
+	ScanInternal(base, row_id, 1, result, result_idx);
+}
+
+//===--------------------------------------------------------------------===//
+// Append
+//===--------------------------------------------------------------------===//
+idx_t DictionarySegment::Append(SegmentStatistics &stats, VectorData &data, idx_t offset, idx_t count) {
+	throw InternalException("Cannot append to a dictionary segment");
+}
+
+//===--------------------------------------------------------------------===//
+// Compress
+//===--------------------------------------------------------------------===//
+//! A dictionary of distinct strings, where index 0 is reserved for NULL
+struct StringDictionary {
+	StringDictionary() {
+		Clear();
+	}
+
+	//! Map of string -> dictionary index
+	unordered_map<string, uint32_t> indices;
+	//! The concatenated string data of the dictionary entries
+	string data;
+	//! The offsets of the dictionary entries into "data"; contains dictionary_count + 1 entries
+	vector<uint32_t> offsets;
+
+	idx_t Count() const {
+		return offsets.size() - 1;
+	}
+
+	//! The size in bytes of a segment holding "tuple_count" indices into this dictionary
+	idx_t SegmentSize(idx_t tuple_count, idx_t extra_entries = 0, idx_t extra_size = 0) const {
+		idx_t dictionary_count = Count() + extra_entries;
+		auto width = BitpackingPrimitives::MinimumBitWidth(dictionary_count - 1);
+		return DictionarySegment::DICTIONARY_HEADER_SIZE + BitpackingPrimitives::PackedSize(tuple_count, width) +
+		       (dictionary_count + 1) * sizeof(uint32_t) + data.size() + extra_size;
+	}
+
+	uint32_t AddEntry(const string_t &str) {
+		uint32_t index = Count();
+		indices[str.GetString()] = index;
+		data.append(str.GetDataUnsafe(), str.GetSize());
+		offsets.push_back(data.size());
+		return index;
+	}
+
+	void Clear() {
+		indices.clear();
+		data.clear();
+		offsets.clear();
+		// entry 0: the NULL entry (an empty string)
+		offsets.push_back(0);
+		offsets.push_back(0);
+	}
+};
+
+class DictionaryCompressor : public Compressor {
+public:
+	explicit DictionaryCompressor(ColumnCheckpointState &checkpoint_state)
+	    : Compressor(checkpoint_state, CompressionType::COMPRESSION_DICTIONARY), analyze_count(0) {
+	}
+
+	//! The dictionary of all strings seen during analysis
+	StringDictionary analyze_dictionary;
+	//! The amount of values seen during analysis
+	idx_t analyze_count;
+	//! The dictionary of the current segment
+	StringDictionary dictionary;
+	//! The dictionary indices of the current segment
+	vector<uint32_t> indices;
+
+public:
+	bool Analyze(Vector &input, idx_t count) override {
+		VectorData vdata;
+		input.Orrify(count, vdata);
+		auto data = (string_t *)vdata.data;
+		for (idx_t i = 0; i < count; i++) {
+			auto idx = vdata.sel->get_index(i);
+			if (!vdata.validity.RowIsValid(idx)) {
+				continue;
+			}
+			if (data[idx].GetSize() >= DictionarySegment::DICTIONARY_STRING_LIMIT) {
+				// big strings are not supported in dictionary segments
+				return false;
+			}
+			if (analyze_dictionary.indices.find(data[idx].GetString()) == analyze_dictionary.indices.end()) {
+				analyze_dictionary.AddEntry(data[idx]);
+			}
+		}
+		analyze_count += count;
+		return true;
+	}
+
+	idx_t EstimatedSize() override {
+		return analyze_dictionary.SegmentSize(analyze_count);
+	}
+
+	void Compress(Vector &input, idx_t count) override {
+		VectorData vdata;
+		input.Orrify(count, vdata);
+		auto data = (string_t *)vdata.data;
+		for (idx_t i = 0; i < count; i++) {
+			auto idx = vdata.sel->get_index(i);
+			if (!handle) {
+				CreateEmptySegment();
+			}
+			if (!vdata.validity.RowIsValid(idx)) {
+				if (dictionary.SegmentSize(tuple_count + 1) > Storage::BLOCK_SIZE) {
+					FlushDictionarySegment();
+					CreateEmptySegment();
+				}
+				AppendIndex(0);
+				continue;
+			}
+			auto &str = data[idx];
+			auto entry = dictionary.indices.find(str.GetString());
+			bool is_new = entry == dictionary.indices.end();
+			if (dictionary.SegmentSize(tuple_count + 1, is_new ? 1 : 0, is_new ? str.GetSize() : 0) >
+			    Storage::BLOCK_SIZE) {
+				// the value does not fit in the current segment anymore: flush it and start a new one
+				FlushDictionarySegment();
+				CreateEmptySegment();
+				is_new = true;
+			}
+			AppendIndex(is_new ? dictionary.AddEntry(str) : entry->second);
+			auto &sstats = (StringStatistics &)*segment_stats->statistics;
+			sstats.Update(str);
+		}
+	}
+
+	void Finalize() override {
+		if (handle) {
+			FlushDictionarySegment();
+		}
+	}
+
+private:
+	void AppendIndex(uint32_t index) {
+		indices.push_back(index);
+		tuple_count++;
+	}
+
+	void FlushDictionarySegment() {
+		auto base = handle->node->buffer;
+
+		DictionaryHeader header;
+		header.dictionary_count = dictionary.Count();
+		header.index_width = BitpackingPrimitives::MinimumBitWidth(header.dictionary_count - 1);
+		header.offsets_offset =
+		    DictionarySegment::DICTIONARY_HEADER_SIZE + BitpackingPrimitives::PackedSize(tuple_count, header.index_width);
+		header.strings_offset = header.offsets_offset + dictionary.offsets.size() * sizeof(uint32_t);
+		D_ASSERT(header.strings_offset + dictionary.data.size() <= Storage::BLOCK_SIZE);
+		header.Write(base);
+
+		auto packed_indices = base + DictionarySegment::DICTIONARY_HEADER_SIZE;
+		for (idx_t i = 0; i < indices.size(); i++) {
+			BitpackingPrimitives::PackValue(packed_indices, i, header.index_width, indices[i]);
+		}
+		memcpy(base + header.offsets_offset, dictionary.offsets.data(), dictionary.offsets.size() * sizeof(uint32_t));
+		memcpy(base + header.strings_offset, dictionary.data.c_str(), dictionary.data.size());
+
+		indices.clear();
+		dictionary.Clear();
+		FlushSegment();
+	}
+};
+
+unique_ptr<Compressor> DictionarySegment::CreateCompressor(ColumnCheckpointState &checkpoint_state,
+                                                           PhysicalType type) {
+	if (type != PhysicalType::VARCHAR) {
+		return nullptr;
+	}
+	return make_unique<DictionaryCompressor>(checkpoint_state);
+}
+
+} // namespace duckdb
@@ -0,0 +1,356 @@
+#include "duckdb/storage/compression/rle_segment.hpp"
+
+#include "duckdb/common/operator/comparison_operators.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/compression/compressor.hpp"
+#include "duckdb/storage/statistics/numeric_statistics.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+constexpr const idx_t RLESegment::DICTIONARY_RUN_LENGTH;
+
+typedef uint32_t rle_run_end_t;
+
+static RLESegment::scan_function_t GetRLEScanFunction(PhysicalType type);
+static RLESegment::scan_compressed_function_t GetRLEScanCompressedFunction(PhysicalType type);
+
+RLESegment::RLESegment(DatabaseInstance &db, PhysicalType type, idx_t row_start, block_id_t block_id)
+    : UncompressedSegment(db, type, row_start) {
+	D_ASSERT(block_id != INVALID_BLOCK);
+	scan_function = GetRLEScanFunction(type);
+	scan_compressed_function = GetRLEScanCompressedFunction(type);
+
+	auto &buffer_manager = BufferManager::GetBufferManager(db);
+	this->block = buffer_manager.RegisterBlock(block_id);
+}
+
+idx_t RLESegment::GetRunEndOffset(idx_t run_count, idx_t type_size) {
+	// the run ends are aligned to 8 bytes
+	idx_t offset = sizeof(uint64_t) + run_count * type_size;
+	return (offset + 7) / 8 * 8;
+}
+
+//===--------------------------------------------------------------------===//
+// Scan
+//===--------------------------------------------------------------------===//
+template <class T>
+static void RLEScanFunction(data_ptr_t base, idx_t start, idx_t scan_count, Vector &result, idx_t result_offset) {
+	auto run_count = Load<uint64_t>(base);
+	auto values = (T *)(base + sizeof(uint64_t));
+	auto run_ends = (rle_run_end_t *)(base + RLESegment::GetRunEndOffset(run_count, sizeof(T)));
+
+	// find the run that contains the first row
+	idx_t run_idx = std::upper_bound(run_ends, run_ends + run_count, rle_run_end_t(start)) - run_ends;
+	D_ASSERT(run_idx < run_count);
+
+	auto result_data = FlatVector::GetData<T>(result);
+	idx_t row = start;
+	idx_t end = start + scan_count;
+	while (row < end) {
+		idx_t run_end = MinValue<idx_t>(run_ends[run_idx], end);
+		auto value = values[run_idx];
+		for (; row < run_end; row++) {
+			result_data[result_offset + row - start] = value;
+		}
+		run_idx++;
+	}
+}
+
+//! Scans a vector that is covered by a single run as a constant vector, or a vector that is covered by few runs as a
+//! dictionary vector of the run values. Returns false if the vector should be scanned as a flat vector instead.
+template <class T>
+static bool RLEScanCompressedFunction(data_ptr_t base, idx_t start, idx_t scan_count, Vector &result) {
+	auto run_count = Load<uint64_t>(base);
+	auto values = (T *)(base + sizeof(uint64_t));
+	auto run_ends = (rle_run_end_t *)(base + RLESegment::GetRunEndOffset(run_count, sizeof(T)));
+
+	idx_t end = start + scan_count;
+	idx_t first_run = std::upper_bound(run_ends, run_ends + run_count, rle_run_end_t(start)) - run_ends;
+	idx_t last_run = std::upper_bound(run_ends + first_run, run_ends + run_count, rle_run_end_t(end - 1)) - run_ends;
+	D_ASSERT(last_run < run_count);
+	idx_t vector_runs = last_run - first_run + 1;
+	if (vector_runs == 1) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+		*ConstantVector::GetData<T>(result) = values[first_run];
+		return true;
+	}
+	if (vector_runs * RLESegment::DICTIONARY_RUN_LENGTH > scan_count) {
+		return false;
+	}
+	Vector dictionary(result.GetType(), vector_runs);
+	memcpy(FlatVector::GetData<T>(dictionary), values + first_run, vector_runs * sizeof(T));
+	SelectionVector sel(scan_count);
+	idx_t row = start;
+	for (idx_t run_idx = first_run; run_idx <= last_run; run_idx++) {
+		idx_t run_end = MinValue<idx_t>(run_ends[run_idx], end);
+		for (; row < run_end; row++) {
+			sel.set_index(row - start, run_idx - first_run);
+		}
+	}
+	result.Slice(dictionary, sel, scan_count);
+	DictionaryVector::SetDictionarySize(result, vector_runs);
+	return true;
+}
+
+static RLESegment::scan_function_t GetRLEScanFunction(PhysicalType type) {
+	switch (type) {
+	case PhysicalType::BOOL:
+	case PhysicalType::INT8:
+		return RLEScanFunction<int8_t>;
+	case PhysicalType::INT16:
+		return RLEScanFunction<int16_t>;
+	case PhysicalType::INT32:
+		return RLEScanFunction<int32_t>;
+	case PhysicalType::INT64:
+		return RLEScanFunction<int64_t>;
+	case PhysicalType::UINT8:
+		return RLEScanFunction<uint8_t>;
+	case PhysicalType::UINT16:
+		return RLEScanFunction<uint16_t>;
+	case PhysicalType::UINT32:
+		return RLEScanFunction<uint32_t>;
+	case PhysicalType::UINT64:
+		return RLEScanFunction<uint64_t>;
+	case PhysicalType::INT128:
+		return RLEScanFunction<hugeint_t>;
+	case PhysicalType::FLOAT:
+		return RLEScanFunction<float>;
+	case PhysicalType::DOUBLE:
+		return RLEScanFunction<double>;
+	default:
+		throw NotImplementedException("Unimplemented type for RLE segment");
+	}
+}
+
+static RLESegment::scan_compressed_function_t GetRLEScanCompressedFunction(PhysicalType type) {
+	switch (type) {
+	case PhysicalType::BOOL:
+	case PhysicalType::INT8:
+		return RLEScanCompressedFunction<int8_t>;
+	case PhysicalType::INT16:
+		return RLEScanCompressedFunction<int16_t>;
+	case PhysicalType::INT32:
+		return RLEScanCompressedFunction<int32_t>;
+	case PhysicalType::INT64:
+		return RLEScanCompressedFunction<int64_t>;
+	case PhysicalType::UINT8:
+		return RLEScanCompressedFunction<uint8_t>;
+	case PhysicalType::UINT16:
+		return RLEScanCompressedFunction<uint16_t>;
+	case PhysicalType::UINT32:
+		return RLEScanCompressedFunction<uint32_t>;
+	case PhysicalType::UINT64:
+		return RLEScanCompressedFunction<uint64_t>;
+	case PhysicalType::INT128:
+		return RLEScanCompressedFunction<hugeint_t>;
+	case PhysicalType::FLOAT:
+		return RLEScanCompressedFunction<float>;
+	case PhysicalType::DOUBLE:
+		return RLEScanCompressedFunction<double>;
+	default:
+		throw NotImplementedException("Unimplemented type for RLE segment");
+	}
+}
+
+void RLESegment::InitializeScan(ColumnScanState &state) {
+	auto &buffer_manager = BufferManager::GetBufferManager(db);
+	state.primary_handle = buffer_manager.Pin(block);
+}
+
+void RLESegment::Scan(ColumnScanState &state, idx_t start, idx_t scan_count, Vector &result) {
+	D_ASSERT(RowRangeIsValid(start, scan_count));
+	if (state.scan_compressed &&
+	    scan_compressed_function(state.primary_handle->node->buffer, start, scan_count, result)) {
+		return;
+	}
+	ScanPartial(state, start, scan_count, result, 0);
+}
+
+void RLESegment::ScanPartial(ColumnScanState &state, idx_t start, idx_t scan_count, Vector &result,
+                             idx_t result_offset) {
+	D_ASSERT(RowRangeIsValid(start, scan_count));
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	scan_function(state.primary_handle->node->buffer, start, scan_count, result, result_offset);
+}
+
+//===--------------------------------------------------------------------===//
+// Fetch
+//===--------------------------------------------------------------------===//
+void RLESegment::FetchRow(ColumnFetchState &state, row_t row_id, Vector &result, idx_t result_idx) {
+	auto &buffer_manager = BufferManager::GetBufferManager(db);
+	auto handle = buffer_manager.Pin(block);
+	scan_function(handle->node->buffer, row_id, 1, result, result_idx);
+}
+
+//===--------------------------------------------------------------------===//
+// Append
+//===--------------------------------------------------------------------===//
+idx_t RLESegment::Append(SegmentStatistics &stats, VectorData &data, idx_t offset, idx_t count) {
+	throw InternalException("Cannot append to an RLE segment");
+}
+
+//===--------------------------------------------------------------------===//
+// Compress
+//===--------------------------------------------------------------------===//
+template <class T>
+struct RLERun {
+	T value = T();
+	idx_t length = 0;
+	//! Whether or not the run so far only consists of NULL values
+	bool all_null = true;
+
+	//! Whether or not the (possibly NULL) value can be added to the current run. NULL values can be added to any run,
+	//! since their actual value is never read.
+	bool Matches(const T &new_value, bool is_valid) const {
+		return length > 0 && (!is_valid || all_null || Equals::Operation<T>(value, new_value));
+	}
+
+	void Add(const T &new_value, bool is_valid) {
+		if (is_valid && all_null) {
+			value = new_value;
+			all_null = false;
+		}
+		length++;
+	}
+
+	void Reset() {
+		value = T();
+		length = 0;
+		all_null = true;
+	}
+};
+
+template <class T>
+class RLECompressor : public Compressor {
+public:
+	explicit RLECompressor(ColumnCheckpointState &checkpoint_state)
+	    : Compressor(checkpoint_state, CompressionType::COMPRESSION_RLE), analyze_run_count(0) {
+		max_runs_per_segment = (Storage::BLOCK_SIZE - sizeof(uint64_t) - 8) / (sizeof(T) + sizeof(rle_run_end_t));
+	}
+
+	//! The current run during analysis
+	RLERun<T> analyze_run;
+	//! The amount of finished runs during analysis
+	idx_t analyze_run_count;
+	//! The current run during compression
+	RLERun<T> run;
+	//! The run ends of the current segment
+	vector<rle_run_end_t> run_ends;
+	//! The maximum amount of runs that fit in a single segment
+	idx_t max_runs_per_segment;
+
+public:
+	bool Analyze(Vector &input, idx_t count) override {
+		VectorData vdata;
+		input.Orrify(count, vdata);
+		auto data = (T *)vdata.data;
+		for (idx_t i = 0; i < count; i++) {
+			auto idx = vdata.sel->get_index(i);
+			bool is_valid = vdata.validity.RowIsValid(idx);
+			if (!analyze_run.Matches(data[idx], is_valid)) {
+				if (analyze_run.length > 0) {
+					analyze_run_count++;
+				}
+				analyze_run.Reset();
+			}
+			analyze_run.Add(data[idx], is_valid);
+		}
+		return true;
+	}
+
+	idx_t EstimatedSize() override {
+		idx_t run_count = analyze_run_count + (analyze_run.length > 0 ? 1 : 0);
+		idx_t segment_count = (run_count + max_runs_per_segment - 1) / max_runs_per_segment;
+		return run_count * (sizeof(T) + sizeof(rle_run_end_t)) + segment_count * sizeof(uint64_t);
+	}
+
+	void Compress(Vector &input, idx_t count) override {
+		VectorData vdata;
+		input.Orrify(count, vdata);
+		auto data = (T *)vdata.data;
+		for (idx_t i = 0; i < count; i++) {
+			auto idx = vdata.sel->get_index(i);
+			bool is_valid = vdata.validity.RowIsValid(idx);
+			if (!run.Matches(data[idx], is_valid)) {
+				if (run.length > 0) {
+					WriteRun();
+				}
+				run.Reset();
+			}
+			run.Add(data[idx], is_valid);
+		}
+	}
+
+	void Finalize() override {
+		if (run.length > 0) {
+			WriteRun();
+			run.Reset();
+		}
+		if (handle) {
+			FlushRLESegment();
+		}
+	}
+
+private:
+	void WriteRun() {
+		if (!handle) {
+			CreateEmptySegment();
+		} else if (run_ends.size() >= max_runs_per_segment ||
+		           tuple_count + run.length > NumericLimits<rle_run_end_t>::Maximum()) {
+			// the segment is full: flush it and start a new one
+			FlushRLESegment();
+			CreateEmptySegment();
+		}
+		auto values = (T *)(handle->node->buffer + sizeof(uint64_t));
+		values[run_ends.size()] = run.value;
+		tuple_count += run.length;
+		run_ends.push_back(tuple_count);
+		if (!run.all_null) {
+			NumericStatistics::Update<T>(*segment_stats, run.value);
+		}
+	}
+
+	void FlushRLESegment() {
+		// write the run count and the run ends behind the values
+		auto base = handle->node->buffer;
+		Store<uint64_t>(run_ends.size(), base);
+		auto run_end_offset = RLESegment::GetRunEndOffset(run_ends.size(), sizeof(T));
+		memcpy(base + run_end_offset, run_ends.data(), run_ends.size() * sizeof(rle_run_end_t));
+		run_ends.clear();
+		FlushSegment();
+	}
+};
+
+unique_ptr<Compressor> RLESegment::CreateCompressor(ColumnCheckpointState &checkpoint_state, PhysicalType type) {
+	switch (type) {
+	case PhysicalType::BOOL:
+	case PhysicalType::INT8:
+		return make_unique<RLECompressor<int8_t>>(checkpoint_state);
+	case PhysicalType::INT16:
+		return make_unique<RLECompressor<int16_t>>(checkpoint_state);
+	case PhysicalType::INT32:
+		return make_unique<RLECompressor<int32_t>>(checkpoint_state);
+	case PhysicalType::INT64:
+		return make_unique<RLECompressor<int64_t>>(checkpoint_state);
+	case PhysicalType::UINT8:
+		return make_unique<RLECompressor<uint8_t>>(checkpoint_state);
+	case PhysicalType::UINT16:
+		return make_unique<RLECompressor<uint16_t>>(checkpoint_state);
+	case PhysicalType::UINT32:
+		return make_unique<RLECompressor<uint32_t>>(checkpoint_state);
+	case PhysicalType::UINT64:
+		return make_unique<RLECompressor<uint64_t>>(checkpoint_state);
+	case PhysicalType::INT128:
+		return make_unique<RLECompressor<hugeint_t>>(checkpoint_state);
+	case PhysicalType::FLOAT:
+		return make_unique<RLECompressor<float>>(checkpoint_state);
+	case PhysicalType::DOUBLE:
+		return make_unique<RLECompressor<double>>(checkpoint_state);
+	default:
+		return nullptr;
+	}
+}
+
+} // namespace duckdb
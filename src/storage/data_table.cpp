@@ -6,6 +6,8 @@
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/parallel/task_counter.hpp"
 #include "duckdb/planner/constraints/list.hpp"
 #include "duckdb/planner/table_filter.hpp"
 #include "duckdb/storage/storage_manager.hpp"
@@ -275,6 +277,7 @@ idx_t DataTable::MaxThreads(ClientContext &context) {
 
 void DataTable::InitializeParallelScan(ParallelTableScanState &state) {
 	state.current_row_group = (RowGroup *)row_groups->GetRootSegment();
+	state.vector_index = 0;
 	state.transaction_local_data = false;
 }
 
@@ -457,6 +460,159 @@ void DataTable::Append(TableCatalogEntry &table, ClientContext &context, DataChu
 	transaction.storage.Append(this, chunk);
 }
 
+void DataTable::LocalAppend(TableCatalogEntry &table, ClientContext &context, DataChunk &chunk,
+                            ChunkCollection &local_collection) {
+	if (chunk.size() == 0) {
+		return;
+	}
+	if (chunk.ColumnCount() != table.columns.size()) {
+		throw CatalogException("Mismatch in column count for append");
+	}
+	if (!is_root) {
+		throw TransactionException("Transaction conflict: adding entries to a table that has been altered!");
+	}
+
+	chunk.Verify();
+
+	// verify any constraints on the new chunk
+	VerifyAppendConstraints(table, chunk);
+
+	// append to the thread-local collection
+	local_collection.Append(chunk);
+}
+
+void DataTable::MergeLocalCollection(ClientContext &context, ChunkCollection &local_collection) {
+	D_ASSERT(info->indexes.Empty());
+	auto &transaction = Transaction::GetTransaction(context);
+	idx_t append_count = local_collection.Count();
+	if (append_count == 0) {
+		return;
+	}
+	if (append_count < RowGroup::ROW_GROUP_SIZE) {
+		// less than a row group: add the chunks to the transaction-local storage
+		for (auto &chunk : local_collection.Chunks()) {
+			transaction.storage.Append(this, *chunk);
+		}
+		local_collection.Reset();
+		return;
+	}
+	// at least one full row group: append the chunks to the base table directly
+	// the append lock is held until the append is pushed to the undo buffer of the transaction
+	TableAppendState append_state;
+	InitializeAppend(transaction, append_state, append_count);
+	for (auto &chunk : local_collection.Chunks()) {
+		Append(transaction, *chunk, append_state);
+	}
+	transaction.PushAppend(this, append_state.row_start, append_count);
+	local_collection.Reset();
+}
+
+//===--------------------------------------------------------------------===//
+// Ordered parallel append
+//===--------------------------------------------------------------------===//
+void DataTable::InitializeBatchAppend(BatchAppendState &state, LocalBatchAppendState &lstate) {
+	D_ASSERT(info->indexes.Empty());
+	lock_guard<mutex> lock(state.lock);
+	// the batch index of the first rows of this thread is not known yet: hold back all batches until it is
+	lstate.thread_index = state.thread_count++;
+	state.active_batches[lstate.thread_index] = 0;
+}
+
+void DataTable::LocalBatchAppend(TableCatalogEntry &table, ClientContext &context, DataChunk &chunk,
+                                 idx_t batch_index, BatchAppendState &state, LocalBatchAppendState &lstate) {
+	D_ASSERT(batch_index >= lstate.current_batch);
+	if (batch_index != lstate.current_batch) {
+		// the chunk belongs to a new batch: hand over the rows of the previous batch
+		HandOverBatch(context, state, lstate, batch_index, false);
+	}
+	if (!lstate.collection) {
+		lstate.collection = make_unique<ChunkCollection>();
+	}
+	LocalAppend(table, context, chunk, *lstate.collection);
+	if (lstate.collection->Count() >= RowGroup::ROW_GROUP_SIZE) {
+		// hand over the rows gathered so far, e.g. a sequential scan produces all of its rows in a single batch
+		HandOverBatch(context, state, lstate, lstate.current_batch, false);
+	}
+}
+
+void DataTable::FinishBatchAppend(ClientContext &context, BatchAppendState &state, LocalBatchAppendState &lstate) {
+	HandOverBatch(context, state, lstate, lstate.current_batch, true);
+}
+
+void DataTable::FinalizeBatchAppend(ClientContext &context, BatchAppendState &state) {
+	D_ASSERT(state.active_batches.empty());
+	MergeBatches(context, state, true);
+	D_ASSERT(state.batches.empty());
+}
+
+void DataTable::HandOverBatch(ClientContext &context, BatchAppendState &state, LocalBatchAppendState &lstate,
+                              idx_t next_batch, bool finished) {
+	{
+		lock_guard<mutex> lock(state.lock);
+		if (lstate.collection && lstate.collection->Count() > 0) {
+			state.batches[make_pair(lstate.current_batch, state.batch_sequence++)] = move(lstate.collection);
+		}
+		// the batch is handed over and the thread moves on in the same step, so no rows can be overtaken
+		if (finished) {
+			state.active_batches.erase(lstate.thread_index);
+		} else {
+			state.active_batches[lstate.thread_index] = next_batch;
+		}
+	}
+	lstate.collection.reset();
+	lstate.current_batch = next_batch;
+	MergeBatches(context, state, false);
+}
+
+//! Merges the handed over rows that are next in line into the table. The rows of a batch can be merged once no thread
+//! is at a lower batch: the batches of the source are handed out in increasing order, so any lower batch that has not
+//! been handed over by then did not produce any rows.
+void DataTable::MergeBatches(ClientContext &context, BatchAppendState &state, bool force) {
+	unique_lock<mutex> merge_guard(state.merge_lock, std::defer_lock);
+	if (force) {
+		merge_guard.lock();
+	} else if (!merge_guard.try_lock()) {
+		// another thread is merging: it (or the next merge) picks up our batch
+		return;
+	}
+	while (true) {
+		unique_ptr<ChunkCollection> batch;
+		{
+			lock_guard<mutex> lock(state.lock);
+			if (state.batches.empty()) {
+				break;
+			}
+			auto entry = state.batches.begin();
+			bool preceded = false;
+			for (auto &active : state.active_batches) {
+				if (active.second < entry->first.first) {
+					// a thread might still produce rows that precede this batch
+					preceded = true;
+					break;
+				}
+			}
+			if (preceded) {
+				break;
+			}
+			batch = move(entry->second);
+			state.batches.erase(entry);
+		}
+		if (state.pending.Count() == 0) {
+			state.pending.Merge(*batch);
+		} else {
+			state.pending.Append(*batch);
+		}
+		if (state.pending.Count() >= RowGroup::ROW_GROUP_SIZE) {
+			// the full row groups are appended to the base table in the order of the batches
+			MergeLocalCollection(context, state.pending);
+		}
+	}
+	if (force) {
+		// the remaining rows are added to the transaction-local storage, which is appended after the base table rows
+		MergeLocalCollection(context, state.pending);
+	}
+}
+
 void DataTable::InitializeAppend(Transaction &transaction, TableAppendState &state, idx_t append_count) {
 	// obtain the append lock for this table
 	state.append_lock = unique_lock<mutex>(append_lock);
@@ -994,6 +1150,91 @@ bool DataTable::ScanCreateIndex(CreateIndexScanState &state, DataChunk &result,
 	return false;
 }
 
+//! The shared state of the tasks that collect the entries of an index that is constructed in bulk
+struct IndexBuildTaskState {
+	IndexBuildTaskState(Index &index, const vector<unique_ptr<Expression>> &expressions)
+	    : index(index), expressions(expressions), max_row(0), next_row_group(0) {
+	}
+
+	Index &index;
+	const vector<unique_ptr<Expression>> &expressions;
+	//! The columns to scan (the indexed columns and the row id)
+	vector<column_t> column_ids;
+	vector<LogicalType> intermediate_types;
+	idx_t max_row;
+	//! The row groups of the table, every task takes the next row group until all of them are scanned
+	vector<RowGroup *> row_groups;
+	atomic<idx_t> next_row_group;
+
+	mutex error_lock;
+	//! The type and message of the error thrown by one of the tasks (if any)
+	ExceptionType error_type = ExceptionType::INVALID;
+	string error;
+};
+
+static void IndexBuildScan(IndexBuildTaskState &gstate, IndexBuildState &build_state) {
+	TableScanState scan_state;
+	scan_state.column_ids = gstate.column_ids;
+	scan_state.max_row = gstate.max_row;
+
+	DataChunk intermediate;
+	intermediate.Initialize(gstate.intermediate_types);
+	DataChunk result;
+	result.Initialize(gstate.index.logical_types);
+	ExpressionExecutor executor(gstate.expressions);
+	while (true) {
+		auto row_group_idx = gstate.next_row_group++;
+		if (row_group_idx >= gstate.row_groups.size()) {
+			break;
+		}
+		auto row_group = gstate.row_groups[row_group_idx];
+		row_group->InitializeScan(scan_state.row_group_scan_state);
+		while (true) {
+			intermediate.Reset();
+			row_group->IndexScan(scan_state.row_group_scan_state, intermediate, false);
+			if (intermediate.size() == 0) {
+				break;
+			}
+			// resolve the expressions for this chunk
+			result.Reset();
+			executor.Execute(intermediate, result);
+			gstate.index.BuildAppend(build_state, result, intermediate.data[intermediate.ColumnCount() - 1]);
+		}
+	}
+	gstate.index.FinishBuild(build_state);
+}
+
+class IndexBuildTask : public Task {
+public:
+	IndexBuildTask(TaskCounter &counter, IndexBuildTaskState &gstate, IndexBuildState &build_state)
+	    : counter(counter), gstate(gstate), build_state(build_state) {
+	}
+
+	void Execute() override {
+		try {
+			IndexBuildScan(gstate, build_state);
+		} catch (Exception &ex) {
+			lock_guard<mutex> elock(gstate.error_lock);
+			gstate.error_type = ex.type;
+			gstate.error = ex.RawMessage();
+		} catch (std::exception &ex) {
+			lock_guard<mutex> elock(gstate.error_lock);
+			gstate.error_type = ExceptionType::INVALID;
+			gstate.error = ex.what();
+		} catch (...) {
+			lock_guard<mutex> elock(gstate.error_lock);
+			gstate.error_type = ExceptionType::INVALID;
+			gstate.error = "Unknown exception in index construction!";
+		}
+		counter.FinishTask();
+	}
+
+private:
+	TaskCounter &counter;
+	IndexBuildTaskState &gstate;
+	IndexBuildState &build_state;
+};
+
 void DataTable::AddIndex(unique_ptr<Index> index, const vector<unique_ptr<Expression>> &expressions) {
 	DataChunk result;
 	result.Initialize(index->logical_types);
@@ -1016,6 +1257,48 @@ void DataTable::AddIndex(unique_ptr<Index> index, const vector<unique_ptr<Expres
 		throw TransactionException("Transaction conflict: cannot add an index to a table that has been altered!");
 	}
 
+	auto build_state = index->InitializeBuild();
+	if (build_state) {
+		// construct the index in bulk: the row groups are scanned in parallel, after which the index is constructed
+		// from the entries of all threads at once
+		IndexBuildTaskState gstate(*index, expressions);
+		gstate.column_ids = column_ids;
+		gstate.intermediate_types = intermediate_types;
+		gstate.max_row = state.max_row;
+		for (auto row_group = (RowGroup *)row_groups->GetRootSegment(); row_group;
+		     row_group = (RowGroup *)row_group->next.get()) {
+			gstate.row_groups.push_back(row_group);
+		}
+
+		auto &scheduler = db.GetScheduler();
+		idx_t task_count = MinValue<idx_t>(scheduler.NumberOfThreads(), gstate.row_groups.size());
+		vector<unique_ptr<IndexBuildState>> build_states;
+		build_states.push_back(move(build_state));
+		if (task_count <= 1) {
+			IndexBuildScan(gstate, *build_states[0]);
+		} else {
+			TaskCounter counter(scheduler);
+			for (idx_t i = 0; i < task_count; i++) {
+				if (i > 0) {
+					build_states.push_back(index->InitializeBuild());
+				}
+				counter.AddTask(make_unique<IndexBuildTask>(counter, gstate, *build_states[i]));
+			}
+			counter.Finish();
+			if (!gstate.error.empty()) {
+				Exception::ThrowAsTypeWithMessage(gstate.error_type, gstate.error);
+			}
+		}
+
+		IndexLock lock;
+		index->InitializeLock(lock);
+		if (!index->Build(lock, build_states)) {
+			throw ConstraintException("Cant create unique index, table contains duplicate data on indexed column(s)");
+		}
+		info->indexes.AddIndex(move(index));
+		return;
+	}
+
 	// now start incrementally building the index
 	{
 		IndexLock lock;
@@ -1062,6 +1345,19 @@ BlockPointer DataTable::Checkpoint(TableDataWriter &writer) {
 		global_stats.push_back(BaseStatistics::CreateEmpty(types[i]));
 	}
 
+	{
+		// an aborted parallel append cannot revert its row groups if another transaction appended after it: the row
+		// groups stay behind without any visible rows, and no transaction can see them anymore once we checkpoint
+		// the last row group is always kept, as appends continue in it
+		lock_guard<mutex> tree_lock(row_groups->node_lock);
+		for (idx_t segment_idx = row_groups->nodes.size(); segment_idx > 1; segment_idx--) {
+			auto row_group = (RowGroup *)row_groups->nodes[segment_idx - 2].node;
+			if (!row_group->HasCommittedInserts()) {
+				row_groups->EraseSegment(segment_idx - 2);
+			}
+		}
+	}
+
 	auto row_group = (RowGroup *)row_groups->GetRootSegment();
 	vector<RowGroupPointer> row_group_pointers;
 	while (row_group) {
@@ -1104,6 +1400,10 @@ void DataTable::CommitDropTable() {
 		segment->CommitDrop();
 		segment = (RowGroup *)segment->next.get();
 	}
+	info->indexes.Scan([&](Index &index) {
+		index.CommitDrop();
+		return false;
+	});
 }
 
 //===--------------------------------------------------------------------===//
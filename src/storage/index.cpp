@@ -64,4 +64,11 @@ bool Index::IndexIsUpdated(const vector<column_t> &column_ids) const {
 	return false;
 }
 
+BlockPointer Index::Serialize(MetaBlockWriter &writer) {
+	BlockPointer pointer;
+	pointer.block_id = INVALID_BLOCK;
+	pointer.offset = 0;
+	return pointer;
+}
+
 } // namespace duckdb
@@ -49,6 +49,10 @@ void ChunkConstantInfo::CommitAppend(transaction_t commit_id, idx_t start, idx_t
 	insert_id = commit_id;
 }
 
+bool ChunkConstantInfo::HasCommittedInserts(idx_t max_count) {
+	return insert_id < TRANSACTION_ID_START;
+}
+
 void ChunkConstantInfo::Serialize(Serializer &serializer) {
 	// we only need to write this node if any tuple deletions have been committed
 	bool is_deleted = insert_id >= TRANSACTION_ID_START || delete_id < TRANSACTION_ID_START;
@@ -179,6 +183,15 @@ void ChunkVectorInfo::CommitAppend(transaction_t commit_id, idx_t start, idx_t e
 	}
 }
 
+bool ChunkVectorInfo::HasCommittedInserts(idx_t max_count) {
+	for (idx_t i = 0; i < max_count; i++) {
+		if (inserted[i] < TRANSACTION_ID_START) {
+			return true;
+		}
+	}
+	return false;
+}
+
 void ChunkVectorInfo::Serialize(Serializer &serializer) {
 	SelectionVector sel(STANDARD_VECTOR_SIZE);
 	transaction_t start_time = TRANSACTION_ID_START - 1;
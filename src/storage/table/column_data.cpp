@@ -20,6 +20,8 @@
 #include "duckdb/storage/table/list_column_data.hpp"
 #include "duckdb/transaction/transaction.hpp"
 #include "duckdb/storage/table/row_group.hpp"
+#include "duckdb/storage/compression/compressor.hpp"
+#include "duckdb/main/config.hpp"
 
 namespace duckdb {
 
@@ -62,9 +64,31 @@ void ColumnData::InitializeScanWithOffset(ColumnScanState &state, idx_t row_idx)
 	state.initialized = false;
 }
 
+//! The amount of segments after the segment that is currently being scanned that are read ahead
+static constexpr idx_t READ_AHEAD_SEGMENTS = 4;
+
+//! Request the blocks of the persistent segments [first, first + count) following the segment to be read ahead
+static void ReadAheadSegments(ColumnSegment *segment, idx_t first, idx_t count) {
+	vector<shared_ptr<BlockHandle>> blocks;
+	for (idx_t i = 0; segment && i < first + count; i++) {
+		if (i >= first && segment->segment_type == ColumnSegmentType::PERSISTENT && segment->data &&
+		    segment->data->block) {
+			blocks.push_back(segment->data->block);
+		}
+		segment = (ColumnSegment *)segment->next.get();
+	}
+	if (blocks.empty()) {
+		return;
+	}
+	auto &buffer_manager = BufferManager::GetBufferManager(blocks[0]->db);
+	buffer_manager.Prefetch(blocks);
+}
+
 idx_t ColumnData::ScanVector(ColumnScanState &state, Vector &result, idx_t remaining) {
 	if (!state.initialized) {
 		D_ASSERT(state.current);
+		// read ahead the segments that follow the first segment of the scan
+		ReadAheadSegments(state.current, 1, READ_AHEAD_SEGMENTS);
 		state.current->InitializeScan(state);
 		state.initialized = true;
 	}
@@ -84,7 +108,14 @@ idx_t ColumnData::ScanVector(ColumnScanState &state, Vector &result, idx_t remai
 			if (!state.current->next) {
 				break;
 			}
+			if (state.primary_handle && type.InternalType() == PhysicalType::VARCHAR) {
+				// the strings that were scanned so far can point into the buffer of the previous segment: keep it
+				// pinned for as long as the vector is alive
+				StringVector::AddHandle(result, move(state.primary_handle));
+			}
 			state.current = (ColumnSegment *)state.current->next.get();
+			// the previous segments have already been requested: read ahead the segment at the end of the window
+			ReadAheadSegments(state.current, READ_AHEAD_SEGMENTS, 1);
 			state.current->InitializeScan(state);
 			state.segment_checked = false;
 			D_ASSERT(row_index >= state.current->start && row_index <= state.current->start + state.current->count);
@@ -390,9 +421,19 @@ void ColumnCheckpointState::FlushSegment() {
 
 	// get the buffer of the segment and pin it
 	auto &buffer_manager = BufferManager::GetBufferManager(column_data.GetDatabase());
+	auto handle = buffer_manager.Pin(current_segment->block);
+	WriteSegment(CompressionType::COMPRESSION_UNCOMPRESSED, *handle, tuple_count, *segment_stats);
+	handle.reset();
+
+	current_segment.reset();
+	segment_stats.reset();
+}
+
+void ColumnCheckpointState::WriteSegment(CompressionType compression, BufferHandle &handle, idx_t tuple_count,
+                                         SegmentStatistics &stats) {
 	auto &block_manager = BlockManager::GetBlockManager(column_data.GetDatabase());
 
-	bool block_is_constant = segment_stats->statistics->IsConstant();
+	bool block_is_constant = stats.statistics->IsConstant();
 
 	block_id_t block_id;
 	uint32_t offset_in_block;
@@ -403,6 +444,7 @@ void ColumnCheckpointState::FlushSegment() {
 	} else {
 		block_id = INVALID_BLOCK;
 		offset_in_block = 0;
+		compression = CompressionType::COMPRESSION_CONSTANT;
 	}
 
 	// construct the data pointer
@@ -410,34 +452,30 @@ void ColumnCheckpointState::FlushSegment() {
 	DataPointer data_pointer;
 	data_pointer.block_pointer.block_id = block_id;
 	data_pointer.block_pointer.offset = offset_in_block;
+	data_pointer.compression_type = compression;
 	data_pointer.row_start = row_group.start;
 	if (!data_pointers.empty()) {
 		auto &last_pointer = data_pointers.back();
 		data_pointer.row_start = last_pointer.row_start + last_pointer.tuple_count;
 	}
 	data_pointer.tuple_count = tuple_count;
-	data_pointer.statistics = segment_stats->statistics->Copy();
+	data_pointer.statistics = stats.statistics->Copy();
 
 	// construct a persistent segment that points to this block, and append it to the new segment tree
 	auto persistent_segment = make_unique<PersistentSegment>(
 	    column_data.GetDatabase(), block_id, offset_in_block, column_data.type, data_pointer.row_start,
-	    data_pointer.tuple_count, segment_stats->statistics->Copy());
+	    data_pointer.tuple_count, stats.statistics->Copy(), compression);
 	new_tree.AppendSegment(move(persistent_segment));
 
 	data_pointers.push_back(move(data_pointer));
 
 	if (!block_is_constant) {
 		// write the block to disk
-		auto handle = buffer_manager.Pin(current_segment->block);
-		block_manager.Write(*handle->node, block_id);
-		handle.reset();
+		block_manager.Write(*handle.node, block_id);
 	}
 
 	// merge the segment stats into the global stats
-	global_stats->Merge(*segment_stats->statistics);
-
-	current_segment.reset();
-	segment_stats.reset();
+	global_stats->Merge(*stats.statistics);
 }
 
 void ColumnCheckpointState::FlushToDisk() {
@@ -451,6 +489,7 @@ void ColumnCheckpointState::FlushToDisk() {
 		meta_writer.Write<idx_t>(data_pointer.tuple_count);
 		meta_writer.Write<block_id_t>(data_pointer.block_pointer.block_id);
 		meta_writer.Write<uint32_t>(data_pointer.block_pointer.offset);
+		meta_writer.Write<CompressionType>(data_pointer.compression_type);
 		data_pointer.statistics->Serialize(meta_writer);
 	}
 }
@@ -464,6 +503,81 @@ void ColumnData::CheckpointScan(ColumnSegment *segment, ColumnScanState &state,
 	}
 }
 
+void ColumnData::ScanCheckpointSegments(ColumnCheckpointState &checkpoint_state,
+                                        vector<unique_ptr<SegmentBase>> &segments,
+                                        const std::function<void(Vector &, idx_t)> &callback) {
+	bool is_validity = type.id() == LogicalTypeId::VALIDITY;
+	auto scan_type = is_validity ? LogicalType::BOOLEAN : type;
+	Vector intermediate(scan_type, true, is_validity);
+	for (auto &owned_segment : segments) {
+		auto segment = (ColumnSegment *)owned_segment.get();
+		ColumnScanState state;
+		state.current = segment;
+		segment->InitializeScan(state);
+
+		Vector scan_vector(scan_type, nullptr);
+		for (idx_t base_row_index = 0; base_row_index < segment->count; base_row_index += STANDARD_VECTOR_SIZE) {
+			scan_vector.Reference(intermediate);
+
+			idx_t count = MinValue<idx_t>(segment->count - base_row_index, STANDARD_VECTOR_SIZE);
+			state.row_index = segment->start + base_row_index;
+
+			CheckpointScan(segment, state, checkpoint_state.row_group.start, base_row_index, count, scan_vector);
+
+			callback(scan_vector, count);
+		}
+	}
+}
+
+void ColumnData::CheckpointSegments(ColumnCheckpointState &checkpoint_state,
+                                    vector<unique_ptr<SegmentBase>> &segments) {
+	if (segments.empty()) {
+		return;
+	}
+	// first analyze the data to figure out which compression method (if any) to use
+	auto &config = DBConfig::GetConfig(GetDatabase());
+	auto compressors = Compressor::GetCompressors(checkpoint_state, type.InternalType(), config.force_compression);
+	if (!compressors.empty()) {
+		idx_t uncompressed_size = 0;
+		ScanCheckpointSegments(checkpoint_state, segments, [&](Vector &scan_vector, idx_t count) {
+			uncompressed_size += Compressor::UncompressedSize(scan_vector, count);
+			for (auto &compressor : compressors) {
+				if (compressor && !compressor->Analyze(scan_vector, count)) {
+					compressor.reset();
+				}
+			}
+		});
+		// pick the compression method with the smallest estimated size
+		Compressor *best_compressor = nullptr;
+		idx_t best_size = uncompressed_size;
+		for (auto &compressor : compressors) {
+			if (!compressor) {
+				continue;
+			}
+			auto estimated_size = compressor->EstimatedSize();
+			if (estimated_size < best_size || config.force_compression == compressor->type) {
+				best_compressor = compressor.get();
+				best_size = estimated_size;
+			}
+		}
+		if (best_compressor) {
+			// compress the data using the selected method
+			ScanCheckpointSegments(checkpoint_state, segments, [&](Vector &scan_vector, idx_t count) {
+				best_compressor->Compress(scan_vector, count);
+			});
+			best_compressor->Finalize();
+			segments.clear();
+			return;
+		}
+	}
+	// no compression: write the data to uncompressed segments
+	checkpoint_state.CreateEmptySegment();
+	ScanCheckpointSegments(checkpoint_state, segments,
+	                       [&](Vector &scan_vector, idx_t count) { checkpoint_state.AppendData(scan_vector, count); });
+	checkpoint_state.FlushSegment();
+	segments.clear();
+}
+
 unique_ptr<ColumnCheckpointState> ColumnData::Checkpoint(RowGroup &row_group, TableDataWriter &writer) {
 	// scan the segments of the column data
 	// set up the checkpoint state
@@ -477,18 +591,17 @@ unique_ptr<ColumnCheckpointState> ColumnData::Checkpoint(RowGroup &row_group, Ta
 	lock_guard<mutex> update_guard(update_lock);
 
 	auto &block_manager = BlockManager::GetBlockManager(GetDatabase());
-	checkpoint_state->CreateEmptySegment();
 
-	bool is_validity = type.id() == LogicalTypeId::VALIDITY;
-	auto scan_type = is_validity ? LogicalType::BOOLEAN : type;
-	Vector intermediate(scan_type, true, is_validity);
 	// we create a new segment tree with all the new segments
 	// we do this by scanning the current segments of the column and checking for changes
 	// if there are any changes (e.g. updates or deletes) we write the new changes
 	// otherwise we simply write out the current data pointers
+	// any consecutive segments that need to be written are gathered so they can be compressed together
+	vector<unique_ptr<SegmentBase>> pending_segments;
 	auto owned_segment = move(data.root_node);
-	auto segment = (ColumnSegment *)owned_segment.get();
-	while (segment) {
+	while (owned_segment) {
+		auto segment = (ColumnSegment *)owned_segment.get();
+		auto next_segment = move(segment->next);
 		if (segment->segment_type == ColumnSegmentType::PERSISTENT) {
 			auto &persistent = (PersistentSegment &)*segment;
 			// persistent segment; check if there were any updates or deletions in this segment
@@ -507,15 +620,13 @@ unique_ptr<ColumnCheckpointState> ColumnData::Checkpoint(RowGroup &row_group, Ta
 				// unchanged persistent segment: no need to write the data
 
 				// flush any segments preceding this persistent segment
-				if (checkpoint_state->current_segment->tuple_count > 0) {
-					checkpoint_state->FlushSegment();
-					checkpoint_state->CreateEmptySegment();
-				}
+				CheckpointSegments(*checkpoint_state, pending_segments);
 
 				// set up the data pointer directly using the data from the persistent segment
 				DataPointer pointer;
 				pointer.block_pointer.block_id = persistent.block_id;
 				pointer.block_pointer.offset = 0;
+				pointer.compression_type = persistent.compression;
 				pointer.row_start = segment->start;
 				pointer.tuple_count = persistent.count;
 				pointer.statistics = persistent.stats.statistics->Copy();
@@ -529,33 +640,16 @@ unique_ptr<ColumnCheckpointState> ColumnData::Checkpoint(RowGroup &row_group, Ta
 				checkpoint_state->data_pointers.push_back(move(pointer));
 
 				// move to the next segment in the list
-				owned_segment = move(segment->next);
-				segment = (ColumnSegment *)owned_segment.get();
+				owned_segment = move(next_segment);
 				continue;
 			}
 		}
-		// not persisted yet: scan the segment and write it to disk
-		ColumnScanState state;
-		state.current = segment;
-		segment->InitializeScan(state);
-
-		Vector scan_vector(scan_type, nullptr);
-		for (idx_t base_row_index = 0; base_row_index < segment->count; base_row_index += STANDARD_VECTOR_SIZE) {
-			scan_vector.Reference(intermediate);
-
-			idx_t count = MinValue<idx_t>(segment->count - base_row_index, STANDARD_VECTOR_SIZE);
-			state.row_index = segment->start + base_row_index;
-
-			CheckpointScan(segment, state, row_group.start, base_row_index, count, scan_vector);
-
-			checkpoint_state->AppendData(scan_vector, count);
-		}
-		// move to the next segment in the list
-		owned_segment = move(segment->next);
-		segment = (ColumnSegment *)owned_segment.get();
+		// not persisted yet: gather the segment so it can be written to disk
+		pending_segments.push_back(move(owned_segment));
+		owned_segment = move(next_segment);
 	}
-	// flush the final segment
-	checkpoint_state->FlushSegment();
+	// flush the final segments
+	CheckpointSegments(*checkpoint_state, pending_segments);
 	// replace the old tree with the new one
 	data.Replace(checkpoint_state->new_tree);
 
@@ -572,12 +666,14 @@ void ColumnData::DeserializeColumn(Deserializer &source) {
 		data_pointer.tuple_count = source.Read<idx_t>();
 		data_pointer.block_pointer.block_id = source.Read<block_id_t>();
 		data_pointer.block_pointer.offset = source.Read<uint32_t>();
+		data_pointer.compression_type = source.Read<CompressionType>();
 		data_pointer.statistics = BaseStatistics::Deserialize(source, type);
 
 		// create a persistent segment
-		auto segment = make_unique<PersistentSegment>(GetDatabase(), data_pointer.block_pointer.block_id,
-		                                              data_pointer.block_pointer.offset, type, data_pointer.row_start,
-		                                              data_pointer.tuple_count, move(data_pointer.statistics));
+		auto segment = make_unique<PersistentSegment>(
+		    GetDatabase(), data_pointer.block_pointer.block_id, data_pointer.block_pointer.offset, type,
+		    data_pointer.row_start, data_pointer.tuple_count, move(data_pointer.statistics),
+		    data_pointer.compression_type);
 		data.AppendSegment(move(segment));
 	}
 }
@@ -621,6 +717,13 @@ void ColumnData::GetStorageInfo(idx_t row_group_index, vector<idx_t> col_path, v
 		column_info.push_back(Value::BIGINT(segment->start));
 		// count
 		column_info.push_back(Value::BIGINT(segment->count));
+		// compression
+		if (segment->segment_type == ColumnSegmentType::PERSISTENT) {
+			auto &persistent = (PersistentSegment &)*segment;
+			column_info.emplace_back(CompressionTypeToString(persistent.compression));
+		} else {
+			column_info.emplace_back(CompressionTypeToString(CompressionType::COMPRESSION_UNCOMPRESSED));
+		}
 		// stats
 		column_info.emplace_back(segment->stats.statistics ? segment->stats.statistics->ToString()
 		                                                   : string("No Stats"));
@@ -7,6 +7,7 @@
 #include "duckdb/storage/meta_block_reader.hpp"
 #include "duckdb/storage/storage_manager.hpp"
 
+#include "duckdb/storage/compression/compressor.hpp"
 #include "duckdb/storage/constant_segment.hpp"
 #include "duckdb/storage/numeric_segment.hpp"
 #include "duckdb/storage/string_segment.hpp"
@@ -15,12 +16,16 @@
 namespace duckdb {
 
 PersistentSegment::PersistentSegment(DatabaseInstance &db, block_id_t id, idx_t offset, const LogicalType &type_p,
-                                     idx_t start, idx_t count, unique_ptr<BaseStatistics> statistics)
+                                     idx_t start, idx_t count, unique_ptr<BaseStatistics> statistics,
+                                     CompressionType compression)
     : ColumnSegment(db, type_p, ColumnSegmentType::PERSISTENT, start, count, move(statistics)), block_id(id),
-      offset(offset) {
+      offset(offset), compression(compression) {
 	D_ASSERT(offset == 0);
 	if (block_id == INVALID_BLOCK) {
+		D_ASSERT(compression == CompressionType::COMPRESSION_CONSTANT);
 		data = make_unique<ConstantSegment>(db, stats, start);
+	} else if (compression != CompressionType::COMPRESSION_UNCOMPRESSED) {
+		data = Compressor::CreateSegment(db, compression, type.InternalType(), start, id);
 	} else if (type.InternalType() == PhysicalType::VARCHAR) {
 		data = make_unique<StringSegment>(db, start, id);
 	} else if (type.InternalType() == PhysicalType::BIT) {
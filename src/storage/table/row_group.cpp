@@ -75,6 +75,7 @@ bool RowGroup::InitializeScanWithOffset(RowGroupScanState &state, idx_t vector_o
 		if (column != COLUMN_IDENTIFIER_ROW_ID) {
 			columns[column]->InitializeScanWithOffset(state.column_scans[i],
 			                                          start + vector_offset * STANDARD_VECTOR_SIZE);
+			state.column_scans[i].scan_compressed = true;
 		} else {
 			state.column_scans[i].current = nullptr;
 		}
@@ -98,6 +99,7 @@ bool RowGroup::InitializeScan(RowGroupScanState &state) {
 		auto column = column_ids[i];
 		if (column != COLUMN_IDENTIFIER_ROW_ID) {
 			columns[column]->InitializeScan(state.column_scans[i]);
+			state.column_scans[i].scan_compressed = true;
 		} else {
 			state.column_scans[i].current = nullptr;
 		}
@@ -441,6 +443,23 @@ bool RowGroup::Fetch(Transaction &transaction, idx_t row) {
 	return info->Fetch(transaction, row - vector_index * STANDARD_VECTOR_SIZE);
 }
 
+bool RowGroup::HasCommittedInserts() {
+	lock_guard<mutex> lock(row_group_lock);
+
+	for (idx_t vector_idx = 0; vector_idx * STANDARD_VECTOR_SIZE < count; vector_idx++) {
+		auto info = GetChunkInfo(vector_idx);
+		if (!info) {
+			// no version info: all rows are committed
+			return true;
+		}
+		idx_t max_count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, count - vector_idx * STANDARD_VECTOR_SIZE);
+		if (info->HasCommittedInserts(max_count)) {
+			return true;
+		}
+	}
+	return false;
+}
+
 void RowGroup::FetchRow(Transaction &transaction, ColumnFetchState &state, const vector<column_t> &column_ids,
                         row_t row_id, DataChunk &result, idx_t result_idx) {
 	for (idx_t col_idx = 0; col_idx < column_ids.size(); col_idx++) {
@@ -56,6 +56,18 @@ void SegmentTree::AppendSegment(unique_ptr<SegmentBase> segment) {
 	}
 }
 
+void SegmentTree::EraseSegment(idx_t segment_index) {
+	D_ASSERT(segment_index < nodes.size());
+	auto segment = nodes[segment_index].node;
+	// unlink the segment from the chain of segments: this destroys it
+	if (segment_index == 0) {
+		root_node = move(segment->next);
+	} else {
+		nodes[segment_index - 1].node->next = move(segment->next);
+	}
+	nodes.erase(nodes.begin() + segment_index);
+}
+
 void SegmentTree::Replace(SegmentTree &other) {
 	root_node = move(other.root_node);
 	nodes = move(other.nodes);
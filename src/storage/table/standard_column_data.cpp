@@ -57,16 +57,45 @@ void StandardColumnData::InitializeScanWithOffset(ColumnScanState &state, idx_t
 idx_t StandardColumnData::Scan(Transaction &transaction, idx_t vector_index, ColumnScanState &state, Vector &result) {
 	D_ASSERT(state.row_index == state.child_states[0].row_index);
 	auto scan_count = ColumnData::Scan(transaction, vector_index, state, result);
-	validity.Scan(transaction, vector_index, state.child_states[0], result);
+	if (result.GetVectorType() == VectorType::FLAT_VECTOR) {
+		validity.Scan(transaction, vector_index, state.child_states[0], result);
+	} else {
+		// the scan emitted a constant or dictionary vector: scan the validity separately so that we only need to
+		// flatten the result if the vector actually contains NULL values
+		Vector validity_vector(LogicalType::BOOLEAN);
+		validity.Scan(transaction, vector_index, state.child_states[0], validity_vector);
+		MergeValidity(validity_vector, result, scan_count);
+	}
 	state.NextVector();
 	return scan_count;
 }
 
+void StandardColumnData::MergeValidity(Vector &validity_vector, Vector &result, idx_t count) {
+	if (validity_vector.GetVectorType() == VectorType::CONSTANT_VECTOR) {
+		if (ConstantVector::IsNull(validity_vector)) {
+			result.Reference(Value(result.GetType()));
+		}
+		return;
+	}
+	auto &mask = FlatVector::Validity(validity_vector);
+	if (mask.CheckAllValid(count)) {
+		return;
+	}
+	result.Normalify(count);
+	FlatVector::SetValidity(result, mask);
+}
+
 idx_t StandardColumnData::ScanCommitted(idx_t vector_index, ColumnScanState &state, Vector &result,
                                         bool allow_updates) {
 	D_ASSERT(state.row_index == state.child_states[0].row_index);
 	auto scan_count = ColumnData::ScanCommitted(vector_index, state, result, allow_updates);
-	validity.ScanCommitted(vector_index, state.child_states[0], result, allow_updates);
+	if (result.GetVectorType() == VectorType::FLAT_VECTOR) {
+		validity.ScanCommitted(vector_index, state.child_states[0], result, allow_updates);
+	} else {
+		Vector validity_vector(LogicalType::BOOLEAN);
+		validity.ScanCommitted(vector_index, state.child_states[0], validity_vector, allow_updates);
+		MergeValidity(validity_vector, result, scan_count);
+	}
 	state.NextVector();
 	return scan_count;
 }
@@ -12,6 +12,7 @@
 #include "duckdb/planner/filter/constant_filter.hpp"
 #include "duckdb/planner/filter/null_filter.hpp"
 #include "duckdb/planner/filter/conjunction_filter.hpp"
+#include "duckdb/planner/filter/join_key_filter.hpp"
 
 namespace duckdb {
 
@@ -275,6 +276,9 @@ void UncompressedSegment::FilterSelection(SelectionVector &sel, Vector &result,
 	case TableFilterType::IS_NOT_NULL:
 		TemplatedNullSelection<false>(sel, approved_tuple_count, mask);
 		break;
+	case TableFilterType::JOIN_KEY:
+		((const JoinKeyFilter &)filter).Select(result, sel, approved_tuple_count, mask);
+		break;
 	default:
 		throw InternalException("FIXME: unsupported type for filter selection");
 	}
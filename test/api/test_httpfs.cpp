@@ -0,0 +1,353 @@
+#include "catch.hpp"
+#include "test_helpers.hpp"
+#include "httpfs-extension.hpp"
+#include "s3fs.hpp"
+#include "parquet-extension.hpp"
+#define CPPHTTPLIB_OPENSSL_SUPPORT
+#include "httplib.hpp"
+
+#include <map>
+#include <set>
+
+using namespace duckdb;
+using namespace std;
+
+//! A local stand-in for a remote server: serves files from memory (including range requests) and counts the requests
+//! and connections it receives
+class TestHTTPServer {
+public:
+	TestHTTPServer() : get_requests(0), head_requests(0) {
+		server.Get("/(.*)", [&](const httplib::Request &req, httplib::Response &res) {
+			lock_guard<mutex> guard(lock);
+			connections.insert(req.remote_port);
+			if (req.method == "HEAD") {
+				head_requests++;
+			} else {
+				get_requests++;
+			}
+			auto entry = files.find(req.matches[1]);
+			if (entry == files.end()) {
+				res.status = 404;
+				return;
+			}
+			res.set_header("Last-Modified", "Mon, 01 Jan 2018 00:00:00 GMT");
+			res.set_content(entry->second, "application/octet-stream");
+		});
+		port = server.bind_to_any_port("127.0.0.1");
+		server_thread = thread([&]() { server.listen_after_bind(); });
+	}
+	~TestHTTPServer() {
+		server.stop();
+		server_thread.join();
+	}
+
+	void AddFile(const string &name, string contents) {
+		lock_guard<mutex> guard(lock);
+		files[name] = move(contents);
+	}
+
+	string GetURL(const string &name) {
+		return "http://127.0.0.1:" + to_string(port) + "/" + name;
+	}
+
+	void ResetCounters() {
+		lock_guard<mutex> guard(lock);
+		get_requests = 0;
+		head_requests = 0;
+		connections.clear();
+	}
+
+	mutex lock;
+	idx_t get_requests;
+	idx_t head_requests;
+	std::set<int> connections;
+
+private:
+	httplib::Server server;
+	thread server_thread;
+	int port;
+	unordered_map<string, string> files;
+};
+
+TEST_CASE("Test reading Parquet files from a local HTTP server", "[httpfs]") {
+	TestHTTPServer server;
+	DuckDB db(nullptr);
+	db.LoadExtension<ParquetExtension>();
+	db.LoadExtension<HTTPFsExtension>();
+	Connection con(db);
+
+	auto local_file = TestCreatePath("httpfs_lineitem.parquet");
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE lineitem AS SELECT i AS l_orderkey, i % 7 AS l_linenumber, 'comment ' || "
+	                          "(i % 1000) AS l_comment, (i % 50)::DOUBLE AS l_quantity FROM range(500000) tbl(i)"));
+	REQUIRE_NO_FAIL(con.Query("COPY lineitem TO '" + local_file + "' (FORMAT PARQUET)"));
+	auto &fs = FileSystem::GetFileSystem(*db.instance);
+	auto handle = fs.OpenFile(local_file, FileFlags::FILE_FLAGS_READ);
+	string contents(fs.GetFileSize(*handle), '\0');
+	handle->Read((void *)contents.data(), contents.size(), 0);
+	server.AddFile("lineitem.parquet", move(contents));
+	auto url = server.GetURL("lineitem.parquet");
+
+	string query = "SELECT COUNT(*), SUM(l_orderkey), SUM(l_linenumber), MAX(l_comment), SUM(l_quantity) FROM ";
+	auto expected = con.Query(query + "parquet_scan('" + local_file + "')");
+	REQUIRE_NO_FAIL(*expected);
+
+	SECTION("Sequential scan") {
+		REQUIRE_NO_FAIL(con.Query("PRAGMA threads=1"));
+		auto result = con.Query(query + "parquet_scan('" + url + "')");
+		REQUIRE_NO_FAIL(*result);
+		REQUIRE(result->Equals(*expected));
+		// the requests share a few keep-alive connections
+		REQUIRE(server.connections.size() < server.get_requests + server.head_requests);
+	}
+	SECTION("Parallel scan") {
+		REQUIRE_NO_FAIL(con.Query("PRAGMA threads=4"));
+		auto result = con.Query(query + "parquet_scan('" + url + "')");
+		REQUIRE_NO_FAIL(*result);
+		REQUIRE(result->Equals(*expected));
+		REQUIRE(server.connections.size() < server.get_requests + server.head_requests);
+
+		// the connections are kept in the pool between queries
+		server.ResetCounters();
+		result = con.Query("SELECT COUNT(*) FROM parquet_scan('" + url + "') WHERE l_linenumber = 3");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(71429)}));
+		REQUIRE(server.connections.size() < server.get_requests + server.head_requests);
+	}
+	SECTION("Projections read the column chunks of a group with few requests") {
+		REQUIRE_NO_FAIL(con.Query("PRAGMA threads=1"));
+		auto result =
+		    con.Query("SELECT COUNT(DISTINCT row_group_id) FROM parquet_metadata('" + local_file + "')");
+		REQUIRE_NO_FAIL(*result);
+		auto row_groups = result->GetValue(0, 0).GetValue<int64_t>();
+
+		server.ResetCounters();
+		result = con.Query("SELECT SUM(l_orderkey), SUM(l_quantity) FROM parquet_scan('" + url + "')");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(124999750000)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::DOUBLE(12250000)}));
+		// the column chunks of a group are read at once (in at most two parts), plus a few requests for the footer
+		REQUIRE(server.get_requests <= idx_t(row_groups) * 2 + 4);
+	}
+	SECTION("Large and asynchronous reads") {
+		auto &local_handle = *handle;
+		string local_contents(fs.GetFileSize(local_handle), '\0');
+		local_handle.Read((void *)local_contents.data(), local_contents.size(), 0);
+		REQUIRE(local_contents.size() > 2 * HTTPFileSystem::CONCURRENT_REQUEST_SIZE);
+
+		auto remote_handle = fs.OpenFile(url, FileFlags::FILE_FLAGS_READ);
+		// a read that is larger than the buffer of the handle is split into concurrent requests
+		server.ResetCounters();
+		string remote_contents(local_contents.size(), '\0');
+		remote_handle->Read((void *)remote_contents.data(), remote_contents.size(), 0);
+		REQUIRE(remote_contents == local_contents);
+		REQUIRE(server.get_requests ==
+		        (local_contents.size() + HTTPFileSystem::CONCURRENT_REQUEST_SIZE - 1) /
+		            HTTPFileSystem::CONCURRENT_REQUEST_SIZE);
+
+		string first(1000, '\0'), second(1000, '\0'), third(1000, '\0');
+		auto first_read = fs.ReadAsync(*remote_handle, (void *)first.data(), first.size(), 0);
+		auto second_read = fs.ReadAsync(*remote_handle, (void *)second.data(), second.size(), 5000);
+		// a read that is not waited on is cancelled or finishes before it is destroyed
+		auto cancelled_read = fs.ReadAsync(*remote_handle, (void *)third.data(), third.size(), 5000);
+		cancelled_read.reset();
+		second_read->Wait();
+		first_read->Wait();
+		REQUIRE(first == local_contents.substr(0, 1000));
+		REQUIRE(second == local_contents.substr(5000, 1000));
+	}
+	SECTION("Errors") {
+		REQUIRE_FAIL(con.Query("SELECT * FROM parquet_scan('" + server.GetURL("missing.parquet") + "')"));
+		// the connection pool recovers from failed requests
+		auto result = con.Query("SELECT COUNT(*) FROM parquet_scan('" + url + "')");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(500000)}));
+	}
+	TestDeleteFile(local_file);
+}
+
+//! A local stand-in for S3 that supports (path-style) object reads and writes, including multipart uploads
+class TestS3Server {
+public:
+	TestS3Server()
+	    : uploaded_parts(0), started_uploads(0), completed_uploads(0), aborted_uploads(0), fail_parts(false) {
+		server.Get("/(.*)", [&](const httplib::Request &req, httplib::Response &res) {
+			lock_guard<mutex> guard(lock);
+			auto entry = objects.find(req.matches[1]);
+			if (entry == objects.end()) {
+				res.status = 404;
+				return;
+			}
+			res.set_header("Last-Modified", "Mon, 01 Jan 2018 00:00:00 GMT");
+			res.set_content(entry->second, "application/octet-stream");
+		});
+		server.Put("/(.*)", [&](const httplib::Request &req, httplib::Response &res) {
+			lock_guard<mutex> guard(lock);
+			if (!req.has_header("Authorization")) {
+				res.status = 403;
+				return;
+			}
+			if (!req.has_param("uploadId")) {
+				objects[req.matches[1]] = req.body;
+				return;
+			}
+			auto upload = uploads.find(req.get_param_value("uploadId"));
+			if (upload == uploads.end() || fail_parts) {
+				res.status = 500;
+				return;
+			}
+			auto part_no = std::stoi(req.get_param_value("partNumber"));
+			upload->second[part_no] = req.body;
+			uploaded_parts++;
+			res.set_header("ETag", "\"etag-" + to_string(part_no) + "\"");
+		});
+		server.Post("/(.*)", [&](const httplib::Request &req, httplib::Response &res) {
+			lock_guard<mutex> guard(lock);
+			if (req.has_param("uploads")) {
+				auto upload_id = "upload/" + to_string(started_uploads++);
+				uploads[upload_id];
+				res.set_content("<InitiateMultipartUploadResult><UploadId>" + upload_id +
+				                    "</UploadId></InitiateMultipartUploadResult>",
+				                "application/xml");
+				return;
+			}
+			auto upload = uploads.find(req.get_param_value("uploadId"));
+			if (upload == uploads.end()) {
+				res.status = 404;
+				return;
+			}
+			// the parts are concatenated in the order of the part numbers in the request
+			string object;
+			idx_t part_count = 0;
+			for (auto &part : upload->second) {
+				auto part_entry = "<PartNumber>" + to_string(part.first) + "</PartNumber><ETag>\"etag-" +
+				                  to_string(part.first) + "\"</ETag>";
+				if (req.body.find(part_entry) == string::npos) {
+					res.status = 400;
+					return;
+				}
+				object += part.second;
+				part_count++;
+			}
+			if (part_count == 0) {
+				res.status = 400;
+				return;
+			}
+			objects[req.matches[1]] = object;
+			uploads.erase(upload);
+			completed_uploads++;
+			res.set_content("<CompleteMultipartUploadResult></CompleteMultipartUploadResult>", "application/xml");
+		});
+		server.Delete("/(.*)", [&](const httplib::Request &req, httplib::Response &res) {
+			lock_guard<mutex> guard(lock);
+			if (uploads.erase(req.get_param_value("uploadId")) > 0) {
+				aborted_uploads++;
+				res.status = 204;
+			} else {
+				res.status = 404;
+			}
+		});
+		port = server.bind_to_any_port("127.0.0.1");
+		server_thread = thread([&]() { server.listen_after_bind(); });
+	}
+	~TestS3Server() {
+		server.stop();
+		server_thread.join();
+	}
+
+	string GetEndpoint() {
+		return "127.0.0.1:" + to_string(port);
+	}
+
+	string GetObject(const string &name) {
+		lock_guard<mutex> guard(lock);
+		auto entry = objects.find(name);
+		return entry == objects.end() ? string() : entry->second;
+	}
+
+	mutex lock;
+	idx_t uploaded_parts;
+	idx_t started_uploads;
+	idx_t completed_uploads;
+	idx_t aborted_uploads;
+	//! Whether or not uploads of parts fail
+	bool fail_parts;
+
+private:
+	httplib::Server server;
+	thread server_thread;
+	int port;
+	unordered_map<string, string> objects;
+	unordered_map<string, std::map<int, string>> uploads;
+};
+
+static string ReadLocalFile(DuckDB &db, const string &path) {
+	auto &fs = FileSystem::GetFileSystem(*db.instance);
+	auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ);
+	string contents(fs.GetFileSize(*handle), '\0');
+	handle->Read((void *)contents.data(), contents.size(), 0);
+	return contents;
+}
+
+TEST_CASE("Test writing files to a local S3 stand-in with multipart uploads", "[httpfs]") {
+	TestS3Server server;
+	DuckDB db(nullptr);
+	db.LoadExtension<ParquetExtension>();
+	db.LoadExtension<HTTPFsExtension>();
+	Connection con(db);
+
+	REQUIRE_NO_FAIL(con.Query("SET s3_endpoint='" + server.GetEndpoint() + "'"));
+	REQUIRE_NO_FAIL(con.Query("SET s3_use_ssl=false"));
+	REQUIRE_NO_FAIL(con.Query("SET s3_url_style='path'"));
+	// parts can not be smaller than 5MB
+	REQUIRE_NO_FAIL(con.Query("SET s3_uploader_part_size=100000"));
+	REQUIRE_FAIL(con.Query("COPY (SELECT 42 AS i) TO 's3://test-bucket/small.csv'"));
+	REQUIRE_NO_FAIL(con.Query("SET s3_uploader_part_size=" + to_string(S3FileSystem::MINIMUM_PART_SIZE)));
+	REQUIRE_NO_FAIL(con.Query("SET s3_uploader_max_uploads=3"));
+	REQUIRE_NO_FAIL(con.Query("SET s3_uploader_thread_limit=2"));
+	// the comments do not compress, so the files are uploaded in several parts
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE lineitem AS SELECT i AS l_orderkey, md5(i::VARCHAR) AS l_comment, "
+	                          "(i % 50)::DOUBLE AS l_quantity FROM range(300000) tbl(i)"));
+
+	SECTION("Parquet") {
+		auto local_file = TestCreatePath("s3_lineitem.parquet");
+		REQUIRE_NO_FAIL(con.Query("COPY lineitem TO '" + local_file + "' (FORMAT PARQUET)"));
+		REQUIRE_NO_FAIL(con.Query("COPY lineitem TO 's3://test-bucket/lineitem.parquet' (FORMAT PARQUET)"));
+		auto expected = ReadLocalFile(db, local_file);
+		auto part_size = S3FileSystem::MINIMUM_PART_SIZE;
+		REQUIRE(expected.size() > part_size);
+		REQUIRE(server.GetObject("test-bucket/lineitem.parquet") == expected);
+		REQUIRE(server.completed_uploads == 1);
+		REQUIRE(server.uploaded_parts == (expected.size() + part_size - 1) / part_size);
+
+		// the uploaded file can be read back
+		string query = "SELECT COUNT(*), SUM(l_orderkey), MAX(l_comment), SUM(l_quantity) FROM ";
+		auto expected_result = con.Query(query + "lineitem");
+		auto result = con.Query(query + "parquet_scan('s3://test-bucket/lineitem.parquet')");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(300000)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(44999850000)}));
+		REQUIRE(CHECK_COLUMN(result, 3, {Value::DOUBLE(7350000)}));
+		REQUIRE(result->Equals(*expected_result));
+		TestDeleteFile(local_file);
+	}
+	SECTION("CSV") {
+		auto local_file = TestCreatePath("s3_lineitem.csv");
+		REQUIRE_NO_FAIL(con.Query("COPY lineitem TO '" + local_file + "' (HEADER)"));
+		REQUIRE_NO_FAIL(con.Query("COPY lineitem TO 's3://test-bucket/lineitem.csv' (HEADER)"));
+		auto expected = ReadLocalFile(db, local_file);
+		REQUIRE(server.GetObject("test-bucket/lineitem.csv") == expected);
+		REQUIRE(server.completed_uploads == 1);
+		TestDeleteFile(local_file);
+	}
+	SECTION("Files that fit in a single part are uploaded with a single request") {
+		REQUIRE_NO_FAIL(con.Query("COPY (SELECT 42 AS i) TO 's3://test-bucket/small.csv'"));
+		REQUIRE(server.GetObject("test-bucket/small.csv") == "42\n");
+		REQUIRE(server.started_uploads == 0);
+
+		REQUIRE_NO_FAIL(con.Query("COPY (SELECT 42 AS i WHERE false) TO 's3://test-bucket/empty.csv'"));
+		REQUIRE(server.started_uploads == 0);
+	}
+	SECTION("Failed uploads are aborted") {
+		server.fail_parts = true;
+		REQUIRE_FAIL(con.Query("COPY lineitem TO 's3://test-bucket/failed.parquet' (FORMAT PARQUET)"));
+		REQUIRE(server.started_uploads == 1);
+		REQUIRE(server.aborted_uploads == 1);
+		REQUIRE(server.GetObject("test-bucket/failed.parquet").empty());
+	}
+}